@@ -293,10 +293,16 @@ public:
         for (std::size_t i = 0; i < keys.size(); ++i) {
             auto &key = keys[i];
             auto &cont = continuations[i];
+            // Waits here rather than on the IO threads while the memory budget is exhausted. The continuations decode
+            // into memory the caller has already allocated, such as a read's frame, if at all, so only the compressed
+            // segment is reserved
+            auto reservation = std::make_shared<MemoryReservation>(async::memory_governor().reserve_typical());
             batch.push_back(
                 async::submit_io_task(ReadCompressedTask(key, library_, storage::ReadKeyOpts{}))
+                    .thenValue(ResizeDecodeReservationTask{reservation, false})
                     .via(&async::cpu_executor())
-                    .thenValue(SegmentFunctionTask{std::move(cont)}));
+                    .thenValue(SegmentFunctionTask{std::move(cont)})
+                    .ensure([reservation] { reservation->release(); }));
 
             if(batch.size() == args.batch_size_) {
                 auto vec = folly::collect(batch).get();
@@ -325,20 +331,26 @@ public:
         size_t current_size = 0;
         for (auto&& s : slice_and_keys) {
             auto sk = std::move(s);
+            // Waits here rather than on the IO threads while the memory budget is exhausted
+            auto reservation = std::make_shared<MemoryReservation>(async::memory_governor().reserve_typical());
             // By default IO bound work -> IO thread pool, CPU bound work -> CPU thread pool.
             if(args.scheduler_ == BatchReadArgs::CPU) {
                 batch.push_back(
                     async::submit_io_task(ReadCompressedSlicesTask(std::move(sk), library_))
+                        .thenValue(ResizeDecodeReservationTask{reservation})
                         .via(&async::cpu_executor())
                         .thenValue(DecodeSlicesTask{desc, filter_columns})
-                        .thenValue(MemSegmentProcessingTask{shared_from_this(),query}));
+                        .thenValue(MemSegmentProcessingTask{shared_from_this(),query})
+                        .ensure([reservation] { reservation->release(); }));
             }
             // IO option will execute all work in the same Folly thread potentially limiting context switches.
             else {
                 batch.push_back(
                     async::submit_io_task(ReadCompressedSlicesTask(std::move(sk), library_))
+                        .thenValue(ResizeDecodeReservationTask{reservation})
                         .thenValue(DecodeSlicesTask{desc, filter_columns})
-                        .thenValue(MemSegmentProcessingTask{shared_from_this(),query}));
+                        .thenValue(MemSegmentProcessingTask{shared_from_this(),query})
+                        .ensure([reservation] { reservation->release(); }));
             }
 
             if(++current_size == args.batch_size_) {
@@ -0,0 +1,77 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/async/memory_governor.hpp>
+#include <arcticdb/log/log.hpp>
+
+namespace arcticdb::async {
+
+void MemoryReservation::release() {
+    if(governor_ != nullptr && bytes_ != 0)
+        governor_->release(bytes_);
+
+    governor_ = nullptr;
+    bytes_ = 0;
+}
+
+void MemoryReservation::resize(size_t bytes) {
+    if(governor_ == nullptr)
+        return;
+
+    governor_->resize(bytes_, bytes);
+    bytes_ = bytes;
+}
+
+MemoryReservation MemoryGovernor::reserve(size_t bytes) {
+    if(budget_ == 0)
+        return {};
+
+    std::unique_lock lock(mutex_);
+    if(!fits(bytes)) {
+        ARCTICDB_DEBUG(log::schedule(), "Waiting to reserve {} bytes with {} of {} reserved", bytes, reserved_, budget_);
+        released_.wait(lock, [this, bytes] { return fits(bytes); });
+    }
+    reserved_ += bytes;
+    return {this, bytes};
+}
+
+std::optional<MemoryReservation> MemoryGovernor::try_reserve(size_t bytes) {
+    if(budget_ == 0)
+        return MemoryReservation{};
+
+    std::lock_guard lock(mutex_);
+    if(!fits(bytes))
+        return std::nullopt;
+
+    reserved_ += bytes;
+    return MemoryReservation{this, bytes};
+}
+
+size_t MemoryGovernor::reserved_bytes() const {
+    std::lock_guard lock(mutex_);
+    return reserved_;
+}
+
+void MemoryGovernor::resize(size_t from, size_t to) {
+    {
+        std::lock_guard lock(mutex_);
+        typical_bytes_ = (typical_bytes_.load() * 7 + to) / 8;
+        reserved_ = reserved_ - from + to;
+    }
+    if(to < from)
+        released_.notify_all();
+}
+
+void MemoryGovernor::release(size_t bytes) {
+    {
+        std::lock_guard lock(mutex_);
+        reserved_ -= bytes;
+    }
+    released_.notify_all();
+}
+
+} // namespace arcticdb::async
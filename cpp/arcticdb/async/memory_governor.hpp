@@ -0,0 +1,126 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/util/constructors.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+
+namespace arcticdb::async {
+
+class MemoryGovernor;
+
+// Bytes reserved from a MemoryGovernor, which are returned to it when the reservation is released or destroyed
+class MemoryReservation {
+public:
+    MemoryReservation() = default;
+
+    MemoryReservation(MemoryGovernor* governor, size_t bytes) :
+        governor_(governor),
+        bytes_(bytes) {
+    }
+
+    MemoryReservation(MemoryReservation&& other) noexcept :
+        governor_(other.governor_),
+        bytes_(other.bytes_) {
+        other.governor_ = nullptr;
+        other.bytes_ = 0;
+    }
+
+    MemoryReservation& operator=(MemoryReservation&& other) noexcept {
+        if(this != &other) {
+            release();
+            governor_ = other.governor_;
+            bytes_ = other.bytes_;
+            other.governor_ = nullptr;
+            other.bytes_ = 0;
+        }
+        return *this;
+    }
+
+    MemoryReservation(const MemoryReservation&) = delete;
+    MemoryReservation& operator=(const MemoryReservation&) = delete;
+
+    ~MemoryReservation() {
+        release();
+    }
+
+    void release();
+
+    // Changes the size of the reservation without blocking, for work that only learns its size once it has started
+    void resize(size_t bytes);
+
+    [[nodiscard]] size_t bytes() const {
+        return bytes_;
+    }
+
+private:
+    MemoryGovernor* governor_ = nullptr;
+    size_t bytes_ = 0;
+};
+
+/*
+ * Bounds the memory used by the decode and encode work in flight, so that a read of many segments or a write of a
+ * large frame doesn't use more than the budget at once. Work is reserved for by the thread submitting it, which blocks
+ * while the budget is exhausted, so that the thread pools themselves never wait on the budget and work holding a
+ * reservation can always finish. Work whose size is only known once it has started, such as decoding a segment that
+ * has just been read, reserves the typical size of recent work and is resized when its size is known, which may take
+ * the reserved bytes over the budget until it finishes. A reservation is always granted when nothing else is reserved,
+ * so that work larger than the budget runs on its own rather than never. A budget of zero grants every reservation
+ * without tracking it.
+ */
+class MemoryGovernor {
+public:
+    explicit MemoryGovernor(size_t budget) :
+        budget_(budget) {
+    }
+
+    ARCTICDB_NO_MOVE_OR_COPY(MemoryGovernor)
+
+    // Blocks until the bytes fit within the budget
+    MemoryReservation reserve(size_t bytes);
+
+    // Returns nothing rather than blocking if the bytes don't fit within the budget
+    std::optional<MemoryReservation> try_reserve(size_t bytes);
+
+    // Blocks until the typical size of recently resized reservations fits within the budget
+    MemoryReservation reserve_typical() {
+        return reserve(typical_bytes_.load());
+    }
+
+    [[nodiscard]] size_t budget() const {
+        return budget_;
+    }
+
+    [[nodiscard]] size_t reserved_bytes() const;
+
+private:
+    friend class MemoryReservation;
+
+    // Nothing fits while resized reservations have taken the reserved bytes over the budget
+    [[nodiscard]] bool fits(size_t bytes) const {
+        return reserved_ == 0 || reserved_ + bytes <= budget_;
+    }
+
+    void release(size_t bytes);
+
+    void resize(size_t from, size_t to);
+
+    const size_t budget_;
+    mutable std::mutex mutex_;
+    std::condition_variable released_;
+    size_t reserved_ = 0;
+    // Moving average of the sizes that reservations have been resized to, updated under mutex_ and read without it
+    std::atomic<size_t> typical_bytes_ = 0;
+};
+
+} // namespace arcticdb::async
@@ -9,6 +9,18 @@
 
 namespace arcticdb::async {
 
+namespace {
+thread_local bool scheduler_thread = false;
+}
+
+bool is_scheduler_thread() {
+    return scheduler_thread;
+}
+
+void mark_scheduler_thread() {
+    scheduler_thread = true;
+}
+
 TaskScheduler* TaskScheduler::instance() {
     std::call_once(TaskScheduler::init_flag_, &TaskScheduler::init);
     return instance_->ptr_;
@@ -14,6 +14,7 @@
 #include <arcticdb/util/configs_map.hpp>
 #include <arcticdb/util/home_directory.hpp>
 #include <arcticdb/async/base_task.hpp>
+#include <arcticdb/async/memory_governor.hpp>
 #include <arcticdb/entity/performance_tracing.hpp>
 
 #include <folly/executors/FutureExecutor.h>
@@ -56,6 +57,12 @@ struct TaskSchedulerPtrWrapper{
     }
 };
 
+// Whether the calling thread belongs to one of the task scheduler's pools. Work running there shouldn't submit tasks
+// and block on them, as the pool may have no free thread to run them
+bool is_scheduler_thread();
+
+void mark_scheduler_thread();
+
 class InstrumentedNamedFactory : public folly::ThreadFactory{
 public:
     explicit InstrumentedNamedFactory(folly::StringPiece prefix) : named_factory_(prefix){}
@@ -64,6 +71,7 @@ public:
         return named_factory_.newThread(
                 [func = std::move(func)]() mutable {
                 ARCTICDB_SAMPLE_THREAD();
+                mark_scheduler_thread();
               func();
             });
   }
@@ -136,7 +144,8 @@ inline auto get_default_num_cpus() {
  * 2/ Worker thread Affinity - would better locality improve throughput by keeping hot structure in
  * hot cachelines and not jumping from one thread to the next (assuming thread/core affinity in hw too) ?
  * 3/ Priority: How to assign priorities to task in order to treat the most pressing first.
- * 4/ Throttling: (similar to priority) how to absorb work spikes and apply memory backpressure
+ * 4/ Throttling: (similar to priority) how to absorb work spikes. Memory backpressure is applied by the memory
+ * governor, which decode and encode work reserves from before it starts
  */
 
 class TaskScheduler {
@@ -149,6 +158,7 @@ class TaskScheduler {
         io_thread_count_(io_thread_count ? io_thread_count.value() : ConfigsMap::instance()->get_int("VersionStore.NumIOThreads", std::min(100, (int) (cpu_thread_count_ * 1.5)))),
         cpu_exec_(cpu_thread_count_, std::make_shared<InstrumentedNamedFactory>("CPUPool")) ,
         io_exec_(io_thread_count_,  std::make_shared<InstrumentedNamedFactory>("IOPool")),
+        memory_governor_(ConfigsMap::instance()->get_int("VersionStore.MemoryBudget", 0)),
         created_(false){
         ARCTICDB_RUNTIME_DEBUG(log::schedule(), "Task scheduler created with {:d} {:d}", cpu_thread_count_, io_thread_count_);
     }
@@ -207,6 +217,14 @@ class TaskScheduler {
         io_exec_.set_max_threads(n);
     }
 
+    size_t cpu_thread_count() const {
+        return cpu_thread_count_;
+    }
+
+    size_t io_thread_count() const {
+        return io_thread_count_;
+    }
+
     SchedulerWrapper<CPUSchedulerType>& cpu_exec() {
         ARCTICDB_DEBUG(log::schedule(), "Getting CPU executor: {}", cpu_exec_.getTaskQueueSize());
         return cpu_exec_;
@@ -217,6 +235,11 @@ class TaskScheduler {
         return io_exec_;
     }
 
+    // Shared by all the work scheduled here, with a budget of VersionStore.MemoryBudget bytes, or unbounded if zero
+    MemoryGovernor& memory_governor() {
+        return memory_governor_;
+    }
+
     void re_init() {
         ARCTICDB_RUNTIME_DEBUG(log::schedule(), "Reinitializing task scheduler: {} {}", cpu_thread_count_, io_thread_count_);
         ARCTICDB_RUNTIME_DEBUG(log::schedule(), "IO exec num threads: {}", io_exec_.numActiveThreads());
@@ -234,6 +257,7 @@ private:
     size_t io_thread_count_;
     SchedulerWrapper<CPUSchedulerType> cpu_exec_;
     SchedulerWrapper<IOSchedulerType> io_exec_;
+    MemoryGovernor memory_governor_;
     bool created_;
 };
 
@@ -246,6 +270,10 @@ inline auto& io_executor() {
     return TaskScheduler::instance()->io_exec();
 }
 
+inline auto& memory_governor() {
+    return TaskScheduler::instance()->memory_governor();
+}
+
 template <typename Task>
 inline auto submit_cpu_task(Task&& task) {
     return TaskScheduler::instance()->submit_cpu_task(std::move(task));
@@ -18,9 +18,12 @@
 #include <arcticdb/entity/variant_key.hpp>
 #include <arcticdb/stream/stream_sink.hpp>
 #include <arcticdb/async/base_task.hpp>
+#include <arcticdb/async/memory_governor.hpp>
+#include <arcticdb/codec/encoding_sizes.hpp>
 #include <arcticdb/pipeline/frame_slice.hpp>
 #include <arcticdb/processing/processing_segment.hpp>
 #include <arcticdb/util/constructors.hpp>
+#include <arcticdb/util/task_arena.hpp>
 
 #include <type_traits>
 
@@ -290,6 +293,7 @@ struct DecodeSegmentTask : BaseTask {
 
     std::pair<VariantKey, SegmentInMemory> operator()(storage::KeySegmentPair &&ks) const {
         ARCTICDB_SAMPLE(DecodeAtomTask, 0)
+        ScopedTaskArena arena;
 
         auto key_seg = std::move(ks);
         ARCTICDB_DEBUG(log::storage(), "ReadAndDecodeAtomTask decoding segment of size {} with key {}",
@@ -315,6 +319,7 @@ struct DecodeSlicesTask : BaseTask {
 
     Composite<pipelines::SliceAndKey> operator()(Composite<std::pair<Segment, pipelines::SliceAndKey>> && skp) const {
         ARCTICDB_SAMPLE(DecodeAtomTask, 0)
+        ScopedTaskArena arena;
         auto sk_pairs = std::move(skp);
         return sk_pairs.transform([that=this] (auto&& seg_slice_pair){
             ARCTICDB_DEBUG(log::version(), "Decoding slice {}", seg_slice_pair.second.key());
@@ -342,6 +347,40 @@ struct SegmentFunctionTask : BaseTask {
     }
 };
 
+// Resizes the reservation made when a read was submitted to the memory needed to decode the segments it read, which
+// is the compressed segments and what they decode to. Doesn't block, so that IO threads never wait on the budget. The
+// reservation is held until the caller releases it once the segments have been decoded
+struct ResizeDecodeReservationTask : BaseTask {
+    std::shared_ptr<MemoryReservation> reservation_;
+    // False when the segment is decoded into memory that is already allocated, such as a read's output frame, so only
+    // the compressed segment is new
+    bool decodes_to_new_memory_;
+
+    explicit ResizeDecodeReservationTask(std::shared_ptr<MemoryReservation> reservation, bool decodes_to_new_memory = true) :
+        reservation_(std::move(reservation)),
+        decodes_to_new_memory_(decodes_to_new_memory) {
+    }
+
+    ARCTICDB_MOVE_ONLY_DEFAULT(ResizeDecodeReservationTask)
+
+    [[nodiscard]] size_t decode_size(const Segment& segment) const {
+        const auto compressed_size = segment.total_segment_size();
+        return decodes_to_new_memory_ ? compressed_size + encoding_size::uncompressed_size(segment.header()) : compressed_size;
+    }
+
+    storage::KeySegmentPair operator()(storage::KeySegmentPair &&key_seg) const {
+        reservation_->resize(decode_size(key_seg.segment()));
+        return std::move(key_seg);
+    }
+
+    Composite<std::pair<Segment, pipelines::SliceAndKey>> operator()(Composite<std::pair<Segment, pipelines::SliceAndKey>> &&skp) const {
+        size_t bytes = 0;
+        skp.broadcast([&bytes, this](const auto& seg_slice_pair) { bytes += decode_size(seg_slice_pair.first); });
+        reservation_->resize(bytes);
+        return std::move(skp);
+    }
+};
+
 // This class is used to restart the pipeline following a repartition
 struct MemSegmentPassthroughProcessingTask : BaseTask {
     std::shared_ptr<Store> store_;
@@ -361,10 +400,10 @@ struct MemSegmentPassthroughProcessingTask : BaseTask {
     Composite<ProcessingSegment> process(Composite<ProcessingSegment>&& proc){
         auto procs = std::move(proc);
         for(const auto& clause : *clauses_) {
+            procs = clause.process(store_, std::move(procs));
+
             if(clause.requires_repartition())
                 break;
-
-            procs = clause.process(store_, std::move(procs));
         }
         return procs;
     }
@@ -372,6 +411,7 @@ struct MemSegmentPassthroughProcessingTask : BaseTask {
     ARCTICDB_MOVE_ONLY_DEFAULT(MemSegmentPassthroughProcessingTask)
 
     Composite<ProcessingSegment> operator()() {
+        ScopedTaskArena arena;
         return process(std::move(starting_segments_.value()));
     }
 };
@@ -407,6 +447,7 @@ struct MemSegmentProcessingTask : BaseTask {
     ARCTICDB_MOVE_ONLY_DEFAULT(MemSegmentProcessingTask)
 
     Composite<ProcessingSegment> operator()(Composite<pipelines::SliceAndKey>&& sk) {
+        ScopedTaskArena arena;
         return process(Composite<ProcessingSegment>(slice_to_segment(std::move(sk))));
     }
 
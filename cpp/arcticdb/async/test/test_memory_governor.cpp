@@ -0,0 +1,83 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/async/memory_governor.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace arcticdb::async;
+
+TEST(MemoryGovernor, UnboundedWhenBudgetIsZero) {
+    MemoryGovernor governor{0};
+    auto reservation = governor.reserve(1 << 30);
+    ASSERT_TRUE(governor.try_reserve(1 << 30).has_value());
+    ASSERT_EQ(governor.reserved_bytes(), 0u);
+}
+
+TEST(MemoryGovernor, ReservesWithinBudget) {
+    MemoryGovernor governor{100};
+    {
+        auto first = governor.reserve(60);
+        ASSERT_EQ(governor.reserved_bytes(), 60u);
+        ASSERT_FALSE(governor.try_reserve(50).has_value());
+
+        auto second = governor.try_reserve(40);
+        ASSERT_TRUE(second.has_value());
+        ASSERT_EQ(governor.reserved_bytes(), 100u);
+
+        first.release();
+        ASSERT_EQ(governor.reserved_bytes(), 40u);
+        MemoryReservation moved{std::move(*second)};
+        ASSERT_EQ(governor.reserved_bytes(), 40u);
+    }
+    ASSERT_EQ(governor.reserved_bytes(), 0u);
+}
+
+TEST(MemoryGovernor, GrantsOversizeReservationWhenIdle) {
+    MemoryGovernor governor{100};
+    auto reservation = governor.reserve(1000);
+    ASSERT_EQ(reservation.bytes(), 1000u);
+    ASSERT_FALSE(governor.try_reserve(1).has_value());
+}
+
+TEST(MemoryGovernor, BlocksUntilReleased) {
+    MemoryGovernor governor{100};
+    auto held = governor.reserve(80);
+    std::atomic<bool> reserved{false};
+    std::thread waiter([&governor, &reserved] {
+        auto reservation = governor.reserve(50);
+        reserved = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_FALSE(reserved);
+    held.release();
+    waiter.join();
+    ASSERT_TRUE(reserved);
+    ASSERT_EQ(governor.reserved_bytes(), 0u);
+}
+
+TEST(MemoryGovernor, ResizesWithoutBlocking) {
+    MemoryGovernor governor{100};
+    auto first = governor.reserve_typical();
+    ASSERT_EQ(first.bytes(), 0u);
+
+    // Work that turns out larger than the budget still proceeds, but holds back further reservations
+    first.resize(150);
+    ASSERT_EQ(governor.reserved_bytes(), 150u);
+    ASSERT_FALSE(governor.try_reserve(0).has_value());
+
+    first.resize(60);
+    ASSERT_EQ(governor.reserved_bytes(), 60u);
+    auto second = governor.reserve_typical();
+    ASSERT_GT(second.bytes(), 0u);
+    ASSERT_EQ(governor.reserved_bytes(), 60u + second.bytes());
+}
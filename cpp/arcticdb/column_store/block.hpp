@@ -34,23 +34,25 @@ struct MemBlock {
     template<size_t DefaultBlockSize> friend
     class ChunkedBufferImpl;
 
-    explicit MemBlock(size_t capacity, size_t offset, entity::timestamp ts) :
+    explicit MemBlock(size_t capacity, size_t offset, entity::timestamp ts, size_t alloc_size) :
             bytes_(0),
             capacity_(capacity),
             external_data_(nullptr),
             offset_(offset),
-            ts_(ts) {
+            ts_(ts),
+            alloc_size_(alloc_size) {
 #ifdef DEBUG_BUILD
         memset(data_, 'c', capacity_); // For identifying unwritten-to block portions
 #endif
     }
 
-    MemBlock(const uint8_t *data, size_t size, size_t offset, entity::timestamp ts) :
+    MemBlock(const uint8_t *data, size_t size, size_t offset, entity::timestamp ts, size_t alloc_size) :
             bytes_(size),
             capacity_(size),
             external_data_(data),
             offset_(offset),
-            ts_(ts) {
+            ts_(ts),
+            alloc_size_(alloc_size) {
     }
 
     bool is_external() const {
@@ -117,6 +119,8 @@ struct MemBlock {
     const uint8_t *external_data_;
     size_t offset_;
     entity::timestamp ts_;
+    // The size passed to Allocator::pooled_alloc, which may be larger than the header and capacity
+    size_t alloc_size_;
 
     static const size_t HeaderDataSize =
             sizeof(magic_) +   // 8 bytes
@@ -124,7 +128,8 @@ struct MemBlock {
             sizeof(capacity_) +   // 8 bytes
             sizeof(external_data_) +
             sizeof(offset_) +
-            sizeof(ts_);      // 8 bytes
+            sizeof(ts_) +      // 8 bytes
+            sizeof(alloc_size_);
 
     uint8_t pad[Align - HeaderDataSize];
     static const size_t HeaderSize = HeaderDataSize + sizeof(pad);
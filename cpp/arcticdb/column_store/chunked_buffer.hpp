@@ -305,8 +305,9 @@ class ChunkedBufferImpl {
     }
 
     void add_block(size_t capacity, size_t offset) {
-        auto [ptr, ts] = Allocator::aligned_alloc(BlockType::alloc_size(capacity));
-        new(ptr) MemBlock(capacity, offset, ts);
+        const auto alloc_size = Allocator::pooled_size(BlockType::alloc_size(capacity));
+        auto [ptr, ts] = Allocator::pooled_alloc(alloc_size);
+        new(ptr) MemBlock(capacity, offset, ts, alloc_size);
         blocks_.emplace_back(reinterpret_cast<BlockType*>(ptr));
     }
 
@@ -314,8 +315,9 @@ class ChunkedBufferImpl {
         if (!no_blocks() && last_block().empty())
             free_last_block();
 
-        auto [ptr, ts] = Allocator::aligned_alloc(sizeof(MemBlock));
-        new(ptr) MemBlock(data, size, offset, ts);
+        const auto alloc_size = Allocator::pooled_size(sizeof(MemBlock));
+        auto [ptr, ts] = Allocator::pooled_alloc(alloc_size);
+        new(ptr) MemBlock(data, size, offset, ts, alloc_size);
         blocks_.emplace_back(reinterpret_cast<BlockType*>(ptr));
         bytes_ += size;
     }
@@ -356,7 +358,7 @@ class ChunkedBufferImpl {
     void free_block(BlockType* block) const {
         ARCTICDB_TRACE(log::storage(), "Freeing block at address {:x}", uintptr_t(block));
         block->magic_.check();
-        Allocator::free(std::make_pair(reinterpret_cast<uint8_t *>(block), block->ts_));
+        Allocator::pooled_free(std::make_pair(reinterpret_cast<uint8_t *>(block), block->ts_), block->alloc_size_);
     }
 
     void free_last_block() {
@@ -28,6 +28,7 @@
 #include <bitmagic/bm.h>
 #include <bitmagic/bmserial.h>
 
+#include <cmath>
 #include <optional>
 #include <numeric>
 
@@ -522,6 +523,21 @@ public:
         }
     }
 
+    // Makes all of the column's rows missing, which is recorded as an empty sparse map rather than a value per row.
+    // The values buffer is left as it is, so the pages of a presized column that hasn't been written are never touched
+    void mark_all_null(size_t num_rows) {
+        sparse_map_.emplace();
+        last_logical_row_ = static_cast<ssize_t>(num_rows) - 1;
+        last_physical_row_ = -1;
+    }
+
+    // Whether the column has rows but no values, which is how a slice of a sparse column with no values is decoded.
+    // Dense columns built from external blocks or arrays don't track their physical rows, so only a column with an
+    // empty sparse map counts
+    bool is_all_null() const {
+        return last_logical_row_ >= 0 && last_physical_row_ < 0 && sparse_map_.has_value() && sparse_map_->count() == 0;
+    }
+
     void default_initialize_rows(size_t start_pos, size_t num_rows, bool ensure_alloc) {
         type_.visit_tag([that=this, start_pos, num_rows, ensure_alloc](auto tag) {
             using T= std::decay_t<decltype(tag)>;
@@ -548,6 +564,11 @@ public:
         if(sparse_map_) {
             last_physical_row_ = sparse_map_.value().count() - 1;
         }
+        else if (last_stored_row == -1 && last_logical_row_ != -1) {
+            // Sparse columns with no values are written without a sparse map, so have no rows to backfill it from
+            sparse_map_.emplace();
+            last_physical_row_ = -1;
+        }
         else if (last_logical_row_ != last_stored_row) {
             last_physical_row_ = last_stored_row;
             backfill_sparse_map(last_stored_row);
@@ -949,14 +970,29 @@ private:
     util::MagicNum<'D', 'C', 'o', 'l'> magic_;
 };
 
+// A strict weak ordering of values to sort on, which places NaNs after every other value
+template <typename T>
+bool sort_less(const T& left, const T& right) {
+    if constexpr (std::is_floating_point_v<T>)
+        return !std::isnan(left) && (std::isnan(right) || left < right);
+    else
+        return left < right;
+}
+
 template <typename T>
 JiveTable create_jive_table(const Column& col) {
     JiveTable output(col.row_count());
     std::iota(std::begin(output.orig_pos_), std::end(output.orig_pos_), 0);
     std::iota(std::begin(output.sorted_pos_), std::end(output.sorted_pos_), 0);
 
-    std::sort(std::begin(output.orig_pos_), std::end(output.orig_pos_),[&](const auto& a, const auto& b) -> bool {
-        return col.template scalar_at<T>(a) < col.template scalar_at<T>(b);
+    // Stable, so that rows with equal values keep their original relative order
+    std::stable_sort(std::begin(output.orig_pos_), std::end(output.orig_pos_),[&](const auto& a, const auto& b) -> bool {
+        const auto left = col.template scalar_at<T>(a);
+        const auto right = col.template scalar_at<T>(b);
+        if (!left || !right)
+            return !left && right;
+
+        return sort_less(*left, *right);
     });
 
     std::sort(std::begin(output.sorted_pos_), std::end(output.sorted_pos_),[&](const auto& a, const auto& b) -> bool {
@@ -136,6 +136,10 @@ public:
         impl_->set_no_string_at(col, row, placeholder);
     }
 
+    void set_strings_at(position_t col, position_t first_row, const std::string_view* strings, size_t count) {
+        impl_->set_strings_at(col, first_row, strings, count);
+    }
+
     void set_string_array(position_t idx, size_t string_size, size_t num_strings, char *data) {
         impl_->set_string_array(idx, string_size, num_strings, data);
     }
@@ -28,6 +28,8 @@
 #include <boost/iterator/iterator_facade.hpp>
 #include <folly/container/Enumerate.h>
 
+#include <array>
+
 namespace arcticdb {
 
 class SegmentInMemoryImpl;
@@ -578,6 +580,18 @@ public:
         column_unchecked(col).set_scalar(row, placeholder);
     }
 
+    // Sets the strings of consecutive rows starting at first_row, deduplicating them in batches
+    void set_strings_at(position_t col, position_t first_row, const std::string_view* strings, size_t count) {
+        std::array<OffsetString::offset_t, StringPool::BatchSize> offsets;
+        auto& column = column_unchecked(col);
+        for(size_t begin = 0; begin < count; begin += StringPool::BatchSize) {
+            const auto batch_size = std::min(count - begin, StringPool::BatchSize);
+            string_pool_->get_batch(strings + begin, batch_size, offsets.data());
+            for(size_t i = 0; i < batch_size; ++i)
+                column.set_scalar(first_row + static_cast<position_t>(begin + i), offsets[i]);
+        }
+    }
+
     void set_string_array(position_t idx, size_t string_size, size_t num_strings, char *data) {
         check_column_index(idx);
         column_unchecked(idx).set_string_array(row_id_ + 1, string_size, num_strings, data, string_pool());
@@ -954,6 +968,10 @@ public:
         // Index is built to make rank queries faster
         std::unique_ptr<util::BitIndex> filter_idx;
         for(const auto& column : folly::enumerate(columns())) {
+            // Left out of the sparse output, like a sparse column whose values are all filtered out
+            if((*column)->is_all_null())
+                continue;
+
             (*column)->type().visit_tag([&] (auto type_desc_tag){
                 using TypeDescriptorTag = decltype(type_desc_tag);
                 using ColumnTagType = typename TypeDescriptorTag::DataTypeTag;
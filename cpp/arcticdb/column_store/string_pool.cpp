@@ -11,6 +11,9 @@
 #include <arcticdb/util/third_party/emilib_set.hpp>
 #include <arcticdb/util/third_party/robin_hood.hpp>
 
+#include <algorithm>
+#include <array>
+
 namespace arcticdb {
 py::buffer_info StringPool::as_buffer_info() const {
     return py::buffer_info{
@@ -22,35 +25,46 @@ py::buffer_info StringPool::as_buffer_info() const {
 }
 
 bool StringPool::string_exists(const std::string_view& str) {
-    return map_.find(str)  != map_.end();
+    return map_.find(hashed_string(str)) != map_.end();
 }
 
-OffsetString StringPool::get(const std::string_view &s, bool deduplicate) {
-    if(deduplicate) {
-        if (auto it = map_.find(s); it != map_.end())
-            return OffsetString(it->second, this);
-    }
+StringPool::offset_t StringPool::get_hashed(const HashedString& str) {
+    if (auto it = map_.find(str); it != map_.end())
+        return it->second;
 
-    OffsetString str(block_.insert(s.data(), s.size()), this);
+    const auto offset = block_.insert(str.view_.data(), str.view_.size());
+    map_.emplace(HashedString{block_.at(offset), str.hash_}, offset);
+    return offset;
+}
 
+OffsetString StringPool::get(const std::string_view &s, bool deduplicate) {
     if(deduplicate)
-        map_.insert(robin_hood::pair(block_.at(str.offset()), str.offset()));
+        return OffsetString(get_hashed(hashed_string(s)), this);
 
-    return str;
+    return OffsetString(block_.insert(s.data(), s.size()), this);
 }
 
 OffsetString StringPool::get(const char *data, size_t size, bool deduplicate) {
-    StringType s(data, size);
-    if(deduplicate) {
-        if (auto it = map_.find(s); it != map_.end())
-            return OffsetString(it->second, this);
-    }
-
-    OffsetString str(block_.insert(s.data(), s.size()), this);
-    if(deduplicate)
-        map_.insert(robin_hood::pair(StringType(str), str.offset()));
+    return get(StringType(data, size), deduplicate);
+}
 
-    return str;
+void StringPool::get_batch(const StringType* strings, size_t count, offset_t* offsets) {
+    std::array<size_t, BatchSize> hashes;
+    for(size_t begin = 0; begin < count; begin += BatchSize) {
+        const auto end = std::min(count, begin + BatchSize);
+        // The hashes don't depend on each other, so computing them in one pass lets them overlap rather than each
+        // waiting on the map lookup before it
+        for(auto i = begin; i < end; ++i)
+            hashes[i - begin] = robin_hood::hash_bytes(strings[i].data(), strings[i].size());
+
+        for(auto i = begin; i < end; ++i) {
+            const HashedString str{strings[i], hashes[i - begin]};
+            if(i != 0 && (i == begin || hashes[i - begin - 1] == str.hash_) && strings[i - 1] == str.view_)
+                offsets[i] = offsets[i - 1];
+            else
+                offsets[i] = get_hashed(str);
+        }
+    }
 }
 
 std::string_view StringPool::get_view(const offset_t &o) {
@@ -64,33 +78,31 @@ std::string_view StringPool::get_const_view(const offset_t &o) const {
 std::optional<position_t> StringPool::get_offset_for_column(std::string_view string, const Column& column) {
     auto unique_values = unique_values_for_string_column(column);
     remove_nones_and_nans(unique_values);
-    robin_hood::unordered_flat_map<std::string_view, offset_t> col_values;
-    col_values.reserve(unique_values.size());
+    std::optional<position_t> output;
     for(auto pos : unique_values) {
-        col_values.emplace(block_.const_at(pos), pos);
+        if(block_.const_at(pos) == string) {
+            output = pos;
+            break;
+        }
     }
-
-    std::optional<position_t> output;
-    if(auto loc = col_values.find(string); loc != col_values.end())
-        output = loc->second;
     return output;
 }
 
 emilib::HashSet<position_t> StringPool::get_offsets_for_column(const std::shared_ptr<std::unordered_set<std::string>>& strings, const Column& column) {
     auto unique_values = unique_values_for_string_column(column);
     remove_nones_and_nans(unique_values);
-    robin_hood::unordered_flat_map<std::string_view, offset_t> col_values;
-    col_values.reserve(unique_values.size());
-    for(auto pos : unique_values) {
-        col_values.emplace(block_.const_at(pos), pos);
-    }
+    // The value set is usually much smaller than the number of distinct values in the column, so hash that instead,
+    // and look each of the column's values up in it
+    robin_hood::unordered_flat_set<HashedString, HashedStringHash, HashedStringEqual> values;
+    values.reserve(strings->size());
+    for(const auto& string : *strings)
+        values.emplace(hashed_string(string));
 
     emilib::HashSet<position_t> output;
-    for(const auto& string : *strings) {
-        auto loc = col_values.find(string);
-        if(loc != col_values.end())
-            output.insert(loc->second);
+    for(auto pos : unique_values) {
+        if(values.contains(hashed_string(block_.const_at(pos))))
+            output.insert(pos);
     }
     return output;
 }
-}
\ No newline at end of file
+}
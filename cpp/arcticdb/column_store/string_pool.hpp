@@ -140,11 +140,39 @@ class StringBlock {
 
 class OffsetString;
 
+/*
+ * A string with its hash, which the string pool's map keeps alongside each key so that the strings aren't rehashed when
+ * the map grows or is copied, and so that a lookup followed by an insert hashes the string once.
+ */
+struct HashedString {
+    std::string_view view_;
+    size_t hash_;
+};
+
+inline HashedString hashed_string(std::string_view view) {
+    return {view, robin_hood::hash_bytes(view.data(), view.size())};
+}
+
+struct HashedStringHash {
+    size_t operator()(const HashedString& str) const noexcept {
+        return str.hash_;
+    }
+};
+
+struct HashedStringEqual {
+    bool operator()(const HashedString& left, const HashedString& right) const noexcept {
+        return left.hash_ == right.hash_ && left.view_ == right.view_;
+    }
+};
+
 class StringPool {
   public:
     using offset_t = position_t;
     using StringType = std::string_view;
-    using MapType = robin_hood::unordered_flat_map<StringType, offset_t>;
+    using MapType = robin_hood::unordered_flat_map<HashedString, offset_t, HashedStringHash, HashedStringEqual>;
+
+    // Number of strings hashed at a time by get_batch before they are looked up
+    static constexpr size_t BatchSize = 1024;
 
     StringPool() = default;
     ~StringPool() = default;
@@ -195,6 +223,10 @@ class StringPool {
 
     OffsetString get(const std::string_view &s, bool deduplicate = true);
 
+    // Deduplicates a block of strings, writing the offset of each to offsets. The strings are hashed in batches before
+    // any of them is looked up, and runs of the same string are only looked up once
+    void get_batch(const StringType* strings, size_t count, offset_t* offsets);
+
     const ChunkedBuffer &data() const {
         return block_.buffer();
     }
@@ -228,6 +260,8 @@ class StringPool {
     std::optional<position_t> get_offset_for_column(std::string_view str, const Column& column);
     emilib::HashSet<position_t> get_offsets_for_column(const std::shared_ptr<std::unordered_set<std::string>>& strings, const Column& column);
   private:
+    offset_t get_hashed(const HashedString& str);
+
     MapType map_;
     mutable StringBlock block_;
     mutable CursoredBuffer<Buffer> shapes_;  //TODO MemBlock::MinSize
@@ -8,6 +8,7 @@
 #include <gtest/gtest.h>
 #include <cstdint>
 #include <limits>
+#include <numeric>
 
 #include <arcticdb/column_store/memory_segment.hpp>
 #include <arcticdb/util/test/test_utils.hpp>
@@ -197,6 +198,42 @@ TEST(Column, SparseChangeType) {
     }
 }
 
+TEST(Column, AllNull) {
+    using TDT = TypeDescriptorTag<DataTypeTag<DataType::INT64>, DimensionTag<Dimension::Dim0>>;
+    Column column(static_cast<TypeDescriptor>(TDT{}), 0, false, true);
+    // As a slice of a sparse column with no values is decoded
+    column.set_row_data(9);
+
+    ASSERT_TRUE(column.is_all_null());
+    ASSERT_TRUE(column.is_sparse());
+    ASSERT_EQ(column.row_count(), 0);
+    for(auto i = 0; i < 10; ++i)
+        check_value(column.scalar_at<int64_t>(i), std::nullopt);
+}
+
+TEST(Column, MarkAllNull) {
+    auto column = get_dense_column();
+    ASSERT_FALSE(column->is_all_null());
+
+    column->mark_all_null(10);
+    ASSERT_TRUE(column->is_all_null());
+    ASSERT_TRUE(column->is_sparse());
+    for(auto i = 0; i < 10; ++i)
+        check_value(column->scalar_at<int64_t>(i), std::nullopt);
+}
+
+TEST(Column, ExternalBlockIsNotAllNull) {
+    using TDT = TypeDescriptorTag<DataTypeTag<DataType::INT64>, DimensionTag<Dimension::Dim0>>;
+    Column column(static_cast<TypeDescriptor>(TDT{}), 0, false, false);
+    std::vector<int64_t> values(10);
+    std::iota(values.begin(), values.end(), 0);
+    // Dense columns built from external blocks don't track their physical rows
+    column.set_external_block(0, values.data(), values.size());
+
+    ASSERT_FALSE(column.is_all_null());
+    ASSERT_FALSE(column.is_sparse());
+}
+
 TEST(Column, AppendDenseToDense) {
     auto col1 = get_dense_column();
     auto col2 = get_dense_column(10);
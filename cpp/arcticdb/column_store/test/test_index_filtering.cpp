@@ -13,6 +13,8 @@
 #include <arcticdb/stream/index.hpp>
 #include <arcticdb/storage/test/in_memory_store.hpp>
 #include <arcticdb/pipeline/index_writer.hpp>
+#include <arcticdb/pipeline/index_segment_reader.hpp>
+#include <arcticdb/util/configs_map.hpp>
 
 namespace arcticdb {
 using namespace arcticdb::pipelines;
@@ -256,4 +258,42 @@ TEST(IndexFilter, StaticMulticolumnFilterColumns) {
     ASSERT_EQ(pipeline_context->slice_and_keys_[4].key_, slice_and_keys[16].key_);
     ASSERT_EQ(pipeline_context->slice_and_keys_[5].key_, slice_and_keys[92].key_);
     ASSERT_EQ(pipeline_context->slice_and_keys_[9].key_, slice_and_keys[96].key_);
-}
\ No newline at end of file
+}
+
+TEST(IndexFilter, CachedIndexReader) {
+    using namespace arcticdb;
+    using namespace arcticdb::pipelines;
+
+    const auto stream_id = StreamId{"cached"};
+    auto [metadata, slice_and_keys] = get_sample_slice_and_key(stream_id, VersionId{0});
+
+    auto mock_store = std::make_shared<InMemoryStore>();
+    index::IndexWriter<stream::RowCountIndex> writer(mock_store, IndexPartialKey{stream_id, VersionId{0}}, std::move(metadata));
+    for (auto &slice_and_key : slice_and_keys) {
+        writer.add(slice_and_key.key(), slice_and_key.slice());
+    }
+    auto key = std::move(writer.commit()).get();
+
+    auto& cache = index::IndexSegmentReaderCache::instance();
+    cache.clear();
+    auto reader = index::get_cached_index_reader(key, mock_store);
+    ASSERT_EQ(reader->size(), slice_and_keys.size());
+    ASSERT_EQ(cache.size(), 1u);
+
+    // Served from the cache on the next read of the same key from the same store
+    ASSERT_EQ(index::get_cached_index_reader(key, mock_store), reader);
+    ASSERT_EQ(cache.size(), 1u);
+
+    // Another store holding the same key doesn't share the entry
+    auto other_store = std::make_shared<InMemoryStore>();
+    ASSERT_EQ(cache.get(other_store, key), nullptr);
+    cache.put(other_store, key, reader);
+    ASSERT_EQ(cache.size(), 2u);
+
+    // Segments larger than the budget are not kept
+    ScopedConfig max_bytes("VersionStore.IndexCacheBytes", 1);
+    cache.clear();
+    auto other_key = atom_key_builder().version_id(1).build(stream_id, KeyType::TABLE_INDEX);
+    cache.put(mock_store, other_key, reader);
+    ASSERT_EQ(cache.size(), 0u);
+}
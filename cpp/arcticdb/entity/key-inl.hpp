@@ -177,6 +177,16 @@ enum class KeyType : int {
      * Contains multiple LOG keys in its segment (to be used by low-priority replication job)
      */
     LOG_COMPACTED = 24,
+    /*
+     * Checkpoint of the version chain of a symbol, written every VersionMap.IndexInterval versions, so that loading
+     * old versions does not take one read per VERSION key. See VersionIndex in version_utils.hpp
+     */
+    VERSION_INDEX = 25,
+    /*
+     * Reverse index from the index keys of a symbol to the snapshots containing them, one per symbol, plus one with a
+     * reserved id listing the snapshots the index covers. See snapshot.hpp
+     */
+    SNAPSHOT_MEMBERSHIP = 26,
     UNDEFINED
 };
 
@@ -191,9 +201,11 @@ inline std::vector<KeyType> key_types_write_precedence() {
         KeyType::VERSION,
         KeyType::VERSION_JOURNAL,
         KeyType::VERSION_REF,
+        KeyType::VERSION_INDEX,
         KeyType::SYMBOL_LIST,
         KeyType::SNAPSHOT,
         KeyType::SNAPSHOT_REF,
+        KeyType::SNAPSHOT_MEMBERSHIP,
         KeyType::SNAPSHOT_TOMBSTONE,
         KeyType::APPEND_REF,
         KeyType::APPEND_DATA,
@@ -0,0 +1,317 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/pipeline/arrow_output_frame.hpp>
+#include <arcticdb/pipeline/string_pool_utils.hpp>
+#include <arcticdb/entity/performance_tracing.hpp>
+#include <arcticdb/util/sparse_utils.hpp>
+
+#include <cstdlib>
+#include <memory>
+
+namespace arcticdb::pipelines {
+
+namespace {
+
+struct FreeDeleter {
+    void operator()(uint8_t* ptr) const {
+        std::free(ptr);
+    }
+};
+
+// Owns the buffers of an exported array that aren't shared with the frame, and keeps the frame alive for those that are
+struct ExportedArray {
+    SegmentInMemory frame_;
+    std::vector<std::unique_ptr<uint8_t, FreeDeleter>> owned_;
+    std::vector<const void*> buffers_;
+    std::vector<ArrowArray*> children_;
+
+    // Arrow buffers should be at least 8 byte aligned, and must not be null other than the validity bitmap. Buffers
+    // are zeroed, which for large ones comes from the kernel's fresh pages rather than being written here
+    uint8_t* allocate(size_t bytes) {
+        auto ptr = static_cast<uint8_t*>(std::calloc(std::max<size_t>(1, bytes), 1));
+        util::check(ptr != nullptr, "Failed to allocate {} bytes for Arrow buffer", bytes);
+        owned_.emplace_back(ptr);
+        return ptr;
+    }
+};
+
+struct ExportedSchema {
+    std::string format_;
+    std::string name_;
+    std::vector<ArrowSchema*> children_;
+};
+
+void release_array(ArrowArray* array) {
+    auto exported = static_cast<ExportedArray*>(array->private_data);
+    for(auto child : exported->children_) {
+        if(child->release)
+            child->release(child);
+        delete child;
+    }
+    delete exported;
+    array->release = nullptr;
+}
+
+void release_schema(ArrowSchema* schema) {
+    auto exported = static_cast<ExportedSchema*>(schema->private_data);
+    for(auto child : exported->children_) {
+        if(child->release)
+            child->release(child);
+        delete child;
+    }
+    delete exported;
+    schema->release = nullptr;
+}
+
+void init_array(ArrowArray* array, std::unique_ptr<ExportedArray> exported, int64_t length, int64_t null_count) {
+    array->length = length;
+    array->null_count = null_count;
+    array->offset = 0;
+    array->n_buffers = static_cast<int64_t>(exported->buffers_.size());
+    array->buffers = exported->buffers_.data();
+    array->n_children = static_cast<int64_t>(exported->children_.size());
+    array->children = exported->children_.empty() ? nullptr : exported->children_.data();
+    array->dictionary = nullptr;
+    array->release = release_array;
+    array->private_data = exported.release();
+}
+
+void init_schema(ArrowSchema* schema, std::unique_ptr<ExportedSchema> exported) {
+    schema->format = exported->format_.c_str();
+    schema->name = exported->name_.c_str();
+    schema->metadata = nullptr;
+    schema->flags = ARROW_FLAG_NULLABLE;
+    schema->n_children = static_cast<int64_t>(exported->children_.size());
+    schema->children = exported->children_.empty() ? nullptr : exported->children_.data();
+    schema->dictionary = nullptr;
+    schema->release = release_schema;
+    schema->private_data = exported.release();
+}
+
+std::string arrow_format(DataType data_type) {
+    switch(data_type) {
+    case DataType::UINT8: return "C";
+    case DataType::UINT16: return "S";
+    case DataType::UINT32: return "I";
+    case DataType::UINT64: return "L";
+    case DataType::INT8: return "c";
+    case DataType::INT16: return "s";
+    case DataType::INT32: return "i";
+    case DataType::INT64: return "l";
+    case DataType::FLOAT32: return "f";
+    case DataType::FLOAT64: return "g";
+    case DataType::BOOL8: return "b";
+    case DataType::MICROS_UTC64: return "tsn:";
+    case DataType::UTF_FIXED64:
+    case DataType::UTF_DYNAMIC64: return "U";
+    case DataType::ASCII_FIXED64:
+    case DataType::ASCII_DYNAMIC64:
+    case DataType::BYTES_DYNAMIC64: return "Z";
+    default:
+        break;
+    }
+    util::raise_rte("No Arrow format for data type {}", datatype_to_str(data_type));
+    return {};  // unreachable
+}
+
+void set_bit(uint8_t* bitmap, size_t pos) {
+    bitmap[pos / 8] |= static_cast<uint8_t>(1u << (pos % 8));
+}
+
+// Shares the buffer when it is a single block, otherwise copies its blocks into one
+const uint8_t* contiguous_bytes(const ChunkedBuffer& buffer, size_t bytes, ExportedArray& exported) {
+    if(buffer.num_blocks() == 1 && buffer.bytes() >= bytes)
+        return buffer.data();
+
+    auto target = exported.allocate(bytes);
+    size_t pos = 0;
+    for(const auto block : buffer.blocks()) {
+        const auto block_bytes = std::min<size_t>(block->bytes(), bytes - pos);
+        memcpy(target + pos, block->data(), block_bytes);
+        pos += block_bytes;
+    }
+    return target;
+}
+
+// Returns a pointer to the column's values with one per row, expanding sparse columns
+const uint8_t* dense_values(Column& column, size_t rows, ExportedArray& exported) {
+    const auto& buffer = column.data().buffer();
+    const auto type_size = get_type_size(column.type().data_type());
+    if(!column.opt_sparse_map())
+        return contiguous_bytes(buffer, rows * type_size, exported);
+
+    auto values = exported.allocate(rows * type_size);
+    const auto physical = contiguous_bytes(buffer, buffer.bytes(), exported);
+    column.type().visit_tag([&](auto tdt) {
+        using TagType = decltype(tdt);
+        using RawType = typename TagType::DataTypeTag::raw_type;
+        util::default_initialize<TagType>(values, rows * type_size);
+        util::expand_dense_buffer_using_bitmap<RawType>(column.opt_sparse_map().value(), physical, values);
+    });
+    return values;
+}
+
+// The validity bitmap of a sparse column, or null if every row has a value
+const uint8_t* validity_from_sparse_map(Column& column, size_t rows, ExportedArray& exported, int64_t& null_count) {
+    null_count = 0;
+    if(!column.opt_sparse_map())
+        return nullptr;
+
+    const auto& sparse_map = column.opt_sparse_map().value();
+    auto bitmap = exported.allocate((rows + 7) / 8);
+    size_t valid = 0;
+    for(auto en = sparse_map.first(); en < sparse_map.end() && *en < rows; ++en, ++valid)
+        set_bit(bitmap, *en);
+
+    null_count = static_cast<int64_t>(rows - valid);
+    return bitmap;
+}
+
+int64_t export_string_column(const Column& column, const StringPool& string_pool, size_t rows, ExportedArray& exported) {
+    const auto& buffer = column.data().buffer();
+    int64_t null_count = 0;
+    size_t data_bytes = 0;
+    for(size_t row = 0; row < rows; ++row) {
+        const auto offset = get_offset_string_at(row, buffer);
+        if(offset == not_a_string() || offset == nan_placeholder())
+            ++null_count;
+        else
+            data_bytes += string_pool.get_const_view(offset).size();
+    }
+
+    auto validity = null_count > 0 ? exported.allocate((rows + 7) / 8) : nullptr;
+    auto offsets = reinterpret_cast<int64_t*>(exported.allocate((rows + 1) * sizeof(int64_t)));
+    auto data = exported.allocate(data_bytes);
+    int64_t pos = 0;
+    for(size_t row = 0; row < rows; ++row) {
+        offsets[row] = pos;
+        const auto offset = get_offset_string_at(row, buffer);
+        if(offset == not_a_string() || offset == nan_placeholder())
+            continue;
+
+        const auto sv = string_pool.get_const_view(offset);
+        memcpy(data + pos, sv.data(), sv.size());
+        pos += static_cast<int64_t>(sv.size());
+        if(validity)
+            set_bit(validity, row);
+    }
+    offsets[rows] = pos;
+
+    exported.buffers_ = {validity, offsets, data};
+    return null_count;
+}
+
+// A column with no values is exported with every row null in zeroed buffers, without reading the column
+int64_t export_null_column(DataType data_type, size_t rows, ExportedArray& exported) {
+    auto validity = exported.allocate((rows + 7) / 8);
+    if(is_sequence_type(data_type))
+        exported.buffers_ = {validity, exported.allocate((rows + 1) * sizeof(int64_t)), exported.allocate(0)};
+    else if(is_bool_type(data_type))
+        exported.buffers_ = {validity, exported.allocate((rows + 7) / 8)};
+    else
+        exported.buffers_ = {validity, exported.allocate(rows * get_type_size(data_type))};
+
+    return static_cast<int64_t>(rows);
+}
+
+int64_t export_bool_column(Column& column, size_t rows, ExportedArray& exported) {
+    int64_t null_count;
+    auto validity = validity_from_sparse_map(column, rows, exported, null_count);
+    auto values = dense_values(column, rows, exported);
+    auto bits = exported.allocate((rows + 7) / 8);
+    for(size_t row = 0; row < rows; ++row) {
+        if(values[row])
+            set_bit(bits, row);
+    }
+    exported.buffers_ = {validity, bits};
+    return null_count;
+}
+
+} // namespace
+
+ArrowOutputFrame::ArrowOutputFrame(const SegmentInMemory& frame) :
+    frame_(frame),
+    names_(frame.fields().size() - frame.descriptor().index().field_count()),
+    index_columns_(frame.descriptor().index().field_count()) {
+    const auto field_count = frame.descriptor().index().field_count();
+    for (std::size_t c = 0; c < field_count; ++c) {
+        index_columns_[c] = frame.field(c).name();
+    }
+    for (std::size_t c = field_count; c < static_cast<size_t>(frame.fields().size()); ++c) {
+        names_[c - field_count] = frame.field(c).name();
+    }
+}
+
+void ArrowOutputFrame::export_column(size_t col_pos, ArrowArray* array, ArrowSchema* schema) const {
+    ARCTICDB_SAMPLE_DEFAULT(ArrowExportColumn)
+    auto frame = frame_;
+    const auto& field = frame.field(col_pos);
+    const auto data_type = data_type_from_proto(field.type_desc());
+    auto& column = frame.column(static_cast<position_t>(col_pos));
+    util::check(column.type().dimension() == Dimension::Dim0, "Arrow output only supports scalar columns, got {} in column {}",
+                column.type(), field.name());
+
+    auto exported_schema = std::make_unique<ExportedSchema>();
+    exported_schema->format_ = arrow_format(data_type);
+    exported_schema->name_ = field.name();
+
+    const auto rows = frame.row_count();
+    auto exported = std::make_unique<ExportedArray>();
+    exported->frame_ = frame;
+    int64_t null_count;
+    if(column.is_all_null()) {
+        null_count = export_null_column(data_type, rows, *exported);
+    } else if(is_sequence_type(data_type)) {
+        null_count = export_string_column(column, frame.string_pool(), rows, *exported);
+    } else if(is_bool_type(data_type)) {
+        null_count = export_bool_column(column, rows, *exported);
+    } else {
+        auto validity = validity_from_sparse_map(column, rows, *exported, null_count);
+        auto values = dense_values(column, rows, *exported);
+        exported->buffers_ = {validity, values};
+    }
+
+    init_array(array, std::move(exported), static_cast<int64_t>(rows), null_count);
+    init_schema(schema, std::move(exported_schema));
+}
+
+void ArrowOutputFrame::export_record_batch(ArrowArray* array, ArrowSchema* schema) const {
+    ARCTICDB_SAMPLE_DEFAULT(ArrowExportRecordBatch)
+    auto exported_schema = std::make_unique<ExportedSchema>();
+    exported_schema->format_ = "+s";
+    auto exported = std::make_unique<ExportedArray>();
+    exported->frame_ = frame_;
+    exported->buffers_ = {nullptr};
+
+    const auto num_columns = static_cast<size_t>(frame_.fields().size());
+    try {
+        for(size_t c = 0; c < num_columns; ++c) {
+            auto child_array = std::make_unique<ArrowArray>();
+            auto child_schema = std::make_unique<ArrowSchema>();
+            export_column(c, child_array.get(), child_schema.get());
+            exported->children_.push_back(child_array.release());
+            exported_schema->children_.push_back(child_schema.release());
+        }
+    } catch(...) {
+        for(auto child : exported->children_) {
+            child->release(child);
+            delete child;
+        }
+        for(auto child : exported_schema->children_) {
+            child->release(child);
+            delete child;
+        }
+        throw;
+    }
+
+    init_array(array, std::move(exported), static_cast<int64_t>(frame_.row_count()), 0);
+    init_schema(schema, std::move(exported_schema));
+    schema->flags = 0;
+}
+
+}
@@ -0,0 +1,47 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/column_store/memory_segment.hpp>
+#include <arcticdb/pipeline/arrow_c_data_interface.hpp>
+
+#include <string>
+#include <vector>
+
+namespace arcticdb::pipelines {
+
+/*
+ * Exports the output frame of a read through the Arrow C data interface, so that it can be consumed without creating
+ * a Python object per string. Numeric and timestamp columns are shared with the frame without copying. Sparse columns
+ * get a validity bitmap from their sparse map. String columns are expected to hold offsets into the frame's string
+ * pool, with unicode strings UTF-8 encoded, which is how reads with arrow output leave them, and are copied into
+ * Arrow offsets and data buffers, with None and NaN as nulls.
+ */
+class ARCTICDB_VISIBILITY_HIDDEN ArrowOutputFrame {
+public:
+    explicit ArrowOutputFrame(const SegmentInMemory& frame);
+
+    std::vector<std::string>& names() { return names_; }
+
+    std::vector<std::string>& index_columns() { return index_columns_; }
+
+    SegmentInMemory frame() { return frame_; }
+
+    // Exports the frame as a struct array with a child per column, which is how Arrow imports a record batch. The
+    // caller owns both structs and must call their release callbacks
+    void export_record_batch(ArrowArray* array, ArrowSchema* schema) const;
+
+    void export_column(size_t col_pos, ArrowArray* array, ArrowSchema* schema) const;
+
+private:
+    SegmentInMemory frame_;
+    std::vector<std::string> names_;
+    std::vector<std::string> index_columns_;
+};
+
+}
@@ -0,0 +1,87 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/column_store/string_pool.hpp>
+#include <arcticdb/util/constructors.hpp>
+#include <arcticdb/util/third_party/emilib_map.hpp>
+
+#include <folly/concurrency/ConcurrentHashMap.h>
+
+#include <mutex>
+#include <string_view>
+
+namespace arcticdb::pipelines {
+
+/*
+ * Gives every distinct string read by a query one offset in a string pool shared by all the query's columns, so that
+ * they can be reduced in parallel. Strings that are already in the pool are found without locking, and only new ones
+ * take the lock to be added to the underlying pool, which isn't thread safe. The keys are views into the underlying
+ * pool, which doesn't move strings once they're added.
+ */
+class ConcurrentStringPool {
+public:
+    explicit ConcurrentStringPool(StringPool& string_pool) :
+        string_pool_(string_pool) {
+    }
+
+    ARCTICDB_NO_MOVE_OR_COPY(ConcurrentStringPool)
+
+    StringPool::offset_t get(std::string_view sv) {
+        if(auto it = offsets_.find(sv); it != offsets_.end())
+            return it->second;
+
+        std::lock_guard lock(mutex_);
+        if(auto it = offsets_.find(sv); it != offsets_.end())
+            return it->second;
+
+        const auto offset = string_pool_.get(sv).offset();
+        offsets_.insert(string_pool_.get_const_view(offset), offset);
+        return offset;
+    }
+
+    [[nodiscard]] size_t size() const {
+        return offsets_.size();
+    }
+
+private:
+    StringPool& string_pool_;
+    folly::ConcurrentHashMap<std::string_view, StringPool::offset_t> offsets_;
+    std::mutex mutex_;
+};
+
+/*
+ * Maps the offsets of one segment's string pool to those of a shared pool, hashing each distinct string once per
+ * segment rather than once per row.
+ */
+template<typename Transform>
+class SegmentStringMapping {
+public:
+    SegmentStringMapping(ConcurrentStringPool& shared_pool, const StringPool& segment_pool, Transform&& transform) :
+        shared_pool_(shared_pool),
+        segment_pool_(segment_pool),
+        transform_(std::move(transform)) {
+    }
+
+    StringPool::offset_t get(StringPool::offset_t segment_offset) {
+        if(auto it = mapped_.find(segment_offset); it != mapped_.end())
+            return it->second;
+
+        const auto offset = shared_pool_.get(transform_(segment_pool_.get_const_view(segment_offset)));
+        mapped_.insert_unique(StringPool::offset_t{segment_offset}, StringPool::offset_t{offset});
+        return offset;
+    }
+
+private:
+    ConcurrentStringPool& shared_pool_;
+    const StringPool& segment_pool_;
+    Transform transform_;
+    emilib::HashMap<StringPool::offset_t, StringPool::offset_t> mapped_;
+};
+
+} // namespace arcticdb::pipelines
@@ -80,7 +80,7 @@ SegmentInMemory segment_from_frame(
             auto dest_col = col + agg.descriptor().index().field_count();
             auto &tensor = field_tensors[col];
             aggregator_set_data(type_desc_from_proto(agg.descriptor().field(dest_col).type_desc()), tensor, agg, dest_col, num_rows, offset_in_frame, slice_num_for_column,
-                                num_rows, allow_sparse);
+                                num_rows, allow_sparse, frame.arrow_string_column(col));
         }
 
         agg.end_block_write(num_rows);
@@ -21,6 +21,10 @@
 #include <arcticdb/pipeline/string_pool_utils.hpp>
 #include <arcticdb/util/flatten_utils.hpp>
 
+#include <algorithm>
+#include <array>
+#include <string_view>
+
 namespace arcticdb {
 
 inline size_t get_first_string_size(const pipelines::PipelineContextRow& context_row, ChunkedBuffer &src, std::size_t first_row_in_frame) {
@@ -95,7 +99,8 @@ void aggregator_set_data(
     size_t row,
     size_t slice_num,
     size_t regular_slice_size,
-    bool sparsify_floats
+    bool sparsify_floats,
+    const pipelines::ArrowStringColumn* arrow_strings = nullptr
 ) {
     type_desc.visit_tag([&](auto &&tag) {
         using RawType = typename std::decay_t<decltype(tag)>::DataTypeTag::raw_type;
@@ -115,9 +120,40 @@ void aggregator_set_data(
                 auto char_data = reinterpret_cast<char *>(data) + row * str_stride;
                 auto str_len = tensor.elsize();
 
-                for (size_t s = 0; s < rows_to_write; ++s, char_data += str_stride) {
-                    agg.set_string_at(col, s, char_data, str_len);
+                std::array<std::string_view, StringPool::BatchSize> strings;
+                for (size_t begin = 0; begin < rows_to_write; begin += StringPool::BatchSize) {
+                    const auto count = std::min(rows_to_write - begin, StringPool::BatchSize);
+                    for (size_t s = 0; s < count; ++s, char_data += str_stride)
+                        strings[s] = std::string_view{char_data, str_len};
+
+                    agg.set_strings_at(col, begin, strings.data(), count);
+                }
+            } else if (arrow_strings) {
+                // Runs of valid strings are deduplicated in batches, which are set before any null following them so
+                // that the rows are set in order
+                std::array<std::string_view, StringPool::BatchSize> strings;
+                size_t first_row = 0;
+                size_t count = 0;
+                auto set_strings = [&]() {
+                    if (count != 0)
+                        agg.set_strings_at(col, first_row, strings.data(), count);
+
+                    count = 0;
+                };
+                for (size_t s = 0; s < rows_to_write; ++s) {
+                    if (auto sv = arrow_strings->at(row + s)) {
+                        if (count == 0)
+                            first_row = s;
+
+                        strings[count++] = *sv;
+                        if (count == StringPool::BatchSize)
+                            set_strings();
+                    } else {
+                        set_strings();
+                        agg.set_no_string_at(col, s, not_a_string());
+                    }
                 }
+                set_strings();
             } else {
                 auto data = const_cast<void *>(tensor.data());
                 auto ptr_data = reinterpret_cast<PyObject **>(data);
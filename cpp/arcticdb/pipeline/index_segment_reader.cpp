@@ -6,11 +6,13 @@
  */
 
 #include <arcticdb/util/variant.hpp>
+#include <arcticdb/util/configs_map.hpp>
 #include <arcticdb/python/python_utils.hpp>
 #include <arcticdb/stream/protobuf_mappings.hpp>
 #include <arcticdb/pipeline/index_segment_reader.hpp>
 #include <arcticdb/pipeline/slicing.hpp>
 #include <arcticdb/pipeline/index_fields.hpp>
+#include <arcticdb/pipeline/index_writer.hpp>
 
 using namespace arcticdb::entity;
 using namespace arcticdb::stream;
@@ -19,10 +21,124 @@ using namespace arcticdb::proto::descriptors;
 namespace arcticdb::pipelines::index {
 
 IndexSegmentReader get_index_reader(const AtomKey &prev_index, const std::shared_ptr<Store> &store) {
-    auto [key, seg] = store->read_sync(prev_index);
+    return resolve_index_chain(get_unresolved_index_reader(prev_index, store), prev_index, store);
+}
+
+IndexSegmentReader get_unresolved_index_reader(const AtomKey &index_key, const std::shared_ptr<Store> &store) {
+    auto [key, seg] = store->read_sync(index_key);
     return index::IndexSegmentReader{std::move(seg)};
 }
 
+IndexSegmentReader resolve_index_chain(IndexSegmentReader&& reader, const AtomKey &index_key, const std::shared_ptr<Store> &store) {
+    if (reader.index_chain_depth() == 0)
+        return std::move(reader);
+
+    ARCTICDB_DEBUG(log::version(), "Resolving index chain of depth {} for {}", reader.index_chain_depth(), index_key);
+    std::vector<SliceAndKey> slice_and_keys;
+    for (const auto& slice_and_key : reader) {
+        if (slice_and_key.key().type() == KeyType::TABLE_INDEX) {
+            // The base is resolved, and cached, in turn, so each index in the chain is only read once
+            auto base = get_cached_index_reader(slice_and_key.key(), store);
+            std::copy(base->begin(), base->end(), std::back_inserter(slice_and_keys));
+        } else {
+            slice_and_keys.push_back(slice_and_key);
+        }
+    }
+    std::sort(std::begin(slice_and_keys), std::end(slice_and_keys));
+
+    arcticdb::proto::descriptors::TimeSeriesDescriptor tsd;
+    tsd.CopyFrom(reader.tsd());
+    tsd.clear_index_chain_depth();
+    return util::variant_match(index_type_from_descriptor(tsd.stream_descriptor()), [&] (auto idx) {
+        using IndexType = decltype(idx);
+        IndexWriter<IndexType> writer(nullptr, IndexPartialKey{index_key.id(), index_key.version_id()}, std::move(tsd));
+        for (const auto& slice_and_key : slice_and_keys)
+            writer.add(slice_and_key.key(), slice_and_key.slice_);
+
+        return IndexSegmentReader{writer.commit_segment()};
+    });
+}
+
+IndexSegmentReaderCache& IndexSegmentReaderCache::instance() {
+    static IndexSegmentReaderCache cache;
+    return cache;
+}
+
+namespace {
+
+bool same_owner(const std::weak_ptr<Store>& left, const std::shared_ptr<Store>& right) {
+    return !left.owner_before(right) && !right.owner_before(left);
+}
+
+} // namespace
+
+std::shared_ptr<const IndexSegmentReader> IndexSegmentReaderCache::get(const std::shared_ptr<Store>& store, const AtomKey& key) {
+    std::lock_guard lock(mutex_);
+    auto it = entries_.find(CacheKey{store.get(), key});
+    if (it == entries_.end())
+        return nullptr;
+
+    if (!same_owner(it->second->store_, store)) {
+        erase(it->second);
+        return nullptr;
+    }
+
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->reader_;
+}
+
+void IndexSegmentReaderCache::put(const std::shared_ptr<Store>& store, const AtomKey& key, std::shared_ptr<const IndexSegmentReader> reader) {
+    const auto max_bytes = static_cast<size_t>(ConfigsMap::instance()->get_int("VersionStore.IndexCacheBytes", 64 * 1024 * 1024));
+    const auto bytes = reader->seg().num_bytes();
+    if (max_bytes == 0 || bytes > max_bytes)
+        return;
+
+    std::lock_guard lock(mutex_);
+    CacheKey cache_key{store.get(), key};
+    if (auto it = entries_.find(cache_key); it != entries_.end()) {
+        if (same_owner(it->second->store_, store))
+            return;
+
+        erase(it->second);
+    }
+
+    lru_.push_front(Entry{cache_key, store, std::move(reader), bytes});
+    entries_.try_emplace(std::move(cache_key), lru_.begin());
+    bytes_ += bytes;
+    while (bytes_ > max_bytes)
+        erase(std::prev(lru_.end()));
+}
+
+void IndexSegmentReaderCache::erase(std::list<Entry>::iterator it) {
+    bytes_ -= it->bytes_;
+    entries_.erase(it->key_);
+    lru_.erase(it);
+}
+
+void IndexSegmentReaderCache::clear() {
+    std::lock_guard lock(mutex_);
+    entries_.clear();
+    lru_.clear();
+    bytes_ = 0;
+}
+
+size_t IndexSegmentReaderCache::size() const {
+    std::lock_guard lock(mutex_);
+    return entries_.size();
+}
+
+std::shared_ptr<const IndexSegmentReader> get_cached_index_reader(const AtomKey &index_key, const std::shared_ptr<Store> &store) {
+    auto& cache = IndexSegmentReaderCache::instance();
+    if (auto reader = cache.get(store, index_key)) {
+        ARCTICDB_DEBUG(log::version(), "Using cached index segment for {}", index_key);
+        return reader;
+    }
+
+    auto reader = std::make_shared<const IndexSegmentReader>(get_index_reader(index_key, store));
+    cache.put(store, index_key, reader);
+    return reader;
+}
+
 IndexSegmentReader::IndexSegmentReader(SegmentInMemory&& s) : seg_(std::move(s)) {
     seg_.metadata()->UnpackTo(&tsd_);
     ARCTICDB_DEBUG(log::version(), "Decoded index segment descriptor: {}", tsd_.DebugString());
@@ -12,9 +12,13 @@
 #include <arcticdb/pipeline/frame_slice.hpp>
 #include <arcticdb/pipeline/index_fields.hpp>
 #include <folly/container/F14Map.h>
+#include <folly/hash/Hash.h>
 
 #include <boost/noncopyable.hpp>
 #include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 
 namespace arcticdb {
     class Store;
@@ -60,6 +64,11 @@ struct IndexSegmentReader {
 
     bool bucketize_dynamic() const;
 
+    // Non-zero for an index written by an append that references the previous version's index, see resolve_index_chain
+    size_t index_chain_depth() const {
+        return tsd_.index_chain_depth();
+    }
+
     const arcticdb::proto::descriptors::TimeSeriesDescriptor& tsd() const {
         return tsd_;
     }
@@ -130,6 +139,70 @@ index::IndexSegmentReader get_index_reader(
     const AtomKey &prev_index,
     const std::shared_ptr<Store> &store);
 
+// The index segment as stored, which for a chained index only holds the slices written by its own append
+index::IndexSegmentReader get_unresolved_index_reader(
+    const AtomKey &index_key,
+    const std::shared_ptr<Store> &store);
+
+/*
+ * Appends can write an index that holds only the new slices, plus a row referencing the previous version's index key
+ * in place of the slices that came before. Returns the reader unchanged for an index that isn't chained, otherwise an
+ * in-memory index listing the slices of the whole chain, so that callers see one logical index.
+ */
+index::IndexSegmentReader resolve_index_chain(
+    index::IndexSegmentReader&& reader,
+    const AtomKey &index_key,
+    const std::shared_ptr<Store> &store);
+
+/*
+ * Index keys are immutable, so the decoded index segments of recently read versions are kept, up to
+ * VersionStore.IndexCacheBytes in total, to save the storage read and decode when the same version is read again.
+ * Entries are keyed by the store they were read from as well as the key, as the same key may be held by different
+ * libraries. The readers are shared between callers and must not be modified.
+ */
+class IndexSegmentReaderCache {
+public:
+    static IndexSegmentReaderCache& instance();
+
+    std::shared_ptr<const IndexSegmentReader> get(const std::shared_ptr<Store>& store, const AtomKey& key);
+
+    void put(const std::shared_ptr<Store>& store, const AtomKey& key, std::shared_ptr<const IndexSegmentReader> reader);
+
+    void clear();
+
+    size_t size() const;
+
+private:
+    using CacheKey = std::pair<const Store*, AtomKey>;
+
+    struct CacheKeyHash {
+        size_t operator()(const CacheKey& key) const {
+            return folly::hash::hash_combine(key.first, std::hash<AtomKey>{}(key.second));
+        }
+    };
+
+    struct Entry {
+        CacheKey key_;
+        // Another store may be created at the address of one that has been destroyed, so entries are only served to
+        // the store that owned them
+        std::weak_ptr<Store> store_;
+        std::shared_ptr<const IndexSegmentReader> reader_;
+        size_t bytes_;
+    };
+
+    void erase(std::list<Entry>::iterator it);
+
+    mutable std::mutex mutex_;
+    std::list<Entry> lru_;
+    std::unordered_map<CacheKey, std::list<Entry>::iterator, CacheKeyHash> entries_;
+    size_t bytes_ = 0;
+};
+
+// As get_index_reader, but reads through IndexSegmentReaderCache
+std::shared_ptr<const IndexSegmentReader> get_cached_index_reader(
+    const AtomKey &index_key,
+    const std::shared_ptr<Store> &store);
+
 IndexRange get_index_segment_range(
     const AtomKey &prev_index,
     const std::shared_ptr<Store> &store);
@@ -104,6 +104,14 @@ public:
         return std::move(key_being_committed_);
     }
 
+    // For a writer constructed without a sink, returns the index segment rather than writing it
+    SegmentInMemory commit_segment() {
+        util::check(!sink_, "Index writer with a sink should be committed to storage");
+        agg_.commit();
+        util::check(segment_.has_value(), "Index writer for {} produced no segment", partial_key_.id);
+        return std::move(*segment_);
+    }
+
 private:
     IndexValue segment_start(const SegmentInMemory &segment) const {
         return Index::start_value_for_keys_segment(segment);
@@ -115,6 +123,11 @@ private:
 
     void on_segment(SegmentInMemory &&s) {
         auto seg = std::move(s);
+        if(!sink_) {
+            segment_ = std::move(seg);
+            return;
+        }
+
         auto key_type = key_type_ ? key_type_.value() : get_key_type_for_index_stream(partial_key_.id);
         key_being_committed_ = sink_->write(
             key_type, partial_key_.version_id, partial_key_.id,
@@ -129,6 +142,7 @@ private:
     SliceAggregator agg_;
     std::shared_ptr<stream::StreamSink> sink_;
     folly::Future<arcticdb::entity::AtomKey> key_being_committed_;
+    std::optional<SegmentInMemory> segment_;
     std::optional<std::size_t> current_col_ = std::nullopt;
     std::optional<std::size_t> current_row_ = std::nullopt;
     std::optional<KeyType> key_type_ = std::nullopt;
@@ -14,10 +14,40 @@
 #include <arcticdb/entity/types.hpp>
 #include <arcticdb/util/flatten_utils.hpp>
 
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
 namespace arcticdb::pipelines {
 
 using namespace arcticdb::entity;
 
+// A string column imported through the Arrow C data interface, whose strings are read from its offsets and data
+// buffers rather than from Python objects
+struct ArrowStringColumn {
+    const uint8_t* validity_ = nullptr;
+    const void* offsets_ = nullptr;
+    const char* data_ = nullptr;
+    int64_t offset_ = 0;
+    bool large_offsets_ = false;
+
+    [[nodiscard]] std::optional<std::string_view> at(size_t row) const {
+        const auto pos = static_cast<size_t>(offset_) + row;
+        if (validity_ && !(validity_[pos / 8] & (1u << (pos % 8))))
+            return std::nullopt;
+
+        int64_t begin, end;
+        if (large_offsets_) {
+            begin = static_cast<const int64_t*>(offsets_)[pos];
+            end = static_cast<const int64_t*>(offsets_)[pos + 1];
+        } else {
+            begin = static_cast<const int32_t*>(offsets_)[pos];
+            end = static_cast<const int32_t*>(offsets_)[pos + 1];
+        }
+        return std::string_view{data_ + begin, static_cast<size_t>(end - begin)};
+    }
+};
+
 struct InputTensorFrame {
 
     template<class T>
@@ -39,6 +69,11 @@ struct InputTensorFrame {
     ssize_t num_rows = 0;
     mutable ssize_t offset = 0;
     mutable bool bucketize_dynamic = 0;
+    // String columns of frames imported through the Arrow C data interface, by position in field_tensors
+    std::unordered_map<size_t, ArrowStringColumn> arrow_strings;
+    // Buffers converted on import from Arrow, which tensors point into. Those used as they are belong to the caller,
+    // as numpy arrays do
+    std::shared_ptr<std::vector<std::vector<uint64_t>>> arrow_converted_buffers;
 
     void set_offset(ssize_t off) const {
         offset = off;
@@ -54,6 +89,11 @@ struct InputTensorFrame {
 
     bool has_index() const { return desc.index().field_count() != 0ULL; }
 
+    const ArrowStringColumn* arrow_string_column(size_t field_col) const {
+        const auto it = arrow_strings.find(field_col);
+        return it == arrow_strings.end() ? nullptr : &it->second;
+    }
+
     void set_index_range() {
             // Fill index range
             // Note RowCountIndex will normally have an index field count of 0
@@ -51,15 +51,28 @@ struct ReadQuery {
     std::variant<std::monostate, HeadRange, TailRange, SignedRowRange> row_range;
     FilterRange row_filter; // no filter by default
     std::shared_ptr<std::vector<Clause>> query_ = std::make_shared<std::vector<Clause>>();
+    std::optional<RowLimit> row_limit_; // applied to the output of query_
+    std::vector<std::shared_ptr<JoinInput>> join_inputs_; // other symbols joined by clauses in query_
 
     void set_clause_builder(ClauseBuilder& builder) {
         ClauseBuilder b = std::move(builder);
         for (auto&& c: b.get_clauses()) {
             query_->emplace_back(std::move(c));
         }
+        row_limit_ = b.get_row_limit();
+        join_inputs_ = b.get_join_inputs();
     }
 
     void calculate_row_filter(int64_t total_rows) {
+        if (query_->empty() && row_limit_ && std::holds_alternative<std::monostate>(row_range)) {
+            // With nothing to filter out, a row limit is just a row range on the stored data
+            const auto num_rows = static_cast<int64_t>(row_limit_->num_rows_);
+            if (row_limit_->from_end_)
+                row_range = TailRange{num_rows};
+            else
+                row_range = HeadRange{num_rows};
+            row_limit_.reset();
+        }
         util::variant_match(row_range,
             [&](const HeadRange &head_range) {
             if (head_range.num_rows_ >= 0) {
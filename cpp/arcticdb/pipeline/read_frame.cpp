@@ -22,12 +22,20 @@
 #include <arcticdb/storage/store.hpp>
 #include <arcticdb/stream/index.hpp>
 #include <arcticdb/pipeline/column_mapping.hpp>
+#include <arcticdb/pipeline/concurrent_string_pool.hpp>
 #include <arcticdb/util/third_party/emilib_map.hpp>
+#include <arcticdb/util/huge_page_allocator.hpp>
+#include <arcticdb/util/file_mapped_allocator.hpp>
 
 #include <google/protobuf/util/message_differencer.h>
 #include <folly/SpinLock.h>
 #include <folly/gen/Base.h>
 
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
+#include <tuple>
+
 namespace arcticdb::pipelines {
 
 /*
@@ -66,11 +74,62 @@ StreamDescriptor get_filtered_descriptor(const std::shared_ptr<PipelineContext>&
     return get_filtered_descriptor(context->descriptor(), context->filter_columns_);
 }
 
-SegmentInMemory allocate_frame(const std::shared_ptr<PipelineContext>& context) {
+namespace {
+
+// Faults in a frame's huge page blocks while its segments are being fetched, so that decoding writes into memory
+// that is already mapped. The blocks are found when the frame is allocated rather than here, as the frame's columns
+// may have had their buffers replaced by the time this runs, and blocks freed since then are skipped
+struct PrefaultFrameTask : async::BaseTask {
+    std::vector<const uint8_t*> blocks_;
+
+    explicit PrefaultFrameTask(std::vector<const uint8_t*>&& blocks) :
+        blocks_(std::move(blocks)) {
+    }
+
+    ARCTICDB_MOVE_ONLY_DEFAULT(PrefaultFrameTask)
+
+    folly::Unit operator()() {
+        ARCTICDB_SAMPLE_DEFAULT(PrefaultFrame)
+        for(auto block : blocks_)
+            HugePageAllocator::prefault(block);
+
+        return folly::Unit{};
+    }
+};
+
+std::vector<const uint8_t*> large_frame_blocks(const SegmentInMemory& frame) {
+    std::vector<const uint8_t*> output;
+    for(size_t c = 0; c < frame.num_columns(); ++c) {
+        for(auto block : frame.column(static_cast<position_t>(c)).data().buffer().blocks()) {
+            if(MemBlock::alloc_size(block->capacity()) >= HugePageAllocator::HugePageSize)
+                output.push_back(reinterpret_cast<const uint8_t*>(block));
+        }
+    }
+    return output;
+}
+
+} // namespace
+
+SegmentInMemory allocate_frame(const std::shared_ptr<PipelineContext>& context, const ReadOptions& read_options) {
     ARCTICDB_SAMPLE_DEFAULT(AllocFrame)
     auto [offset, row_count] = offset_and_row_count(context);
     ARCTICDB_DEBUG(log::version(), "Allocated frame with offset {} and row count {}", offset, row_count);
+    // Large columns are mapped from files in the output directory when one is given, so that the frame can be larger
+    // than memory, or otherwise to huge pages when configured. Prefaulting would defeat the point of the former
+    const auto& mmap_dir = read_options.get_output_mmap_dir();
+    const auto huge_page_mode = mmap_dir ? HugePageMode::DISABLED : HugePageAllocator::frame_mode();
+    std::optional<ScopedFileMappedAllocation> file_mapped;
+    std::optional<ScopedHugePageAllocation> huge_pages;
+    if(mmap_dir) {
+        util::check_arg(std::filesystem::is_directory(*mmap_dir), "Output mmap directory {} does not exist", *mmap_dir);
+        file_mapped.emplace(*mmap_dir);
+    } else if(huge_page_mode != HugePageMode::DISABLED) {
+        huge_pages.emplace(huge_page_mode);
+    }
+
     SegmentInMemory output{get_filtered_descriptor(context),  row_count, true};
+    file_mapped.reset();
+    huge_pages.reset();
     output.set_offset(static_cast<position_t>(offset));
     output.set_row_data(static_cast<ssize_t>(row_count - 1));
     output.init_column_map();
@@ -87,6 +146,12 @@ SegmentInMemory allocate_frame(const std::shared_ptr<PipelineContext>& context)
         }
     }
 
+    if(huge_page_mode != HugePageMode::DISABLED && HugePageAllocator::prefault_frames()) {
+        // Not waited on, as decoding is correct whether or not the pages have been faulted in yet
+        if(auto blocks = large_frame_blocks(output); !blocks.empty())
+            std::ignore = async::submit_io_task(PrefaultFrameTask{std::move(blocks)});
+    }
+
     return output;
 }
 
@@ -160,6 +225,14 @@ void decode_or_expand(
     std::shared_ptr<BufferHolder> buffers) {
     if(auto handler = TypeHandlerRegistry::instance()->get_handler(type_descriptor.data_type()); handler) {
         handler->handle_type(data, dest, encoded_field_info, type_descriptor, dest_bytes, buffers);
+    } else if (encoded_field_info.has_ndarray() && encoded_field_info.ndarray().values_size() == 0 && encoded_field_info.ndarray().shapes_size() == 0) {
+        // A slice of a sparse column with no values is written with neither values nor a sparse map, so its rows are
+        // all null and there is nothing to decode
+        type_descriptor.visit_tag([dest, dest_bytes](const auto tdt) {
+            using TagType = decltype(tdt);
+            util::default_initialize<TagType>(dest, dest_bytes);
+        });
+        data += encoding_size::compressed_size(encoded_field_info.ndarray());
     } else {
         std::optional<util::BitMagic> bv;
         if (encoded_field_info.has_ndarray() && encoded_field_info.ndarray().sparse_map_bytes() > 0) {
@@ -599,6 +672,83 @@ public:
     }
 };
 
+// Fixed width unicode strings are held as numpy holds them, in UTF-32 padded with nulls
+std::string utf32_to_utf8(std::string_view sv) {
+    std::string output;
+    output.reserve(sv.size() / UNICODE_WIDTH);
+    for (size_t pos = 0; pos + UNICODE_WIDTH <= sv.size(); pos += UNICODE_WIDTH) {
+        uint32_t code_point;
+        memcpy(&code_point, sv.data() + pos, sizeof(code_point));
+        if (code_point == 0) {
+            break;
+        } else if (code_point < 0x80) {
+            output.push_back(static_cast<char>(code_point));
+        } else if (code_point < 0x800) {
+            output.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+            output.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        } else if (code_point < 0x10000) {
+            output.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+            output.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        } else {
+            output.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+            output.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        }
+    }
+    return output;
+}
+
+/*
+ * Arrow output creates no Python objects, so string columns are left as offsets rather than reduced, but the offsets
+ * are moved into the frame's own string pool, as those of the slices don't outlive the read. Fixed width strings are
+ * converted to UTF-8 or have their padding removed on the way, so that every string in the column can be exported as
+ * it is. Columns are reduced in parallel into a pool shared through a ConcurrentStringPool, and each slice maps its own
+ * offsets so that a string is only hashed the first time it is seen in the slice.
+ */
+class ArrowStringReducer {
+    SegmentInMemory frame_;
+    ChunkedBuffer& buffer_;
+    ConcurrentStringPool& shared_pool_;
+    size_t row_ = 0;
+
+public:
+    ArrowStringReducer(Column& column, SegmentInMemory frame, ConcurrentStringPool& shared_pool) :
+        frame_(std::move(frame)),
+        buffer_(column.data().buffer()),
+        shared_pool_(shared_pool) {
+    }
+
+    void reduce(PipelineContextRow& context_row, size_t column_index) {
+        const auto segment_type = data_type_from_proto(context_row.descriptor()[column_index].type_desc());
+        const auto& string_pool = context_row.string_pool();
+        size_t end = context_row.slice_and_key().slice_.row_range.second - frame_.offset();
+        if (&string_pool == &frame_.string_pool() && !is_fixed_string_type(segment_type)) {
+            row_ = end;
+            return;
+        }
+
+        SegmentStringMapping mapping{shared_pool_, string_pool, [segment_type] (std::string_view sv) {
+            if (segment_type == DataType::UTF_FIXED64)
+                return utf32_to_utf8(sv);
+            else if (is_fixed_string_type(segment_type))
+                return std::string{sv.substr(0, sv.find('\0'))};
+            else
+                return std::string{sv};
+        }};
+        for (; row_ < end; ++row_) {
+            const auto offset = get_offset_string_at(row_, buffer_);
+            if (offset != not_a_string() && offset != nan_placeholder())
+                set_offset_string_at(row_, buffer_, mapping.get(offset));
+        }
+    }
+
+    void finalize() {
+        for (; row_ < frame_.row_count(); ++row_)
+            set_offset_string_at(row_, buffer_, not_a_string());
+    }
+};
 
 namespace {
 
@@ -621,37 +771,166 @@ inline PyStringConstructor get_string_constructor(bool has_type_conversion, bool
         return PyStringConstructor::Bytes_FromStringAndSize;
     }
 }
+
+struct UnicodeFromUnicodeCreator {
+    static PyObject* create(std::string_view sv, bool) {
+        const auto actual_length = std::min(sv.size() / UNICODE_WIDTH, wcslen(reinterpret_cast<const wchar_t *>(sv.data())));
+        return PyUnicode_FromKindAndData(PyUnicode_4BYTE_KIND, reinterpret_cast<const UnicodeType*>(sv.data()), actual_length);
+    }
+};
+
+struct UnicodeFromStringAndSizeCreator {
+    static PyObject* create(std::string_view sv, bool) {
+        const auto actual_length = sv.size();
+        return PyUnicode_FromStringAndSize(sv.data(), actual_length);
+    }
+};
+
+struct BytesFromStringAndSizeCreator {
+    static PyObject* create(std::string_view sv, bool has_type_conversion) {
+        const auto actual_length = has_type_conversion ? std::min(sv.size(), strlen(sv.data())) : sv.size();
+        return PYBIND11_BYTES_FROM_STRING_AND_SIZE(sv.data(), actual_length);
+    }
+};
+
+PyObject* create_py_string(PyStringConstructor string_constructor, std::string_view sv, bool has_type_conversion) {
+    switch(string_constructor) {
+    case PyStringConstructor::Unicode_FromUnicode:
+        return UnicodeFromUnicodeCreator::create(sv, has_type_conversion);
+    case PyStringConstructor::Unicode_FromStringAndSize:
+        return UnicodeFromStringAndSizeCreator::create(sv, has_type_conversion);
+    case PyStringConstructor::Bytes_FromStringAndSize:
+        return BytesFromStringAndSizeCreator::create(sv, has_type_conversion);
+    }
+    util::raise_rte("Unknown string constructor");
+    return nullptr;  // unreachable
+}
+
+void add_references(PyObject* obj, size_t count) {
+    for(auto i = 0u; i < count; ++i)
+        Py_INCREF(obj);
+}
+
+// Serialises the creation of Python objects by the parallel string reduction. That only runs on the thread that called
+// the read, never on the scheduler's threads, but reads from several Python threads release the GIL and can get here
+// at the same time
+std::mutex& python_object_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
 }
 
 using UniqueStringMapType = folly::ConcurrentHashMap<std::string_view, PyObject*>;
 
+/*
+ * Python objects can only be created, and their reference counts changed, by one thread at a time, so when string
+ * columns are reduced in parallel the dynamic string reducers don't create them. Each column instead writes, for
+ * every row, the slot of the distinct string it holds, and counts the rows of each slot. The objects are then created
+ * together on one thread, each taking all of its references at once, after which the slots in the column are replaced
+ * by the objects without touching any Python state.
+ */
+class PendingPyStrings {
+public:
+    static constexpr uintptr_t NONE_SLOT = 0;
+    static constexpr uintptr_t NAN_SLOT = 1;
+
+    explicit PendingPyStrings(bool dedup_by_value) :
+        dedup_by_value_(dedup_by_value),
+        counts_(2, 0) {
+    }
+
+    uintptr_t add(std::string_view sv, PyStringConstructor string_constructor, bool has_type_conversion) {
+        if(dedup_by_value_) {
+            if(auto it = slot_by_value_.find(sv); it != slot_by_value_.end())
+                return it->second;
+        }
+
+        const auto slot = static_cast<uintptr_t>(counts_.size());
+        strings_.emplace_back(PendingString{sv, string_constructor, has_type_conversion});
+        counts_.push_back(0);
+        if(dedup_by_value_)
+            slot_by_value_.insert(sv, slot);
+
+        return slot;
+    }
+
+    void count(uintptr_t slot) {
+        ++counts_[slot];
+    }
+
+    // Must be called by one thread at a time, see python_object_mutex
+    void create(PyObject* none, PyObject* py_nan, UniqueStringMapType* unique_string_map) {
+        objects_.resize(counts_.size());
+        objects_[NONE_SLOT] = none;
+        add_references(none, counts_[NONE_SLOT]);
+        objects_[NAN_SLOT] = py_nan;
+        add_references(py_nan, counts_[NAN_SLOT]);
+
+        for(auto i = 0u; i < strings_.size(); ++i) {
+            const auto& pending = strings_[i];
+            const auto slot = i + 2;
+            if(unique_string_map) {
+                if(auto it = unique_string_map->find(pending.sv_); it != unique_string_map->end()) {
+                    objects_[slot] = it->second;
+                    add_references(it->second, counts_[slot]);
+                    continue;
+                }
+            }
+            auto obj = create_py_string(pending.string_constructor_, pending.sv_, pending.has_type_conversion_);
+            util::check(obj != nullptr, "Failed to create Python string from {} bytes", pending.sv_.size());
+            add_references(obj, counts_[slot] - 1);
+            objects_[slot] = obj;
+            if(unique_string_map)
+                unique_string_map->emplace(pending.sv_, obj);
+        }
+    }
+
+    void fill(PyObject** ptr_dest, size_t rows) const {
+        for(auto row = 0u; row < rows; ++row, ++ptr_dest)
+            *ptr_dest = objects_[reinterpret_cast<uintptr_t>(*ptr_dest)];
+    }
+
+private:
+    struct PendingString {
+        std::string_view sv_;
+        PyStringConstructor string_constructor_;
+        bool has_type_conversion_;
+    };
+
+    bool dedup_by_value_;
+    std::vector<PendingString> strings_;
+    std::vector<size_t> counts_;
+    emilib::HashMap<std::string_view, uintptr_t> slot_by_value_;
+    std::vector<PyObject*> objects_;
+};
+
 class DynamicStringReducer : public StringReducer {
     PyObject** ptr_dest_;
     std::shared_ptr<UniqueStringMapType> unique_string_map_;
     std::shared_ptr<PyObject> py_nan_;
     std::shared_ptr<LockType> lock_;
     bool do_lock_ = false;
+    std::shared_ptr<PendingPyStrings> pending_;
 
-    struct UnicodeFromUnicodeCreator {
-        static PyObject* create(std::string_view sv, bool) {
-            const auto actual_length = std::min(sv.size() / UNICODE_WIDTH, wcslen(reinterpret_cast<const wchar_t *>(sv.data())));
-            return PyUnicode_FromKindAndData(PyUnicode_4BYTE_KIND, reinterpret_cast<const UnicodeType*>(sv.data()), actual_length);
-        }
-    };
-
-    struct UnicodeFromStringAndSizeCreator {
-        static PyObject* create(std::string_view sv, bool) {
-            const auto actual_length = sv.size();
-            return PyUnicode_FromStringAndSize(sv.data(), actual_length);
-        }
-    };
-
-    struct BytesFromStringAndSizeCreator {
-        static PyObject* create(std::string_view sv, bool has_type_conversion) {
-            const auto actual_length = has_type_conversion ? std::min(sv.size(), strlen(sv.data())) : sv.size();
-            return PYBIND11_BYTES_FROM_STRING_AND_SIZE(sv.data(), actual_length);
+    void record_strings(size_t end, const StringPool::offset_t* ptr_src, PyStringConstructor string_constructor, bool has_type_conversion, const StringPool& string_pool) {
+        emilib::HashMap<StringPool::offset_t, uintptr_t> local_map;
+        for (; row_ < end; ++row_, ++ptr_src, ++ptr_dest_) {
+            auto offset = *ptr_src;
+            uintptr_t slot;
+            if(offset == not_a_string()) {
+                slot = PendingPyStrings::NONE_SLOT;
+            } else if (offset == nan_placeholder()) {
+                slot = PendingPyStrings::NAN_SLOT;
+            } else if (auto it = local_map.find(offset); it != local_map.end()) {
+                slot = it->second;
+            } else {
+                slot = pending_->add(get_string_from_pool(offset, string_pool), string_constructor, has_type_conversion);
+                local_map.insert_unique(std::move(offset), uintptr_t{slot});
+            }
+            pending_->count(slot);
+            *ptr_dest_ = reinterpret_cast<PyObject*>(slot);
         }
-    };
+    }
 
     template<typename StringCreator, typename LockPolicy>
     void assign_strings_shared(size_t end, const StringPool::offset_t* ptr_src, bool has_type_conversion, const StringPool& string_pool) {
@@ -659,6 +938,8 @@ class DynamicStringReducer : public StringReducer {
         auto none = std::make_unique<py::none>(py::none{});
         LockPolicy::unlock(*lock_);
         size_t none_count = 0u;
+        // The shared map is keyed by value, so only the first row of each distinct offset in the slice is hashed by it
+        emilib::HashMap<StringPool::offset_t, PyObject*> local_map;
         for (; row_ < end; ++row_, ++ptr_src, ++ptr_dest_) {
             auto offset = *ptr_src;
             if(offset == not_a_string()) {
@@ -667,6 +948,11 @@ class DynamicStringReducer : public StringReducer {
             } else if (offset == nan_placeholder()) {
                 *ptr_dest_ = py_nan_.get();
                 Py_INCREF(py_nan_.get());
+            } else if (auto local = local_map.find(offset); local != local_map.end()) {
+                *ptr_dest_ = local->second;
+                LockPolicy::lock(*lock_);
+                Py_INCREF(*ptr_dest_);
+                LockPolicy::unlock(*lock_);
             } else {
                 const auto sv = get_string_from_pool(offset, string_pool);
                 if (auto it = unique_string_map_->find(sv); it != unique_string_map_->end()) {
@@ -681,6 +967,8 @@ class DynamicStringReducer : public StringReducer {
                     LockPolicy::unlock(*lock_);
                     unique_string_map_->emplace(sv, *ptr_dest_);
                 }
+                PyObject* dest = *ptr_dest_;
+                local_map.insert_unique(std::move(offset), std::move(dest));
             }
         }
         LockPolicy::lock(*lock_);
@@ -699,7 +987,6 @@ class DynamicStringReducer : public StringReducer {
         LockPolicy::unlock(*lock_);
         size_t none_count = 0u;
         emilib::HashMap<StringPool::offset_t, std::pair<PyObject*, folly::SpinLock>> local_map;
-        local_map.reserve(end - row_);
         // TODO this is no good for non-contigous blocks, but we currently expect
         // output data to be contiguous
         for (; row_ < end; ++row_, ++ptr_src, ++ptr_dest_) {
@@ -776,13 +1063,15 @@ public:
         std::shared_ptr<UniqueStringMapType> unique_string_map,
         std::shared_ptr<PyObject> py_nan,
         std::shared_ptr<LockType> lock,
-        bool do_lock) :
+        bool do_lock,
+        std::shared_ptr<PendingPyStrings> pending) :
         StringReducer(column, context, std::move(frame), frame_field, sizeof(StringPool::offset_t)),
         ptr_dest_(reinterpret_cast<PyObject**>(dst_)),
         unique_string_map_(std::move(unique_string_map)),
         py_nan_(py_nan),
         lock_(std::move(lock)),
-        do_lock_(do_lock) {
+        do_lock_(do_lock),
+        pending_(std::move(pending)) {
             if(!py_nan_)
                 py_nan_ = std::shared_ptr<PyObject>(create_py_nan(lock_),[lock=lock_](PyObject* py_obj) {
                     lock->lock();
@@ -821,7 +1110,9 @@ public:
         size_t end =  context_row.slice_and_key().slice_.row_range.second - frame_.offset();
 
         auto ptr_src = get_offset_ptr_at(row_, src_buffer_);
-        if(do_lock_)
+        if(pending_)
+            record_strings(end, ptr_src, get_string_constructor(has_type_conversion, is_utf), has_type_conversion, context_row.string_pool());
+        else if(do_lock_)
             process_string_views<LockActive>(has_type_conversion, is_utf, end, ptr_src, context_row.string_pool());
         else
             process_string_views<LockDisabled>(has_type_conversion, is_utf, end, ptr_src, context_row.string_pool());
@@ -829,7 +1120,12 @@ public:
 
     void finalize() override {
         auto total_rows = frame_.row_count();
-        if(row_!= total_rows) {
+        if(row_ != total_rows && pending_) {
+            for(; row_ < total_rows; ++row_, ++ptr_dest_) {
+                pending_->count(PendingPyStrings::NONE_SLOT);
+                *ptr_dest_ = reinterpret_cast<PyObject*>(PendingPyStrings::NONE_SLOT);
+            }
+        } else if(row_!= total_rows) {
             auto none = py::none{};
             const auto diff = total_rows - row_;
             for(; row_ < total_rows; ++row_, ++ptr_dest_) {
@@ -860,7 +1156,8 @@ std::unique_ptr<StringReducer> get_string_reducer(
     std::shared_ptr<UniqueStringMapType>& unique_string_map,
     std::shared_ptr<PyObject> py_nan,
     std::shared_ptr<LockType>& spinlock,
-    bool do_lock
+    bool do_lock,
+    const std::shared_ptr<PendingPyStrings>& pending
     ) {
     const auto& field_type = data_type_from_proto(frame_field.type_desc());
     std::unique_ptr<StringReducer> string_reducer;
@@ -874,7 +1171,7 @@ std::unique_ptr<StringReducer> get_string_reducer(
             string_reducer = std::make_unique<FixedStringReducer>(column, context, frame, frame_field, alloc_width);
         }
     } else {
-        string_reducer = std::make_unique<DynamicStringReducer>(column, context, frame, frame_field, unique_string_map, py_nan, spinlock, do_lock);
+        string_reducer = std::make_unique<DynamicStringReducer>(column, context, frame, frame_field, unique_string_map, py_nan, spinlock, do_lock, pending);
     }
     return string_reducer;
 }
@@ -889,6 +1186,8 @@ struct ReduceColumnTask : async::BaseTask {
     std::shared_ptr<LockType> lock_;
     bool dynamic_schema_;
     bool do_lock_;
+    std::shared_ptr<PendingPyStrings> pending_;
+    std::shared_ptr<ConcurrentStringPool> arrow_string_pool_;
 
     ReduceColumnTask(
         const SegmentInMemory& frame,
@@ -899,7 +1198,9 @@ struct ReduceColumnTask : async::BaseTask {
         std::shared_ptr<PyObject> py_nan,
         std::shared_ptr<LockType> lock,
         bool dynamic_schema,
-        bool do_lock) :
+        bool do_lock,
+        std::shared_ptr<PendingPyStrings> pending = nullptr,
+        std::shared_ptr<ConcurrentStringPool> arrow_string_pool = nullptr) :
         frame_(frame),
         column_index_(c),
         slice_map_(std::move(slice_map)),
@@ -908,7 +1209,9 @@ struct ReduceColumnTask : async::BaseTask {
         py_nan_(py_nan),
         lock_(std::move(lock)),
         dynamic_schema_(dynamic_schema),
-        do_lock_(do_lock) {
+        do_lock_(do_lock),
+        pending_(std::move(pending)),
+        arrow_string_pool_(std::move(arrow_string_pool)) {
     }
 
     folly::Unit operator()() {
@@ -918,11 +1221,15 @@ struct ReduceColumnTask : async::BaseTask {
 
         const auto column_data = slice_map_->columns_.find(frame_field.name());
         if(dynamic_schema_ && column_data == slice_map_->columns_.end()) {
-            column.default_initialize_rows(0, frame_.row_count(), false);
-            bool dynamic_type = is_dynamic_string_type(field_type);
-            if(dynamic_type) {
-                EmptyDynamicStringReducer reducer(column, frame_, frame_field, sizeof(StringPool::offset_t), lock_);
-                reducer.reduce(frame_.row_count());
+            if(arrow_string_pool_) {
+                // Arrow output exports the nulls from the sparse map, so the column's values are never touched
+                column.mark_all_null(frame_.row_count());
+            } else {
+                column.default_initialize_rows(0, frame_.row_count(), false);
+                if(is_dynamic_string_type(field_type)) {
+                    EmptyDynamicStringReducer reducer(column, frame_, frame_field, sizeof(StringPool::offset_t), lock_);
+                    reducer.reduce(frame_.row_count());
+                }
             }
         } else {
             if(dynamic_schema_) {
@@ -933,8 +1240,16 @@ struct ReduceColumnTask : async::BaseTask {
                 }
                 null_reducer.finalize();
             }
-            if (is_sequence_type(field_type)) {
-                auto string_reducer = get_string_reducer(column, context_, frame_, frame_field, *slice_map_, unique_string_map_, py_nan_, lock_, do_lock_);
+            if (is_sequence_type(field_type) && arrow_string_pool_) {
+                ArrowStringReducer string_reducer{column, frame_, *arrow_string_pool_};
+                for (const auto &row : column_data->second) {
+                    PipelineContextRow context_row{context_, row.second.context_index_};
+                    if(context_row.slice_and_key().slice().row_range.diff() > 0)
+                        string_reducer.reduce(context_row, row.second.column_index_);
+                }
+                string_reducer.finalize();
+            } else if (is_sequence_type(field_type)) {
+                auto string_reducer = get_string_reducer(column, context_, frame_, frame_field, *slice_map_, unique_string_map_, py_nan_, lock_, do_lock_, pending_);
                 for (const auto &row : column_data->second) {
                     PipelineContextRow context_row{context_, row.second.context_index_};
                     if(context_row.slice_and_key().slice().row_range.diff() > 0)
@@ -960,6 +1275,28 @@ void reduce_and_fix_columns(
     bool dynamic_schema = opt_false(read_options.dynamic_schema_);
     auto slice_map = std::make_shared<FrameSliceMap>(context, dynamic_schema);
     auto spinlock = std::make_shared<LockType>();
+    if (opt_false(read_options.arrow_output_)) {
+        ARCTICDB_DEBUG(log::version(), "Moving strings to the frame's string pool for arrow output");
+        auto string_pool = std::make_shared<ConcurrentStringPool>(frame.string_pool());
+        // A slice can only be read from while other columns add to the frame's pool if it has a pool of its own. As
+        // for Python strings, columns are reduced serially on the scheduler's threads rather than blocking on tasks
+        const bool shares_frame_pool = std::any_of(context->begin(), context->end(), [&frame] (auto& row) {
+            return row.has_string_pool() && &row.string_pool() == &frame.string_pool();
+        });
+        const bool serial = shares_frame_pool || async::is_scheduler_thread();
+        std::vector<folly::Future<folly::Unit>> jobs;
+        for (size_t c = 0; c < static_cast<size_t>(frame.descriptor().fields().size()); ++c) {
+            ReduceColumnTask task{frame, c, slice_map, context, {}, {}, spinlock, dynamic_schema, false, nullptr, string_pool};
+            if (serial)
+                task();
+            else
+                jobs.emplace_back(async::submit_cpu_task(std::move(task)));
+        }
+        folly::collect(jobs).get();
+        ARCTICDB_DEBUG(log::version(), "Found {} unique strings for arrow output", string_pool->size());
+        return;
+    }
+
     std::shared_ptr<UniqueStringMapType> unique_string_map;
     std::shared_ptr<PyObject> py_nan;
 
@@ -974,20 +1311,65 @@ void reduce_and_fix_columns(
         ARCTICDB_DEBUG(log::version(), "Not optimising dynamic string memory consumption");
     }
 
-    constexpr bool parallel_strings = false;
+    const auto num_columns = static_cast<size_t>(frame.descriptor().fields().size());
+    // Blocks on the column tasks, so is serial when run as a continuation on one of the scheduler's threads, which
+    // also means that Python objects are only ever created by the calling thread when parallel
+    const bool parallel_strings = ConfigsMap::instance()->get_int("StringAllocation.Parallel", 1) == 1 && num_columns > 1
+        && !async::is_scheduler_thread();
     if(parallel_strings) {
+        if(!py_nan)
+            py_nan = std::shared_ptr<PyObject>(create_py_nan(spinlock),[lock=spinlock](PyObject* py_obj) {
+                lock->lock();
+                Py_DECREF(py_obj);
+                lock->unlock(); });
+
+        // Columns missing from every slice are filled with None or NaN directly, so are reduced with the objects created
+        std::vector<std::shared_ptr<PendingPyStrings>> pending(num_columns);
+        std::vector<size_t> missing_columns;
         std::vector<folly::Future<folly::Unit>> jobs;
-        const auto batch_size = ConfigsMap::instance()->get_int("StringAllocation.BatchSize", 50);
-        for (size_t c = 0; c < static_cast<size_t>(frame.descriptor().fields().size()); ++c) {
-            jobs.emplace_back(async::submit_cpu_task(ReduceColumnTask(frame, c, slice_map, context, unique_string_map, py_nan, spinlock, dynamic_schema, true)));
-            if(jobs.size() == static_cast<size_t>(batch_size)) {
+        const auto batch_size = static_cast<size_t>(ConfigsMap::instance()->get_int("StringAllocation.BatchSize", 50));
+        auto collect_jobs = [&jobs, batch_size] (bool all) {
+            if(jobs.size() == batch_size || (all && !jobs.empty())) {
                 folly::collect(jobs).get();
                 jobs.clear();
             }
+        };
+        for (size_t c = 0; c < num_columns; ++c) {
+            const auto& frame_field = frame.field(c);
+            if(dynamic_schema && slice_map->columns_.find(frame_field.name()) == slice_map->columns_.end()) {
+                missing_columns.push_back(c);
+                continue;
+            }
+            if(is_dynamic_string_type(data_type_from_proto(frame_field.type_desc())))
+                pending[c] = std::make_shared<PendingPyStrings>(static_cast<bool>(unique_string_map));
+
+            jobs.emplace_back(async::submit_cpu_task(ReduceColumnTask(frame, c, slice_map, context, unique_string_map, py_nan, spinlock, dynamic_schema, false, pending[c])));
+            collect_jobs(false);
+        }
+        collect_jobs(true);
+
+        {
+            std::lock_guard lock{python_object_mutex()};
+            auto none = py::none{};
+            for(const auto& column_strings : pending) {
+                if(column_strings)
+                    column_strings->create(none.ptr(), py_nan.get(), unique_string_map.get());
+            }
+            for(auto c : missing_columns)
+                ReduceColumnTask(frame, c, slice_map, context, unique_string_map, py_nan, spinlock, dynamic_schema, false)();
         }
 
-        if(!jobs.empty())
-            folly::collect(jobs).get();
+        for (size_t c = 0; c < num_columns; ++c) {
+            if(!pending[c])
+                continue;
+
+            jobs.emplace_back(async::submit_cpu_task([column_strings=pending[c], ptr_dest=reinterpret_cast<PyObject**>(frame.column(static_cast<position_t>(c)).data().buffer().data()), rows=frame.row_count()] () {
+                column_strings->fill(ptr_dest, rows);
+                return folly::Unit{};
+            }));
+            collect_jobs(false);
+        }
+        collect_jobs(true);
     } else {
         for (size_t c = 0; c < static_cast<size_t>(frame.descriptor().fields().size()); ++c) {
             ReduceColumnTask(frame, c, slice_map, context, unique_string_map, py_nan, spinlock, dynamic_schema, false)();
@@ -21,7 +21,7 @@
 
 namespace arcticdb::pipelines {
 
-SegmentInMemory allocate_frame(const std::shared_ptr<PipelineContext>& context);
+SegmentInMemory allocate_frame(const std::shared_ptr<PipelineContext>& context, const ReadOptions& read_options);
 
 template <typename KeySliceContainer>
 std::optional<util::BitSet> check_and_mark_slices(
@@ -10,6 +10,8 @@
 #include <arcticdb/entity/protobufs.hpp>
 #include <arcticdb/util/optional_defaults.hpp>
 
+#include <string>
+
 namespace arcticdb {
 struct ReadOptions {
     std::optional<bool> force_strings_to_fixed_;
@@ -19,6 +21,8 @@ struct ReadOptions {
     std::optional<bool> allow_sparse_;
     std::optional<bool> set_tz_;
     std::optional<bool> optimise_string_memory_;
+    std::optional<bool> arrow_output_;
+    std::optional<std::string> output_mmap_dir_;
 
     void set_force_strings_to_fixed(const std::optional<bool>& force_strings_to_fixed) {
         force_strings_to_fixed_ = force_strings_to_fixed;
@@ -51,5 +55,22 @@ struct ReadOptions {
     void set_optimise_string_memory(const std::optional<bool>& optimise_string_memory) {
         optimise_string_memory_ = optimise_string_memory;
     }
+
+    void set_arrow_output(const std::optional<bool>& arrow_output) {
+        arrow_output_ = arrow_output;
+    }
+
+    bool get_arrow_output() const {
+        return opt_false(arrow_output_);
+    }
+
+    // Directory in which the columns of the output frame are mapped from files, so that it can be larger than memory
+    void set_output_mmap_dir(const std::optional<std::string>& output_mmap_dir) {
+        output_mmap_dir_ = output_mmap_dir;
+    }
+
+    const std::optional<std::string>& get_output_mmap_dir() const {
+        return output_mmap_dir_;
+    }
 };
 } //namespace arcticdb
\ No newline at end of file
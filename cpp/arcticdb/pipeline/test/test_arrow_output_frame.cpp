@@ -0,0 +1,110 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/pipeline/arrow_output_frame.hpp>
+#include <arcticdb/pipeline/string_pool_utils.hpp>
+#include <arcticdb/stream/index.hpp>
+
+using namespace arcticdb;
+
+namespace {
+
+SegmentInMemory get_frame() {
+    auto index = stream::TimeseriesIndex::default_index();
+    SegmentInMemory frame{index.create_stream_descriptor(123, {
+        scalar_field_proto(DataType::INT64, "ints"),
+        scalar_field_proto(DataType::FLOAT64, "floats"),
+        scalar_field_proto(DataType::UTF_DYNAMIC64, "strings"),
+        scalar_field_proto(DataType::BOOL8, "bools")
+    }), 0, false, true};
+
+    for(auto i = 0; i < 3; ++i) {
+        frame.set_scalar(0, timestamp(i));
+        frame.set_scalar(1, int64_t(i * 10));
+        if(i != 1)
+            frame.set_scalar(2, double(i) / 2);
+        frame.set_string(3, i == 0 ? "alpha" : "gamma");
+        frame.set_scalar(4, i != 0);
+        frame.end_row();
+    }
+    set_offset_string_at(1, frame.column(3).data().buffer(), not_a_string());
+    return frame;
+}
+
+std::string_view string_at(const ArrowArray& array, size_t row) {
+    const auto offsets = static_cast<const int64_t*>(array.buffers[1]);
+    const auto data = static_cast<const char*>(array.buffers[2]);
+    return {data + offsets[row], static_cast<size_t>(offsets[row + 1] - offsets[row])};
+}
+
+} // namespace
+
+TEST(ArrowOutputFrame, ExportRecordBatch) {
+    ArrowArray array;
+    ArrowSchema schema;
+    {
+        pipelines::ArrowOutputFrame output{get_frame()};
+        output.export_record_batch(&array, &schema);
+    }
+
+    ASSERT_STREQ(schema.format, "+s");
+    ASSERT_EQ(schema.n_children, 5);
+    ASSERT_EQ(array.n_children, 5);
+    ASSERT_EQ(array.length, 3);
+    ASSERT_STREQ(schema.children[0]->format, "tsn:");
+    ASSERT_EQ(static_cast<const timestamp*>(array.children[0]->buffers[1])[2], 2);
+
+    ASSERT_STREQ(schema.children[1]->name, "ints");
+    ASSERT_STREQ(schema.children[1]->format, "l");
+    ASSERT_EQ(array.children[1]->null_count, 0);
+    ASSERT_EQ(array.children[1]->buffers[0], nullptr);
+    ASSERT_EQ(static_cast<const int64_t*>(array.children[1]->buffers[1])[2], 20);
+
+    // The float column skipped a row so is sparse, and gets a validity bitmap
+    const auto& floats = *array.children[2];
+    ASSERT_STREQ(schema.children[2]->format, "g");
+    ASSERT_EQ(floats.null_count, 1);
+    ASSERT_EQ(static_cast<const uint8_t*>(floats.buffers[0])[0] & 0x7, 0x5);
+    ASSERT_EQ(static_cast<const double*>(floats.buffers[1])[2], 1.0);
+
+    const auto& strings = *array.children[3];
+    ASSERT_STREQ(schema.children[3]->format, "U");
+    ASSERT_EQ(strings.n_buffers, 3);
+    ASSERT_EQ(strings.null_count, 1);
+    ASSERT_EQ(static_cast<const uint8_t*>(strings.buffers[0])[0] & 0x7, 0x5);
+    ASSERT_EQ(string_at(strings, 0), "alpha");
+    ASSERT_EQ(string_at(strings, 1), "");
+    ASSERT_EQ(string_at(strings, 2), "gamma");
+
+    const auto& bools = *array.children[4];
+    ASSERT_STREQ(schema.children[4]->format, "b");
+    ASSERT_EQ(static_cast<const uint8_t*>(bools.buffers[1])[0] & 0x7, 0x6);
+
+    array.release(&array);
+    schema.release(&schema);
+    ASSERT_EQ(array.release, nullptr);
+    ASSERT_EQ(schema.release, nullptr);
+}
+
+TEST(ArrowOutputFrame, ExportColumnMovedOut) {
+    pipelines::ArrowOutputFrame output{get_frame()};
+    ArrowArray array;
+    ArrowSchema schema;
+    output.export_record_batch(&array, &schema);
+
+    // A consumer can take ownership of a child, which then outlives its parent
+    ArrowArray child = *array.children[3];
+    array.children[3]->release = nullptr;
+    array.release(&array);
+    schema.release(&schema);
+
+    ASSERT_EQ(string_at(child, 2), "gamma");
+    child.release(&child);
+    ASSERT_EQ(child.release, nullptr);
+}
@@ -0,0 +1,59 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/pipeline/concurrent_string_pool.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace arcticdb;
+
+TEST(ConcurrentStringPool, SharedAcrossThreads) {
+    StringPool frame_pool;
+    pipelines::ConcurrentStringPool shared_pool{frame_pool};
+    constexpr size_t num_threads = 4;
+    constexpr size_t num_strings = 1000;
+    std::vector<std::vector<StringPool::offset_t>> offsets(num_threads);
+    std::vector<std::thread> threads;
+    for(size_t t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&shared_pool, &offsets, t] () {
+            for(size_t i = 0; i < num_strings; ++i)
+                offsets[t].push_back(shared_pool.get("string_" + std::to_string(i % 100)));
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(shared_pool.size(), 100u);
+    for(size_t t = 1; t < num_threads; ++t)
+        ASSERT_EQ(offsets[t], offsets[0]);
+
+    for(size_t i = 0; i < num_strings; ++i)
+        ASSERT_EQ(frame_pool.get_const_view(offsets[0][i]), "string_" + std::to_string(i % 100));
+}
+
+TEST(ConcurrentStringPool, SegmentMapping) {
+    StringPool frame_pool;
+    pipelines::ConcurrentStringPool shared_pool{frame_pool};
+    StringPool segment_pool;
+    const auto a = segment_pool.get("a").offset();
+    const auto b = segment_pool.get("b").offset();
+
+    size_t transformed = 0;
+    pipelines::SegmentStringMapping mapping{shared_pool, segment_pool, [&transformed] (std::string_view sv) {
+        ++transformed;
+        return std::string{sv} + "!";
+    }};
+    const auto mapped_a = mapping.get(a);
+    ASSERT_EQ(mapping.get(b), mapping.get(b));
+    ASSERT_EQ(mapping.get(a), mapped_a);
+    ASSERT_EQ(transformed, 2u);
+    ASSERT_EQ(frame_pool.get_const_view(mapped_a), "a!");
+}
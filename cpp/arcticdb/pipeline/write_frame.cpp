@@ -22,6 +22,7 @@
 #include <arcticdb/pipeline/frame_utils.hpp>
 #include <arcticdb/pipeline/write_frame.hpp>
 #include <arcticdb/stream/append_map.hpp>
+#include <arcticdb/async/task_scheduler.hpp>
 
 #include <pybind11/pybind11.h>
 
@@ -30,6 +31,21 @@ namespace arcticdb::pipelines {
 using namespace arcticdb::entity;
 using namespace arcticdb::stream;
 
+namespace {
+
+// Size of the segment a slice is copied into, which is reserved from the memory budget until the segment is written.
+// String columns are counted by the size of their pointers rather than their strings
+size_t estimated_slice_bytes(const InputTensorFrame &frame, const FrameSlice &slice) {
+    const auto rows = slice.row_range.second - slice.row_range.first;
+    size_t row_bytes = frame.index_tensor ? frame.index_tensor->elsize() : 0;
+    for (size_t col = 0, end = slice.col_range.diff(); col < end; ++col)
+        row_bytes += frame.field_tensors[slice.absolute_field_col(col)].elsize();
+
+    return rows * row_bytes;
+}
+
+} // namespace
+
 std::vector<folly::Future<SliceAndKey>> write_slices(
         const InputTensorFrame &frame,
         const std::vector<FrameSlice> &slices,
@@ -44,6 +60,20 @@ std::vector<folly::Future<SliceAndKey>> write_slices(
 
     std::vector<std::vector<folly::Future<VariantKey>>> key_groups;
 
+    std::vector<VariantKey> keys;
+    keys.reserve(slices.size());
+    std::vector<async::MemoryReservation> reservations;
+    // Writes the segments built so far, releasing their reservations so that the rest of the frame can be sliced
+    auto write_pending = [&]() {
+        if(key_segs.empty())
+            return;
+
+        auto written = sink->batch_write(std::move(key_segs), de_dup_map).get();
+        keys.insert(std::end(keys), std::make_move_iterator(std::begin(written)), std::make_move_iterator(std::end(written)));
+        key_segs.clear();
+        reservations.clear();
+    };
+
     // construct batch
     util::variant_match(frame.index, [&](auto &idx) {
         using IdxType = std::decay_t<decltype(idx)>;
@@ -52,6 +82,15 @@ std::vector<folly::Future<SliceAndKey>> write_slices(
         size_t slice_num_for_column = 0;
         std::optional<size_t> first_row;
         for (const FrameSlice &slice : slices) {
+            // Write out the pending segments rather than wait for memory they hold when over the budget
+            const auto slice_bytes = estimated_slice_bytes(frame, slice);
+            auto reservation = async::memory_governor().try_reserve(slice_bytes);
+            if(!reservation) {
+                write_pending();
+                reservation = async::memory_governor().reserve(slice_bytes);
+            }
+            reservations.emplace_back(std::move(*reservation));
+
             // Build in mem segment
             ARCTICDB_SUBSAMPLE_AGG(WriteSliceCopyToSegment)
             if(!first_row)
@@ -93,7 +132,7 @@ std::vector<folly::Future<SliceAndKey>> write_slices(
                 aggregator_set_data(
                     type_desc_from_proto(fd.type_desc()),
                     tensor, agg, abs_col, rows_to_write, offset_in_frame, slice_num_for_column,
-                    regular_slice_size, sparsify_floats);
+                    regular_slice_size, sparsify_floats, frame.arrow_string_column(slice.absolute_field_col(col)));
             }
 
             ++slice_num_for_column;
@@ -102,17 +141,15 @@ std::vector<folly::Future<SliceAndKey>> write_slices(
         }
     });
 
-    auto fut_writes = sink->batch_write(std::move(key_segs), de_dup_map);
-
     ARCTICDB_SUBSAMPLE_DEFAULT(WriteSlicesWait)
-    return std::move(fut_writes).thenValue([&](auto &&keys) {
-        std::vector<folly::Future<SliceAndKey>> res;
-        res.reserve(keys.size());
-        for (std::size_t i = 0; i < res.capacity(); ++i) {
-            res.emplace_back(SliceAndKey{slices[i], std::move(to_atom(keys[i]))});
-        }
-        return res;
-    }).get();
+    write_pending();
+
+    std::vector<folly::Future<SliceAndKey>> res;
+    res.reserve(keys.size());
+    for (std::size_t i = 0; i < res.capacity(); ++i) {
+        res.emplace_back(SliceAndKey{slices[i], std::move(to_atom(keys[i]))});
+    }
+    return res;
 }
 
 folly::Future<entity::VariantKey> write_multi_index(
@@ -201,7 +238,8 @@ folly::Future<entity::AtomKey> append_frame(
         index::IndexSegmentReader& index_segment_reader,
         const std::shared_ptr<Store>& store,
         bool dynamic_schema,
-        bool ignore_sort_order)
+        bool ignore_sort_order,
+        const std::optional<entity::AtomKey>& chain_base)
 {
     ARCTICDB_SAMPLE_DEFAULT(AppendFrame)
     util::variant_match(frame.index,
@@ -225,7 +263,16 @@ folly::Future<entity::AtomKey> append_frame(
                         }
     );
 
-    auto existing_slices = unfiltered_index(index_segment_reader);
+    std::vector<SliceAndKey> existing_slices;
+    if(chain_base) {
+        // A single row referencing the previous index stands in for all of its slices, see resolve_index_chain
+        const auto& tsd = index_segment_reader.tsd();
+        existing_slices.emplace_back(
+            FrameSlice{ColRange{0, static_cast<size_t>(tsd.stream_descriptor().fields_size())}, RowRange{0, tsd.total_rows()}},
+            *chain_base);
+    } else {
+        existing_slices = unfiltered_index(index_segment_reader);
+    }
     auto fut_slice_keys = slice_and_write(frame, slicing, get_partial_key_gen(frame, key), store);
     auto keys_fut = folly::collect(fut_slice_keys);
 
@@ -234,17 +281,23 @@ folly::Future<entity::AtomKey> append_frame(
     auto slices_to_write = std::move(existing_slices);
     slices_to_write.insert(std::end(slices_to_write), std::begin(slice_and_keys_to_append), std::end(slice_and_keys_to_append));
     std::sort(std::begin(slices_to_write), std::end(slices_to_write));
+    auto index = stream::index_type_from_descriptor(frame.desc);
+    arcticdb::proto::descriptors::TimeSeriesDescriptor pb_desc;
     if(dynamic_schema) {
         auto merged_descriptor =
             merge_descriptors(frame.desc, {index_segment_reader.tsd().stream_descriptor().fields()}, {});
         merged_descriptor.set_sorted(deduce_sorted(index_segment_reader.mutable_tsd().stream_descriptor().sorted(), frame.desc.get_sorted()));
-        auto pb_desc =
+        pb_desc =
             make_descriptor(frame.num_rows + frame.offset, std::move(merged_descriptor), frame.norm_meta, std::move(frame.user_meta), std::nullopt, frame.bucketize_dynamic);
-        return index::write_index(stream::index_type_from_descriptor(frame.desc), std::move(pb_desc), std::move(slices_to_write), key, store);
     } else {
         frame.desc.set_sorted(deduce_sorted(index_segment_reader.mutable_tsd().stream_descriptor().sorted(), frame.desc.get_sorted()));
-        return index::write_index(std::move(frame), std::move(slices_to_write), key, store);
+        auto offset = frame.offset;
+        pb_desc = descriptor_from_frame(std::move(frame), offset);
     }
+    if(chain_base)
+        pb_desc.set_index_chain_depth(index_segment_reader.index_chain_depth() + 1);
+
+    return index::write_index(index, std::move(pb_desc), std::move(slices_to_write), key, store);
 }
 
 void update_string_columns(const SegmentInMemory& original, SegmentInMemory output) {
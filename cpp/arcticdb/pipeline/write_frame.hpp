@@ -52,7 +52,8 @@ folly::Future<entity::AtomKey> append_frame(
         index::IndexSegmentReader &index_segment_reader,
         const std::shared_ptr<Store>& store,
         bool dynamic_schema,
-        bool ignore_sort_order
+        bool ignore_sort_order,
+        const std::optional<entity::AtomKey>& chain_base = std::nullopt
 );
 
 std::optional<SliceAndKey> rewrite_partial_segment(
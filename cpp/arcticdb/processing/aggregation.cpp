@@ -150,6 +150,79 @@ std::optional<DataType> MaxOrMin::finalize(SegmentInMemory& seg, bool dynamic_sc
     }
 }
 
+void FirstOrLast::aggregate(const std::optional<ColumnWithStrings>& input_column, const std::vector<size_t>& groups, size_t unique_values) {
+    if(input_column.has_value()) {
+        entity::details::visit_type(data_type_, [&input_column, unique_values, &groups, that=this] (auto global_type_desc_tag) {
+            using GlobalRawType = typename decltype(global_type_desc_tag)::raw_type;
+            if constexpr(!is_sequence_type(decltype(global_type_desc_tag)::data_type)) {
+                auto prev_size = that->aggregated_.size() / sizeof(MaybeValue<GlobalRawType>);
+                that->aggregated_.resize(sizeof(MaybeValue<GlobalRawType>) * unique_values);
+                auto out_ptr = reinterpret_cast<MaybeValue<GlobalRawType>*>(that->aggregated_.data());
+                std::fill(out_ptr + prev_size, out_ptr + unique_values, MaybeValue<GlobalRawType>{});
+                auto col_data = input_column->column_->data();
+                entity::details::visit_type(input_column->column_->type().data_type(), [&groups, &out_ptr, &col_data, that=that] (auto type_desc_tag) {
+                    using InputDataTypeTag = decltype(type_desc_tag);
+                    if constexpr(!is_sequence_type(InputDataTypeTag::data_type)) {
+                        using RawType = typename InputDataTypeTag::raw_type;
+                        auto groups_pos = 0;
+                        while (auto block = col_data.next<ScalarTagType<InputDataTypeTag>>()) {
+                            auto ptr = reinterpret_cast<const RawType *>(block.value().data());
+                            for (auto i = 0u; i < block.value().row_count(); ++i, ++ptr, ++groups_pos) {
+                                auto& val = out_ptr[groups[groups_pos]];
+                                // Rows arrive in index order, so first keeps the earliest write and last the latest
+                                if (that->occurrence_ == Occurrence::last || !val.written_) {
+                                    val.value_ = GlobalRawType(*ptr);
+                                    val.written_ = true;
+                                }
+                            }
+                        }
+                    } else {
+                        util::raise_rte("String aggregations not currently supported");
+                    }
+                });
+            }
+        });
+    }
+}
+
+std::optional<DataType> FirstOrLast::finalize(SegmentInMemory& seg, bool dynamic_schema, size_t unique_values) {
+    if(!aggregated_.empty()) {
+        if(dynamic_schema) {
+            entity::details::visit_type(data_type_, [that=this, &seg, unique_values] (auto type_desc_tag) {
+                using RawType = typename decltype(type_desc_tag)::raw_type;
+                auto prev_size = that->aggregated_.size() / sizeof(MaybeValue<RawType>);
+                that->aggregated_.resize(sizeof(MaybeValue<RawType>) * unique_values);
+                auto in_ptr =  reinterpret_cast<MaybeValue<RawType>*>(that->aggregated_.data());
+                std::fill(in_ptr + prev_size, in_ptr + unique_values, MaybeValue<RawType>{});
+                auto col = std::make_shared<Column>(make_scalar_type(DataType::FLOAT64), unique_values, true, false);
+                auto out_ptr = reinterpret_cast<double*>(col->ptr());
+                for(auto i = 0u; i < unique_values; ++i, ++in_ptr, ++out_ptr) {
+                    *out_ptr = in_ptr->written_ ? static_cast<double>(in_ptr->value_) : std::numeric_limits<double>::quiet_NaN();
+                }
+
+                col->set_row_data(unique_values);
+                seg.add_column(scalar_field_proto(DataType::FLOAT64, that->get_output_column_name().value), col);
+            });
+            return DataType::FLOAT64;
+        } else {
+            entity::details::visit_type(data_type_, [that=this, &seg, unique_values] (auto type_desc_tag) {
+                using RawType = typename decltype(type_desc_tag)::raw_type;
+                auto col = std::make_shared<Column>(make_scalar_type(that->data_type_), unique_values, true, false);
+                const auto* in_ptr =  reinterpret_cast<const MaybeValue<RawType>*>(that->aggregated_.data());
+                auto out_ptr = reinterpret_cast<RawType*>(col->ptr());
+                for(auto i = 0u; i < unique_values; ++i, ++in_ptr, ++out_ptr) {
+                    *out_ptr = in_ptr->value_;
+                }
+                col->set_row_data(unique_values);
+                seg.add_column(scalar_field_proto(that->data_type_, that->get_output_column_name().value), col);
+            });
+            return data_type_;
+        }
+    } else {
+        return std::nullopt;
+    }
+}
+
 void Mean::aggregate(const std::optional<ColumnWithStrings>& input_column, const std::vector<size_t>& groups, size_t unique_values) {
     if(input_column.has_value()) {
         input_column->column_->type().visit_tag([&] (auto type_desc_tag) {
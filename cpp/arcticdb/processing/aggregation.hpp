@@ -108,6 +108,37 @@ struct MaxOrMin {
 
 };
 
+enum class Occurrence {
+    first, last
+};
+
+struct FirstOrLast {
+    std::vector<uint8_t> aggregated_;
+    ColumnName input_column_name_;
+    ColumnName output_column_name_;
+    DataType data_type_ = {};
+    Occurrence occurrence_;
+
+    FirstOrLast(ColumnName input_column_name, ColumnName output_column_name, Occurrence occurrence) :
+        input_column_name_(std::move(input_column_name)),
+        output_column_name_(std::move(output_column_name)),
+        occurrence_(occurrence){
+    }
+
+    void aggregate(const std::optional<ColumnWithStrings>& input_column, const std::vector<size_t>& groups, size_t unique_values);
+
+    std::optional<DataType> finalize(SegmentInMemory& seg, bool dynamic_schema, size_t unique_values);
+
+    [[nodiscard]] ColumnName get_input_column_name() const { return input_column_name_; }
+
+    [[nodiscard]] ColumnName get_output_column_name() const { return output_column_name_; }
+
+    [[nodiscard]] FirstOrLast construct() const { return {input_column_name_, output_column_name_, occurrence_}; }
+
+    void set_data_type(DataType data_type) { data_type_ = data_type; }
+
+};
+
 struct Mean {
     ColumnName input_;
     CountAndTotals data_;
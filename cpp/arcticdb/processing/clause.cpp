@@ -14,6 +14,8 @@
 #include <arcticdb/pipeline/value_set.hpp>
 #include <arcticdb/util/third_party/emilib_map.hpp>
 #include <arcticdb/pipeline/frame_slice.hpp>
+#include <arcticdb/pipeline/index_segment_reader.hpp>
+#include <arcticdb/storage/store.hpp>
 
 namespace arcticdb {
 
@@ -259,6 +261,169 @@ AggregationClause::process(std::shared_ptr<Store> store, Composite<ProcessingSeg
     return Composite{ProcessingSegment{std::move(seg)}};
 }
 
+[[nodiscard]] std::optional<std::vector<Composite<ProcessingSegment>>>
+ResamplePartitionClause::repartition(std::vector<Composite<ProcessingSegment>> &&c) const {
+    struct BucketedSegment {
+        timestamp first_bucket_;
+        timestamp last_bucket_;
+        ProcessingSegment proc_;
+    };
+
+    auto comps = std::move(c);
+    // All of the segments were brought into memory by process(), so no store is required to read them here
+    std::shared_ptr<Store> no_store;
+    std::vector<BucketedSegment> bucketed;
+    for (auto &comp : comps) {
+        comp.broadcast([&bucketed, &no_store, that = this](auto &proc) {
+            const auto &seg = proc.data()[0].segment(no_store);
+            if (seg.row_count() == 0)
+                return;
+
+            const auto first_bucket = that->bucketer_.bucket_start(seg.template scalar_at<timestamp>(0, 0).value());
+            const auto last_bucket = that->bucketer_.bucket_start(seg.template scalar_at<timestamp>(seg.row_count() - 1, 0).value());
+            bucketed.push_back(BucketedSegment{first_bucket, last_bucket, std::move(proc)});
+        });
+    }
+
+    std::stable_sort(std::begin(bucketed), std::end(bucketed), [] (const BucketedSegment &left, const BucketedSegment &right) {
+        return left.first_bucket_ < right.first_bucket_;
+    });
+
+    // A bucket can only span consecutive row slices, so slices are chained together while the bucket at the end of one
+    // is the bucket at the start of the next
+    std::vector<Composite<ProcessingSegment>> ret;
+    std::optional<timestamp> previous_last_bucket;
+    for (auto &item : bucketed) {
+        if (!previous_last_bucket || *previous_last_bucket != item.first_bucket_)
+            ret.emplace_back();
+
+        previous_last_bucket = item.last_bucket_;
+        ret.back().push_back(std::move(item.proc_));
+    }
+    return ret;
+}
+
+[[nodiscard]] Composite<ProcessingSegment>
+ResampleClause::process(std::shared_ptr<Store> store, Composite<ProcessingSegment> &&p) const {
+    std::call_once(*reset_descriptor_, [context = execution_context_]() {
+        std::string index_name;
+        {
+            std::scoped_lock lock{*context->column_mutex_};
+            util::check(context->output_descriptor_->index().type() == IndexDescriptor::TIMESTAMP,
+                        "Resampling requires a timeseries index");
+            index_name = context->output_descriptor_->field(0).name();
+            context->orig_output_descriptor_ = context->output_descriptor_;
+            context->output_descriptor_ = resampled_descriptor();
+        }
+        context->check_output_column(index_name, DataType::MICROS_UTC64);
+    });
+
+    auto procs = std::move(p);
+    std::vector<Aggregation> aggregators;
+    auto desc = execution_context_->orig_output_descriptor_;
+    for (const auto &agg : aggregation_operators_){
+        auto agg_construct = agg.construct();
+        const auto& agg_field_pos = desc->find_field(agg_construct.get_input_column_name().value);
+        util::check(agg_field_pos.has_value(), "Field {} not found in resample", agg_construct.get_input_column_name().value);
+        auto agg_field = desc->field(agg_field_pos.value());
+        agg_construct.set_data_type(data_type_from_proto(agg_field.type_desc()));
+        aggregators.emplace_back(agg_construct);
+    }
+
+    // Input is sorted on the index, so each new bucket gets the next ordinal and no hashing is needed
+    std::vector<timestamp> labels;
+    std::optional<timestamp> current_bucket;
+    procs.broadcast([&store, &labels, &current_bucket, &aggregators, &execution_context = execution_context_, that = this](auto &proc) {
+        proc.set_execution_context(execution_context);
+        const auto &index_column = proc.data()[0].segment(store).column(0);
+        std::vector<size_t> row_to_bucket;
+        row_to_bucket.reserve(index_column.row_count());
+        auto index_data = index_column.data();
+        while (auto block = index_data.next<ScalarTagType<DataTypeTag<DataType::MICROS_UTC64>>>()) {
+            const auto row_count = block->row_count();
+            auto ptr = block->data();
+            for (size_t i = 0; i < row_count; ++i, ++ptr) {
+                const auto bucket = that->bucketer_.bucket_start(*ptr);
+                if (!current_bucket || bucket != *current_bucket) {
+                    util::check(!current_bucket || bucket > *current_bucket, "Resample input is not sorted on the index");
+                    current_bucket = bucket;
+                    labels.push_back(that->bucketer_.bucket_label(bucket));
+                }
+                row_to_bucket.push_back(labels.size() - 1);
+            }
+        }
+
+        for (Aggregation &agg : aggregators) {
+            auto input_column = proc.get(agg.get_input_column_name(), store);
+            std::optional<ColumnWithStrings> opt_input_column;
+            if (std::holds_alternative<ColumnWithStrings>(input_column)) {
+                opt_input_column.emplace(std::get<ColumnWithStrings>(input_column));
+            }
+            agg.aggregate(opt_input_column, row_to_bucket, labels.size());
+        }
+    });
+
+    if (labels.empty())
+        return {};
+
+    const auto num_buckets = labels.size();
+    SegmentInMemory seg{resampled_descriptor()};
+    const auto index_name = execution_context_->output_descriptor_->field(0).name();
+    auto index_pos = seg.add_column(scalar_field_proto(DataType::MICROS_UTC64, index_name), num_buckets, true);
+    auto index_ptr = reinterpret_cast<timestamp *>(seg.column(index_pos).ptr());
+    std::copy(std::begin(labels), std::end(labels), index_ptr);
+
+    for (auto &agg : aggregators) {
+        auto data_type = agg.finalize(seg, execution_context_->dynamic_schema(), num_buckets);
+        if(data_type)
+            execution_context_->check_output_column(agg.get_output_column_name().value, data_type.value());
+    }
+
+    seg.set_row_id(num_buckets - 1);
+    return Composite{ProcessingSegment{std::move(seg)}};
+}
+
+[[nodiscard]] std::optional<std::vector<Composite<ProcessingSegment>>>
+ResampleClause::repartition(std::vector<Composite<ProcessingSegment>> &&c) const {
+    struct LabelledSegment {
+        timestamp first_label_;
+        ProcessingSegment proc_;
+    };
+
+    auto comps = std::move(c);
+    // Segments are already in memory following process()
+    std::shared_ptr<Store> no_store;
+    std::vector<LabelledSegment> labelled;
+    for (auto &comp : comps) {
+        comp.broadcast([&labelled, &no_store](ProcessingSegment &proc) {
+            const auto &seg = proc.data()[0].segment(no_store);
+            if (seg.row_count() == 0)
+                return;
+
+            const auto first_label = seg.template scalar_at<timestamp>(0, 0).value();
+            labelled.push_back(LabelledSegment{first_label, std::move(proc)});
+        });
+    }
+
+    // Partitions hold disjoint runs of buckets, so ordering on the first label orders every bucket. The output of each
+    // partition is given the next rows of the output, as otherwise every partition's rows would start from zero and
+    // the order of the buckets would be lost when the output frame is put together
+    std::sort(std::begin(labelled), std::end(labelled), [] (const LabelledSegment &left, const LabelledSegment &right) {
+        return left.first_label_ < right.first_label_;
+    });
+
+    std::vector<Composite<ProcessingSegment>> ret;
+    size_t start_row = 0;
+    for (auto &item : labelled) {
+        auto &slice_and_key = item.proc_.data()[0];
+        const auto num_rows = slice_and_key.segment(no_store).row_count();
+        slice_and_key.slice_.row_range = pipelines::RowRange{start_row, start_row + num_rows};
+        start_row += num_rows;
+        ret.emplace_back(std::move(item.proc_));
+    }
+    return ret;
+}
+
 template<typename IndexType, typename DensityPolicy, typename QueueType, typename Comparator, typename StreamId>
 void merge_impl(
         Composite<ProcessingSegment> &ret,
@@ -359,6 +524,187 @@ MergeClause::process(std::shared_ptr<Store> store, Composite<ProcessingSegment>
         return ret;
     }
 
+void sort_processing_segment(ProcessingSegment &proc, const std::string &column_name, const std::shared_ptr<Store> &store) {
+    std::optional<JiveTable> table;
+    for (auto &slice_and_key : proc.data()) {
+        auto &seg = slice_and_key.segment(store);
+        seg.init_column_map();
+        if (auto opt_idx = seg.column_index(column_name)) {
+            const auto &sort_col = seg.column(position_t(opt_idx.value()));
+            util::check(!sort_col.is_sparse(), "Can't sort on sparse column {}", column_name);
+            util::check(!is_sequence_type(sort_col.type().data_type()), "Sorting on string column {} is not supported", column_name);
+            table = sort_col.type().visit_tag([&sort_col] (auto tdt) {
+                using RawType = typename decltype(tdt)::DataTypeTag::raw_type;
+                return create_jive_table<RawType>(sort_col);
+            });
+            break;
+        }
+    }
+    util::check(table.has_value(), "Column {} not found in sort", column_name);
+
+    // The same permutation applies to every column slice, so that the rows stay aligned across the slices
+    for (auto &slice_and_key : proc.data()) {
+        auto &seg = slice_and_key.segment(store);
+        for (auto field_col = 0u; field_col < seg.descriptor().field_count(); ++field_col)
+            seg.column(position_t(field_col)).sort_external(*table);
+    }
+}
+
+struct SortedRun {
+    ProcessingSegment proc_;
+    std::shared_ptr<Column> sort_column_;
+    size_t start_row_ = 0; // of the row slice the run was sorted from
+    size_t row_ = 0;
+    size_t num_rows_ = 0;
+};
+
+struct SortedRowLocation {
+    size_t run_;
+    size_t row_;
+};
+
+ProcessingSegment gather_sorted_rows(
+        std::vector<SortedRun> &runs,
+        const std::vector<SortedRowLocation> &locations,
+        size_t start_row) {
+    using namespace arcticdb::pipelines;
+    std::shared_ptr<Store> no_store;
+    const auto num_rows = locations.size();
+    const auto &layout = runs[0].proc_.data();
+    ProcessingSegment output;
+    for (auto slice_idx = 0u; slice_idx < layout.size(); ++slice_idx) {
+        const auto &desc = layout[slice_idx].segment(no_store).descriptor();
+        SegmentInMemory seg{StreamDescriptor{desc.id(), desc.index(), {}}};
+        for (auto field_col = 0u; field_col < desc.field_count(); ++field_col) {
+            const auto &field = desc.field(field_col);
+            auto pos = seg.add_column(field, num_rows, true);
+            auto &out_column = seg.column(pos);
+            out_column.type().visit_tag([&] (auto tdt) {
+                using RawType = typename decltype(tdt)::DataTypeTag::raw_type;
+                constexpr auto data_type = decltype(tdt)::DataTypeTag::data_type;
+                auto out_ptr = reinterpret_cast<RawType *>(out_column.ptr());
+                for (const auto &location : locations) {
+                    auto &source = runs[location.run_].proc_.data()[slice_idx].segment(no_store);
+                    const auto &source_column = source.column(position_t(field_col));
+                    auto value = source_column.template scalar_at<RawType>(location.row_);
+                    if constexpr (is_sequence_type(data_type)) {
+                        // String offsets are only meaningful in the source pool, so re-intern them in the output pool
+                        if (value && is_a_string(*value))
+                            *out_ptr++ = seg.string_pool().get(source.const_string_pool().get_view(*value)).offset();
+                        else
+                            *out_ptr++ = value.value_or(not_a_string());
+                    } else if constexpr (std::is_floating_point_v<RawType>) {
+                        *out_ptr++ = value.value_or(std::numeric_limits<RawType>::quiet_NaN());
+                    } else {
+                        *out_ptr++ = value.value_or(RawType{});
+                    }
+                }
+            });
+        }
+        seg.set_row_data(static_cast<ssize_t>(num_rows) - 1);
+        const ColRange col_range{layout[slice_idx].slice().col_range};
+        const RowRange row_range{start_row, start_row + num_rows};
+        output.data().emplace_back(SliceAndKey{std::move(seg), FrameSlice{col_range, row_range}});
+    }
+    return output;
+}
+
+[[nodiscard]] Composite<ProcessingSegment>
+GlobalSortClause::process(std::shared_ptr<Store> store, Composite<ProcessingSegment> &&p) const {
+    auto procs = std::move(p);
+    procs.broadcast([&store, that = this](ProcessingSegment &proc) {
+        sort_processing_segment(proc, that->column_, store);
+        const auto row_count = proc.data()[0].segment(store).row_count();
+        if (that->limit_ && row_count > *that->limit_) {
+            util::BitSet bv(static_cast<util::BitSet::size_type>(row_count));
+            if (*that->limit_ > 0)
+                bv.set_range(0, bv_size(*that->limit_ - 1));
+            proc.apply_filter(bv, store);
+        }
+    });
+    return procs;
+}
+
+[[nodiscard]] std::optional<std::vector<Composite<ProcessingSegment>>>
+GlobalSortClause::repartition(std::vector<Composite<ProcessingSegment>> &&c) const {
+    auto comps = std::move(c);
+    // Segments are already in memory following process()
+    std::shared_ptr<Store> no_store;
+    std::vector<SortedRun> runs;
+    for (auto &comp : comps) {
+        comp.broadcast([&runs, &no_store, &column_name = column_](ProcessingSegment &proc) {
+            if (proc.data().empty() || proc.data()[0].segment(no_store).row_count() == 0)
+                return;
+
+            if (!runs.empty())
+                util::check(proc.data().size() == runs[0].proc_.data().size(),
+                            "Global sort requires the same column slicing in every row slice");
+
+            std::shared_ptr<Column> sort_column;
+            for (auto &slice_and_key : proc.data()) {
+                auto &seg = slice_and_key.segment(no_store);
+                seg.init_column_map();
+                if (auto opt_idx = seg.column_index(column_name)) {
+                    sort_column = seg.column_ptr(position_t(opt_idx.value()));
+                    break;
+                }
+            }
+            util::check(static_cast<bool>(sort_column), "Column {} not found in sort", column_name);
+            const auto start_row = proc.data()[0].slice().row_range.first;
+            const auto num_rows = proc.data()[0].segment(no_store).row_count();
+            runs.push_back(SortedRun{std::move(proc), std::move(sort_column), start_row, 0, num_rows});
+        });
+    }
+
+    std::vector<Composite<ProcessingSegment>> ret;
+    if (runs.empty())
+        return ret;
+
+    const auto sort_type = runs[0].sort_column_->type();
+    for (const auto &run : runs)
+        util::check(run.sort_column_->type() == sort_type, "Global sort requires column {} to have the same type in every segment", column_);
+
+    const auto segment_size = static_cast<size_t>(ConfigsMap::instance()->get_int("Sort.SegmentSize", 100000));
+    const auto max_rows = limit_.value_or(std::numeric_limits<size_t>::max());
+    sort_type.visit_tag([&] (auto tdt) {
+        using RawType = typename decltype(tdt)::DataTypeTag::raw_type;
+        auto value = [&runs] (size_t run) {
+            return runs[run].sort_column_->template reference_at<RawType>(position_t(runs[run].row_));
+        };
+        // Each run is sorted stably, so breaking ties on the position of the runs' row slices keeps equal values in
+        // their original relative order
+        auto compare = [&value, &runs] (size_t left, size_t right) {
+            const auto left_value = value(left);
+            const auto right_value = value(right);
+            return sort_less(right_value, left_value) ||
+                (!sort_less(left_value, right_value) && runs[left].start_row_ > runs[right].start_row_);
+        };
+
+        movable_priority_queue<size_t, std::vector<size_t>, decltype(compare)> queue{compare};
+        for (auto run = 0u; run < runs.size(); ++run)
+            queue.push(run);
+
+        std::vector<SortedRowLocation> locations;
+        size_t rows_written = 0;
+        while (!queue.empty() && rows_written + locations.size() < max_rows) {
+            auto run = queue.pop_top();
+            locations.push_back(SortedRowLocation{run, runs[run].row_});
+            if (++runs[run].row_ < runs[run].num_rows_)
+                queue.push(run);
+
+            if (locations.size() == segment_size) {
+                ret.emplace_back(gather_sorted_rows(runs, locations, rows_written));
+                rows_written += locations.size();
+                locations.clear();
+            }
+        }
+
+        if (!locations.empty())
+            ret.emplace_back(gather_sorted_rows(runs, locations, rows_written));
+    });
+    return ret;
+}
+
 [[nodiscard]] Composite<ProcessingSegment>
 RemoveColumnPartitioningClause::process(std::shared_ptr<Store> store, Composite<ProcessingSegment> &&p) const {
         using namespace arcticdb::pipelines;
@@ -411,6 +757,397 @@ RemoveColumnPartitioningClause::process(std::shared_ptr<Store> store, Composite<
         );
         return output;
 }
-    
 
-}
\ No newline at end of file
+struct JoinedRow {
+    size_t group_;
+    size_t row_;
+};
+
+struct JoinKeyIndex {
+    bool string_keys_ = false;
+    std::unordered_map<int64_t, JoinedRow> integral_index_;
+    std::unordered_map<std::string, JoinedRow> string_index_;
+};
+
+bool is_integral_join_key(DataType data_type) {
+    return is_integer_type(data_type) || is_time_type(data_type) || is_bool_type(data_type);
+}
+
+std::optional<int64_t> integral_key_at(const Column &column, size_t row) {
+    std::optional<int64_t> key;
+    column.type().visit_tag([&column, &key, row] (auto tdt) {
+        using RawType = typename decltype(tdt)::DataTypeTag::raw_type;
+        if constexpr (!is_sequence_type(decltype(tdt)::DataTypeTag::data_type) && std::is_integral_v<RawType>) {
+            if (auto value = column.template scalar_at<RawType>(row))
+                key = static_cast<int64_t>(*value);
+        } else {
+            util::raise_rte("Expected an integral join key");
+        }
+    });
+    return key;
+}
+
+std::shared_ptr<JoinKeyIndex> build_join_key_index(const JoinInput &right) {
+    const auto &key_name = *right.key_column_;
+    auto key_field = right.descriptor_->find_field(key_name);
+    util::check(key_field.has_value(), "Join key column {} not found in symbol {}", key_name, right.symbol_);
+    const auto key_type = data_type_from_proto(right.descriptor_->field(*key_field).type_desc());
+    auto index = std::make_shared<JoinKeyIndex>();
+    index->string_keys_ = is_dynamic_string_type(key_type);
+    util::check(index->string_keys_ || is_integral_join_key(key_type),
+                "Cannot join on column {} of symbol {} with type {}, keys must be integral or dynamic strings",
+                key_name, right.symbol_, key_type);
+
+    for (size_t group = 0; group < right.segments_.size(); ++group) {
+        const auto &group_segments = right.segments_[group];
+        auto key_segment = std::find_if(std::begin(group_segments), std::end(group_segments), [&key_name] (const SegmentInMemory &seg) {
+            return seg.column_index(key_name).has_value();
+        });
+        util::check(key_segment != std::end(group_segments), "Join key column {} missing from a row slice of symbol {}", key_name, right.symbol_);
+        const auto key_pos = position_t(key_segment->column_index(key_name).value());
+        const auto &key_column = key_segment->column(key_pos);
+        for (size_t row = 0; row < key_segment->row_count(); ++row) {
+            bool inserted = true;
+            if (index->string_keys_) {
+                if (auto key = key_segment->string_at(position_t(row), key_pos))
+                    inserted = index->string_index_.try_emplace(std::string{*key}, JoinedRow{group, row}).second;
+            } else if (auto key = integral_key_at(key_column, row)) {
+                inserted = index->integral_index_.try_emplace(*key, JoinedRow{group, row}).second;
+            }
+            util::check(inserted, "Join key column {} of symbol {} contains duplicate values", key_name, right.symbol_);
+        }
+    }
+    return index;
+}
+
+void JoinInput::resolve(const std::shared_ptr<Store>& store, const AtomKey& index_key) {
+    using namespace arcticdb::pipelines;
+    auto index_segment_reader = pipelines::index::get_index_reader(index_key, store);
+    util::check(!index_segment_reader.is_pickled(), "Cannot join with symbol {} as its data is pickled", symbol_);
+    descriptor_ = StreamDescriptor{std::move(*index_segment_reader.mutable_tsd().mutable_stream_descriptor())};
+
+    std::vector<SliceAndKey> slice_and_keys;
+    for (auto it = index_segment_reader.begin(); it != index_segment_reader.end(); ++it)
+        slice_and_keys.push_back(*it);
+
+    std::sort(std::begin(slice_and_keys), std::end(slice_and_keys), [] (const SliceAndKey& left, const SliceAndKey& right) {
+        return std::tie(left.slice().row_range.first, left.slice().col_range.first) < std::tie(right.slice().row_range.first, right.slice().col_range.first);
+    });
+
+    row_groups_.clear();
+    for (auto &slice_and_key : slice_and_keys) {
+        if (row_groups_.empty() || !(row_groups_.back()[0].slice().row_range == slice_and_key.slice().row_range))
+            row_groups_.emplace_back();
+
+        row_groups_.back().push_back(std::move(slice_and_key));
+    }
+
+    std::vector<folly::Future<std::pair<VariantKey, SegmentInMemory>>> reads;
+    for (const auto &group : row_groups_) {
+        for (const auto &slice_and_key : group)
+            reads.emplace_back(store->read(slice_and_key.key()));
+    }
+    auto segments = folly::collect(reads).get();
+
+    segments_.clear();
+    size_t segment_idx = 0;
+    for (const auto &group : row_groups_) {
+        auto &group_segments = segments_.emplace_back();
+        for (size_t i = 0; i < group.size(); ++i) {
+            group_segments.emplace_back(std::move(segments[segment_idx++].second));
+            group_segments.back().init_column_map();
+        }
+    }
+
+    key_index_.reset();
+    if (key_column_)
+        key_index_ = build_join_key_index(*this);
+}
+
+// Right-hand row slices loaded into memory, with the position of each join column within them
+struct JoinRowGroups {
+    std::vector<std::vector<SegmentInMemory>> segments_;
+    // For each row group and join column, the slice and column position holding that column, if any
+    std::vector<std::vector<std::optional<std::pair<size_t, position_t>>>> locations_;
+};
+
+struct HashJoinTable {
+    JoinRowGroups rows_;
+    std::vector<JoinColumn> columns_;
+};
+
+std::vector<JoinColumn> join_columns(
+        const JoinInput &right,
+        const StreamDescriptor &left_desc,
+        const std::optional<std::string> &exclude,
+        bool may_be_missing) {
+    util::check(right.resolved(), "Join with symbol {} has not been resolved", right.symbol_);
+    const auto &right_desc = *right.descriptor_;
+    for (const auto &name : right.columns_)
+        util::check(right_desc.find_field(name).has_value(), "Column {} not found in symbol {}", name, right.symbol_);
+
+    std::vector<JoinColumn> output;
+    for (auto i = right_desc.index().field_count(); i < right_desc.field_count(); ++i) {
+        const auto &field = right_desc.field(i);
+        const auto &name = field.name();
+        if ((exclude && name == *exclude) ||
+            (!right.columns_.empty() && std::find(std::begin(right.columns_), std::end(right.columns_), name) == std::end(right.columns_)))
+            continue;
+
+        util::check(!left_desc.find_field(name).has_value(),
+                    "Column {} is present in both sides of the join with symbol {}, select the columns to join explicitly", name, right.symbol_);
+        const auto source_type = data_type_from_proto(field.type_desc());
+        util::check(!is_fixed_string_type(source_type), "Cannot join fixed-width string column {} from symbol {}", name, right.symbol_);
+        // Rows without a match need a missing value, which only floats, timestamps and strings can represent
+        const auto output_type = may_be_missing && (is_integer_type(source_type) || is_bool_type(source_type)) ? DataType::FLOAT64 : source_type;
+        output.push_back(JoinColumn{name, source_type, output_type});
+    }
+    return output;
+}
+
+JoinRowGroups join_row_groups(
+        const JoinInput &right,
+        const std::vector<size_t> &group_indices,
+        const std::vector<JoinColumn> &columns) {
+    JoinRowGroups output;
+    for (auto group : group_indices) {
+        const auto &group_segments = output.segments_.emplace_back(right.segments_[group]);
+        auto &locations = output.locations_.emplace_back(columns.size());
+        for (size_t col_idx = 0; col_idx < columns.size(); ++col_idx) {
+            for (size_t slice_idx = 0; slice_idx < group_segments.size(); ++slice_idx) {
+                if (auto opt_idx = group_segments[slice_idx].column_index(columns[col_idx].name_)) {
+                    locations[col_idx] = std::make_pair(slice_idx, position_t(opt_idx.value()));
+                    break;
+                }
+            }
+        }
+    }
+    return output;
+}
+
+/*
+ * Adds the join columns to the last slice of the left-hand processing segment, taking the value for each row from
+ * its matched right-hand row. Strings are re-interned into the left-hand segment's pool.
+ */
+void append_join_columns(
+        ProcessingSegment &proc,
+        const std::shared_ptr<Store> &store,
+        const std::vector<JoinColumn> &columns,
+        const JoinRowGroups &right_rows,
+        const std::vector<std::optional<JoinedRow>> &matches) {
+    auto &last = *proc.data().rbegin();
+    auto &seg = last.segment(store);
+    const auto num_rows = matches.size();
+    for (size_t col_idx = 0; col_idx < columns.size(); ++col_idx) {
+        const auto &join_column = columns[col_idx];
+        auto column = std::make_shared<Column>(make_scalar_type(join_column.output_type_), num_rows, true, false);
+        column->type().visit_tag([&] (auto tdt) {
+            using RawType = typename decltype(tdt)::DataTypeTag::raw_type;
+            constexpr auto output_type = decltype(tdt)::DataTypeTag::data_type;
+            auto out_ptr = reinterpret_cast<RawType *>(column->ptr());
+            for (const auto &match : matches) {
+                std::optional<RawType> value;
+                const auto &location = match ? right_rows.locations_[match->group_][col_idx] : std::nullopt;
+                if (location) {
+                    const auto &source = right_rows.segments_[match->group_][location->first];
+                    const auto &source_column = source.column(location->second);
+                    source_column.type().visit_tag([&] (auto source_tdt) {
+                        using SourceType = typename decltype(source_tdt)::DataTypeTag::raw_type;
+                        constexpr auto source_type = decltype(source_tdt)::DataTypeTag::data_type;
+                        auto source_value = source_column.template scalar_at<SourceType>(match->row_);
+                        if (!source_value)
+                            return;
+
+                        if constexpr (is_sequence_type(output_type) && is_sequence_type(source_type)) {
+                            if (is_a_string(*source_value))
+                                value = seg.string_pool().get(source.const_string_pool().get_view(*source_value)).offset();
+                        } else if constexpr (!is_sequence_type(output_type) && !is_sequence_type(source_type)) {
+                            value = static_cast<RawType>(*source_value);
+                        } else {
+                            util::raise_rte("Column {} changes between string and numeric types in the joined symbol", join_column.name_);
+                        }
+                    });
+                }
+
+                if constexpr (is_sequence_type(output_type))
+                    *out_ptr++ = value.value_or(not_a_string());
+                else if constexpr (std::is_floating_point_v<RawType>)
+                    *out_ptr++ = value.value_or(std::numeric_limits<RawType>::quiet_NaN());
+                else if constexpr (is_time_type(output_type))
+                    *out_ptr++ = value.value_or(std::numeric_limits<timestamp>::min());
+                else
+                    *out_ptr++ = value.value_or(RawType{});
+            }
+        });
+        if (num_rows > 0)
+            column->set_row_data(num_rows - 1);
+
+        seg.add_column(scalar_field_proto(join_column.output_type_, join_column.name_), column);
+        ++last.slice().col_range.second;
+    }
+}
+
+[[nodiscard]] Composite<ProcessingSegment>
+AsOfJoinClause::process(std::shared_ptr<Store> store, Composite<ProcessingSegment> &&p) const {
+    std::call_once(*add_columns_, [that = this]() {
+        auto &context = *that->execution_context_;
+        util::check(context.output_descriptor_.has_value() && context.output_descriptor_->index().type() == IndexDescriptor::TIMESTAMP,
+                    "As-of joins require a timestamp-indexed symbol");
+        util::check(that->right_->resolved() && that->right_->descriptor_->index().type() == IndexDescriptor::TIMESTAMP,
+                    "Cannot as-of join with symbol {} as it does not have a timestamp index", that->right_->symbol_);
+        *that->columns_ = join_columns(*that->right_, *context.output_descriptor_, std::nullopt, true);
+        for (const auto &column : *that->columns_)
+            context.check_output_column(column.name_, column.output_type_);
+    });
+
+    std::vector<timestamp> group_starts;
+    for (const auto &group : right_->row_groups_)
+        group_starts.push_back(std::get<NumericIndex>(group[0].key().start_index()));
+
+    auto procs = std::move(p);
+    procs.broadcast([&store, &group_starts, that = this](ProcessingSegment &proc) {
+        // Every column slice starts with the index column
+        const auto &index_seg = proc.data()[0].segment(store);
+        const auto num_rows = index_seg.row_count();
+        std::vector<timestamp> left_index(num_rows);
+        for (size_t row = 0; row < num_rows; ++row)
+            left_index[row] = index_seg.scalar_at<timestamp>(position_t(row), 0).value();
+
+        // The match for the first row is in the last right row slice starting at or before it, and no right row slice
+        // starting after the last row can match
+        std::vector<size_t> group_indices;
+        if (num_rows > 0) {
+            const auto end = std::upper_bound(std::begin(group_starts), std::end(group_starts), left_index.back());
+            auto begin = std::upper_bound(std::begin(group_starts), std::end(group_starts), left_index.front());
+            if (begin != std::begin(group_starts))
+                --begin;
+            for (auto it = begin; it < end; ++it)
+                group_indices.push_back(static_cast<size_t>(std::distance(std::begin(group_starts), it)));
+        }
+        auto right_rows = join_row_groups(*that->right_, group_indices, *that->columns_);
+
+        std::vector<std::optional<JoinedRow>> matches(num_rows);
+        std::optional<JoinedRow> current;
+        timestamp current_index = 0;
+        size_t group = 0;
+        size_t row = 0;
+        for (size_t left_row = 0; left_row < num_rows; ++left_row) {
+            const auto left_value = left_index[left_row];
+            while (group < right_rows.segments_.size()) {
+                const auto &right_index_seg = right_rows.segments_[group][0];
+                if (row >= right_index_seg.row_count()) {
+                    ++group;
+                    row = 0;
+                    continue;
+                }
+                const auto right_value = right_index_seg.scalar_at<timestamp>(position_t(row), 0).value();
+                if (right_value > left_value)
+                    break;
+
+                current = JoinedRow{group, row++};
+                current_index = right_value;
+            }
+            if (current && (!that->tolerance_ || left_value - current_index <= *that->tolerance_))
+                matches[left_row] = current;
+        }
+        append_join_columns(proc, store, *that->columns_, right_rows, matches);
+    });
+    return procs;
+}
+
+HashJoinClause::HashJoinClause(
+        std::shared_ptr<JoinInput> right,
+        std::string left_on,
+        std::string right_on,
+        JoinType how,
+        std::shared_ptr<ExecutionContext> execution_context) :
+        right_(std::move(right)),
+        left_on_(std::move(left_on)),
+        right_on_(std::move(right_on)),
+        how_(how),
+        execution_context_(std::move(execution_context)),
+        table_(std::make_shared<HashJoinTable>()) {
+}
+
+std::optional<std::pair<size_t, position_t>> find_column(ProcessingSegment &proc, const std::string &name, const std::shared_ptr<Store> &store) {
+    for (size_t slice_idx = 0; slice_idx < proc.data().size(); ++slice_idx) {
+        auto &seg = proc.data()[slice_idx].segment(store);
+        seg.init_column_map();
+        if (auto opt_idx = seg.column_index(name))
+            return std::make_pair(slice_idx, position_t(opt_idx.value()));
+    }
+    return std::nullopt;
+}
+
+[[nodiscard]] Composite<ProcessingSegment>
+HashJoinClause::process(std::shared_ptr<Store> store, Composite<ProcessingSegment> &&p) const {
+    std::call_once(*build_table_, [that = this]() {
+        auto &context = *that->execution_context_;
+        auto &table = *that->table_;
+        const auto &right = *that->right_;
+        util::check(context.output_descriptor_.has_value(), "Hash join executed without a descriptor");
+        util::check(right.resolved() && right.key_index_, "Join with symbol {} has not been resolved", right.symbol_);
+        auto left_key = context.output_descriptor_->find_field(that->left_on_);
+        util::check(left_key.has_value(), "Join key column {} not found", that->left_on_);
+        const auto left_type = data_type_from_proto(context.output_descriptor_->field(*left_key).type_desc());
+        util::check(right.key_index_->string_keys_ ? is_dynamic_string_type(left_type) : is_integral_join_key(left_type),
+                    "Cannot join column {} of type {} with column {} of symbol {}, keys must both be integral or both be dynamic strings",
+                    that->left_on_, left_type, that->right_on_, right.symbol_);
+
+        table.columns_ = join_columns(right, *context.output_descriptor_, that->right_on_, that->how_ == JoinType::LEFT);
+        std::vector<size_t> group_indices(right.segments_.size());
+        std::iota(std::begin(group_indices), std::end(group_indices), 0);
+        table.rows_ = join_row_groups(right, group_indices, table.columns_);
+
+        for (const auto &column : table.columns_)
+            context.check_output_column(column.name_, column.output_type_);
+    });
+
+    auto procs = std::move(p);
+    Composite<ProcessingSegment> output;
+    procs.broadcast([&store, &output, that = this](ProcessingSegment &proc) {
+        const auto &table = *that->table_;
+        const auto &key_index = *that->right_->key_index_;
+        auto key_location = find_column(proc, that->left_on_, store);
+        util::check(key_location.has_value(), "Join key column {} not found", that->left_on_);
+        const auto &key_segment = proc.data()[key_location->first].segment(store);
+        const auto &key_column = key_segment.column(key_location->second);
+        const auto num_rows = key_segment.row_count();
+
+        std::vector<std::optional<JoinedRow>> matches(num_rows);
+        for (size_t row = 0; row < num_rows; ++row) {
+            if (key_index.string_keys_) {
+                if (auto key = key_segment.string_at(position_t(row), key_location->second)) {
+                    if (auto it = key_index.string_index_.find(std::string{*key}); it != std::end(key_index.string_index_))
+                        matches[row] = it->second;
+                }
+            } else if (auto key = integral_key_at(key_column, row)) {
+                if (auto it = key_index.integral_index_.find(*key); it != std::end(key_index.integral_index_))
+                    matches[row] = it->second;
+            }
+        }
+
+        if (that->how_ == JoinType::INNER) {
+            util::BitSet bitset(static_cast<util::BitSet::size_type>(num_rows));
+            for (size_t row = 0; row < num_rows; ++row) {
+                if (matches[row])
+                    bitset.set(bv_size(row));
+            }
+            const auto matched = bitset.count();
+            if (matched == 0)
+                return;
+
+            if (matched < num_rows) {
+                proc.apply_filter(bitset, store);
+                matches.erase(std::remove_if(std::begin(matches), std::end(matches), [] (const auto &match) {
+                    return !match.has_value();
+                }), std::end(matches));
+            }
+        }
+        append_join_columns(proc, store, table.columns_, table.rows_, matches);
+        output.push_back(std::move(proc));
+    });
+    return output;
+}
+
+}
@@ -220,6 +220,111 @@ struct AggregationClause {
     repartition([[maybe_unused]] std::vector<Composite<ProcessingSegment>> &&comps) const { return std::nullopt; }
 };
 
+enum class ResampleBoundary {
+    left, right
+};
+
+/*
+ * Maps timestamps onto fixed-width time buckets, following the pandas resample conventions: buckets are aligned to
+ * offset_ (relative to the epoch), closed_ determines which edge of a bucket is inclusive, and label_ determines which
+ * edge is used as the output index value.
+ */
+struct TimeBucketer {
+    timestamp frequency_;
+    timestamp offset_;
+    ResampleBoundary closed_;
+    ResampleBoundary label_;
+
+    TimeBucketer(timestamp frequency, timestamp offset, ResampleBoundary closed, ResampleBoundary label) :
+        frequency_(frequency),
+        offset_(offset),
+        closed_(closed),
+        label_(label) {
+        util::check_arg(frequency_ > 0, "Resample frequency must be positive, got {}", frequency_);
+    }
+
+    [[nodiscard]] timestamp bucket_start(timestamp ts) const {
+        auto quotient = (ts - offset_) / frequency_;
+        auto remainder = (ts - offset_) % frequency_;
+        if (remainder < 0)
+            --quotient;
+        else if (remainder == 0 && closed_ == ResampleBoundary::right)
+            --quotient;
+
+        return quotient * frequency_ + offset_;
+    }
+
+    [[nodiscard]] timestamp bucket_label(timestamp start) const {
+        return label_ == ResampleBoundary::left ? start : start + frequency_;
+    }
+};
+
+inline StreamDescriptor resampled_descriptor() {
+    return StreamDescriptor{StreamId{"resampled"}, IndexDescriptor{1, IndexDescriptor::TIMESTAMP}, {}};
+}
+
+/*
+ * First half of a resample, analogous to PartitionClause for group-bys. Input to a resample is sorted on the
+ * timeseries index, so instead of hashing rows into buckets the repartition only has to keep together the row slices
+ * whose first and last time buckets overlap. Everything else can be resampled independently and in parallel.
+ */
+struct ResamplePartitionClause {
+    std::shared_ptr<ExecutionContext> execution_context_;
+    TimeBucketer bucketer_;
+
+    ResamplePartitionClause(std::shared_ptr<ExecutionContext> execution_context, TimeBucketer bucketer) :
+        execution_context_(std::move(execution_context)),
+        bucketer_(bucketer) {
+    }
+
+    [[nodiscard]] Composite<ProcessingSegment>
+    process(std::shared_ptr<Store> store, Composite<ProcessingSegment> &&p) const {
+        auto procs = std::move(p);
+        procs.broadcast([&store](auto &proc) {
+            // Make sure the segments are in memory, as repartition() has no access to the store
+            for (auto &slice_and_key : proc.data())
+                slice_and_key.ensure_segment(store);
+        });
+        return procs;
+    }
+
+    [[nodiscard]] std::shared_ptr<ExecutionContext> execution_context() const { return execution_context_; }
+
+    [[nodiscard]] bool requires_repartition() const { return true; }
+
+    [[nodiscard]] std::optional<std::vector<Composite<ProcessingSegment>>>
+    repartition(std::vector<Composite<ProcessingSegment>> &&c) const;
+};
+
+struct ResampleClause {
+    std::shared_ptr<ExecutionContext> execution_context_;
+    TimeBucketer bucketer_;
+    std::vector<AggregationFactory> aggregation_operators_;
+    std::shared_ptr<std::once_flag> reset_descriptor_ = std::make_shared<std::once_flag>();
+    ResampleClause() = delete;
+
+    ARCTICDB_MOVE_COPY_DEFAULT(ResampleClause)
+
+    ResampleClause(std::shared_ptr<ExecutionContext> execution_context,
+                   TimeBucketer bucketer,
+                   std::vector<AggregationFactory> &&aggregation_operators) :
+        execution_context_(std::move(execution_context)),
+        bucketer_(bucketer),
+        aggregation_operators_(std::move(aggregation_operators)) {
+    }
+
+    [[nodiscard]] Composite<ProcessingSegment>
+    process(std::shared_ptr<Store> store, Composite<ProcessingSegment> &&p) const;
+
+    [[nodiscard]] std::shared_ptr<ExecutionContext> execution_context() const { return execution_context_; }
+
+    // Repartitions only to give the buckets of each partition their place in the output
+    [[nodiscard]] bool requires_repartition() const { return true; }
+
+    [[nodiscard]] std::optional<std::vector<Composite<ProcessingSegment>>>
+    repartition(std::vector<Composite<ProcessingSegment>> &&c) const;
+};
+
 struct PassthroughClause {
     [[nodiscard]] Composite<ProcessingSegment>
     process([[maybe_unused]] const std::shared_ptr<Store> &store, Composite<ProcessingSegment> &&p) const {
@@ -362,6 +467,35 @@ struct SortClause {
     [[nodiscard]] bool requires_repartition() const { return false; }
 };
 
+/*
+ * Produces output that is ordered on column_ across the whole symbol, unlike SortClause above which only orders the
+ * rows within each segment. Each row slice is sorted in parallel in process(), and repartition() then does a k-way merge
+ * of the sorted runs, cutting the output into new row slices of Sort.SegmentSize rows that are processed in parallel by
+ * any subsequent clauses. Rows with equal values keep their original relative order, and NaNs are placed last.
+ *
+ * If limit_ is set then only the first limit_ rows are required: each run is truncated to limit_ rows before the merge,
+ * and the merge stops as soon as limit_ rows have been produced, so the full sorted set is never materialised.
+ */
+struct GlobalSortClause {
+    std::string column_;
+    std::optional<size_t> limit_;
+
+    explicit GlobalSortClause(std::string column, std::optional<size_t> limit = std::nullopt) :
+            column_(std::move(column)),
+            limit_(limit) {
+    }
+
+    [[nodiscard]] Composite<ProcessingSegment>
+    process(std::shared_ptr<Store> store, Composite<ProcessingSegment> &&p) const;
+
+    [[nodiscard]] std::shared_ptr<ExecutionContext> execution_context() const { return nullptr; }
+
+    [[nodiscard]] std::optional<std::vector<Composite<ProcessingSegment>>>
+    repartition(std::vector<Composite<ProcessingSegment>> &&comps) const;
+
+    [[nodiscard]] bool requires_repartition() const { return true; }
+};
+
 struct ProjectClause {
     //TODO can't use root node name all the time, do something like this
     //const std::shared_ptr<std::map<std::string, std::string>> projections_;
@@ -387,11 +521,148 @@ struct ProjectClause {
     [[nodiscard]] bool requires_repartition() const { return false; }
 };
 
+struct JoinKeyIndex;
+
+/*
+ * The right-hand side of a join: another symbol, resolved to one of its versions and read into memory by the version
+ * engine before the query runs, so that join clauses never wait on storage from the CPU thread pool. Slices are
+ * grouped by row range, so that each entry of row_groups_ and segments_ holds every column slice for those rows. When
+ * the join is on a key column, the rows are also indexed by key on resolution. Shared between copies of a join clause,
+ * and read-only once resolved.
+ */
+struct JoinInput {
+    StreamId symbol_;
+    std::optional<VersionId> version_id_;
+    std::vector<std::string> columns_; // empty <=> all non-index columns
+    std::optional<std::string> key_column_;
+    std::optional<StreamDescriptor> descriptor_;
+    std::vector<std::vector<pipelines::SliceAndKey>> row_groups_;
+    std::vector<std::vector<SegmentInMemory>> segments_;
+    std::shared_ptr<JoinKeyIndex> key_index_;
+
+    JoinInput(StreamId symbol,
+              std::optional<VersionId> version_id,
+              std::vector<std::string> columns,
+              std::optional<std::string> key_column = std::nullopt) :
+            symbol_(std::move(symbol)),
+            version_id_(version_id),
+            columns_(std::move(columns)),
+            key_column_(std::move(key_column)) {
+    }
+
+    ARCTICDB_NO_MOVE_OR_COPY(JoinInput)
+
+    void resolve(const std::shared_ptr<Store>& store, const AtomKey& index_key);
+
+    [[nodiscard]] bool resolved() const {
+        return descriptor_.has_value();
+    }
+};
+
+// A column added to the left-hand side by a join
+struct JoinColumn {
+    std::string name_;
+    DataType source_type_;
+    DataType output_type_;
+};
+
+/*
+ * Joins each row to the last row of another timeseries symbol with an index value less than or equal to its own, as
+ * with pandas.merge_asof. The right-hand side is read into memory in full when the join is resolved, before the query
+ * runs. Both sides are sorted on their index, so each left row slice only visits the right row slices overlapping its
+ * own index range (plus the one preceding it), and matches them with a single merge pass. Rows with no match, or only
+ * a match older than the tolerance, get missing values, so integral right columns are widened to float.
+ */
+struct AsOfJoinClause {
+    std::shared_ptr<JoinInput> right_;
+    std::optional<timestamp> tolerance_;
+    std::shared_ptr<ExecutionContext> execution_context_;
+    std::shared_ptr<std::vector<JoinColumn>> columns_ = std::make_shared<std::vector<JoinColumn>>();
+    std::shared_ptr<std::once_flag> add_columns_ = std::make_shared<std::once_flag>();
+
+    AsOfJoinClause(std::shared_ptr<JoinInput> right,
+                   std::optional<timestamp> tolerance,
+                   std::shared_ptr<ExecutionContext> execution_context) :
+            right_(std::move(right)),
+            tolerance_(tolerance),
+            execution_context_(std::move(execution_context)) {
+    }
+
+    [[nodiscard]] Composite<ProcessingSegment>
+    process(std::shared_ptr<Store> store, Composite<ProcessingSegment> &&p) const;
+
+    [[nodiscard]] std::shared_ptr<ExecutionContext> execution_context() const { return execution_context_; }
+
+    [[nodiscard]] std::optional<std::vector<Composite<ProcessingSegment>>>
+    repartition([[maybe_unused]] std::vector<Composite<ProcessingSegment>> &&comps) const { return std::nullopt; }
+
+    [[nodiscard]] bool requires_repartition() const { return false; }
+};
+
+enum class JoinType {
+    INNER,
+    LEFT
+};
+
+struct HashJoinTable;
+
+/*
+ * Joins rows to another symbol on equality of a key column. The right-hand side is the build side: it is read in
+ * full and indexed by key when the join is resolved, and must have unique keys. Left row slices then probe the index
+ * independently, so the output keeps the row slicing of the left-hand side. Integral and timestamp keys may be joined
+ * with each other, as may string keys.
+ */
+struct HashJoinClause {
+    std::shared_ptr<JoinInput> right_;
+    std::string left_on_;
+    std::string right_on_;
+    JoinType how_;
+    std::shared_ptr<ExecutionContext> execution_context_;
+    std::shared_ptr<HashJoinTable> table_;
+    std::shared_ptr<std::once_flag> build_table_ = std::make_shared<std::once_flag>();
+
+    HashJoinClause(std::shared_ptr<JoinInput> right,
+                   std::string left_on,
+                   std::string right_on,
+                   JoinType how,
+                   std::shared_ptr<ExecutionContext> execution_context);
+
+    [[nodiscard]] Composite<ProcessingSegment>
+    process(std::shared_ptr<Store> store, Composite<ProcessingSegment> &&p) const;
+
+    [[nodiscard]] std::shared_ptr<ExecutionContext> execution_context() const { return execution_context_; }
+
+    [[nodiscard]] std::optional<std::vector<Composite<ProcessingSegment>>>
+    repartition([[maybe_unused]] std::vector<Composite<ProcessingSegment>> &&comps) const { return std::nullopt; }
+
+    [[nodiscard]] bool requires_repartition() const { return false; }
+};
+
+/*
+ * A limit on the number of rows in the output of the whole clause pipeline, taken from the start (head) or the end
+ * (tail) of the index-ordered result. Unlike HeadRange/TailRange, which restrict the rows that are read before any
+ * clauses run, this is applied after filtering, so it gives e.g. the first n rows matching a filter.
+ */
+struct RowLimit {
+    size_t num_rows_;
+    bool from_end_;
+};
+
 class ClauseBuilder {
 private:
     std::vector<Clause> clauses_;
     std::shared_ptr<ExecutionContext> execution_context_;
     std::vector<AggregationFactory> operators_;
+    std::optional<TimeBucketer> bucketer_;
+    std::optional<RowLimit> row_limit_;
+    std::vector<std::shared_ptr<JoinInput>> join_inputs_;
+
+    std::shared_ptr<ExecutionContext> join_execution_context(const std::shared_ptr<ExecutionContext>& ec) const {
+        // An execution context only receives the symbol's descriptor when its clause is first in the pipeline, so
+        // joins must come first, and consecutive joins share the first one's context
+        util::check(clauses_.size() == join_inputs_.size(), "Joins must come before any other clause in a query");
+        return clauses_.empty() ? ec : clauses_.front().execution_context();
+    }
 
 public:
     void add_ProjectClause(const std::string& column_name, const std::shared_ptr<ExecutionContext>& ec) {
@@ -402,6 +673,10 @@ public:
         clauses_.emplace_back(FilterClause(ec));
     }
 
+    void add_GlobalSortClause(const std::string& column_name, std::optional<size_t> limit) {
+        clauses_.emplace_back(GlobalSortClause(column_name, limit));
+    }
+
     void prepare_AggregationClause(const std::shared_ptr<ExecutionContext>& ec) {
         execution_context_ = ec;
         if (!operators_.empty()) {
@@ -427,6 +702,14 @@ public:
         operators_.emplace_back(MaxOrMin{std::move(input), std::move(output), Extremum::min});
     }
 
+    void add_FirstAggregationOperator(ColumnName &&input, ColumnName &&output) {
+        operators_.emplace_back(FirstOrLast{std::move(input), std::move(output), Occurrence::first});
+    }
+
+    void add_LastAggregationOperator(ColumnName &&input, ColumnName &&output) {
+        operators_.emplace_back(FirstOrLast{std::move(input), std::move(output), Occurrence::last});
+    }
+
     void finalize_AggregationClause() {
         // TODO: Complete hack. Two clauses shouldn't share an EC.
         clauses_.emplace_back(
@@ -435,9 +718,71 @@ public:
         execution_context_.reset();
     }
 
+    void prepare_ResampleClause(const std::shared_ptr<ExecutionContext>& ec,
+                                timestamp frequency,
+                                timestamp offset,
+                                ResampleBoundary closed,
+                                ResampleBoundary label) {
+        prepare_AggregationClause(ec);
+        bucketer_.emplace(frequency, offset, closed, label);
+    }
+
+    void finalize_ResampleClause() {
+        util::check(bucketer_.has_value(), "Resample clause finalised without being prepared");
+        // As with aggregations, the partitioning clause shares the execution context so that it receives the descriptor
+        // when it is the first clause in the pipeline
+        clauses_.emplace_back(ResamplePartitionClause{execution_context_, *bucketer_});
+        clauses_.emplace_back(ResampleClause{execution_context_, *bucketer_, std::move(operators_)});
+        execution_context_.reset();
+        bucketer_.reset();
+    }
+
     [[nodiscard]] std::vector<Clause> get_clauses() const {
         return clauses_;
     }
+
+    void add_AsOfJoinClause(const StreamId& symbol,
+                            std::optional<VersionId> version_id,
+                            const std::vector<std::string>& columns,
+                            std::optional<timestamp> tolerance,
+                            const std::shared_ptr<ExecutionContext>& ec) {
+        util::check(!tolerance || *tolerance >= 0, "As-of join tolerance must be non-negative");
+        auto context = join_execution_context(ec);
+        auto right = std::make_shared<JoinInput>(symbol, version_id, columns);
+        join_inputs_.push_back(right);
+        clauses_.emplace_back(AsOfJoinClause{std::move(right), tolerance, std::move(context)});
+    }
+
+    void add_HashJoinClause(const StreamId& symbol,
+                            std::optional<VersionId> version_id,
+                            const std::vector<std::string>& columns,
+                            const std::string& left_on,
+                            const std::string& right_on,
+                            JoinType how,
+                            const std::shared_ptr<ExecutionContext>& ec) {
+        auto context = join_execution_context(ec);
+        auto right = std::make_shared<JoinInput>(symbol, version_id, columns, right_on);
+        join_inputs_.push_back(right);
+        clauses_.emplace_back(HashJoinClause{std::move(right), left_on, right_on, how, std::move(context)});
+    }
+
+    [[nodiscard]] std::vector<std::shared_ptr<JoinInput>> get_join_inputs() const {
+        return join_inputs_;
+    }
+
+    void set_HeadLimit(size_t n) {
+        util::check(n > 0, "Row limit must be positive");
+        row_limit_ = RowLimit{n, false};
+    }
+
+    void set_TailLimit(size_t n) {
+        util::check(n > 0, "Row limit must be positive");
+        row_limit_ = RowLimit{n, true};
+    }
+
+    [[nodiscard]] std::optional<RowLimit> get_row_limit() const {
+        return row_limit_;
+    }
 };
 
 struct RemoveColumnPartitioningClause {
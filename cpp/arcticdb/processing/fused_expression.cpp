@@ -0,0 +1,427 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/processing/fused_expression.hpp>
+#include <arcticdb/processing/processing_segment.hpp>
+#include <arcticdb/processing/operation_types.hpp>
+#include <arcticdb/processing/operation_dispatch.hpp>
+#include <arcticdb/entity/type_conversion.hpp>
+#include <arcticdb/util/configs_map.hpp>
+
+namespace arcticdb {
+
+namespace {
+
+// Number of rows evaluated per pass through the kernels. Small enough that the registers of a typical expression
+// stay resident in L1/L2 between one kernel and the next
+constexpr size_t FusedChunkSize = 2048;
+
+using KernelAndType = std::pair<FusedExpression::Kernel, DataType>;
+
+template<typename Func, typename T, typename V>
+void unary_arithmetic_kernel(const uint8_t* left, const uint8_t*, uint8_t* output, size_t num_rows) {
+    auto l = reinterpret_cast<const T*>(left);
+    auto out = reinterpret_cast<V*>(output);
+    Func func;
+    for (size_t i = 0; i < num_rows; ++i)
+        out[i] = func.apply(l[i]);
+}
+
+template<typename Func, typename L, typename R, typename V>
+void binary_arithmetic_kernel(const uint8_t* left, const uint8_t* right, uint8_t* output, size_t num_rows) {
+    auto l = reinterpret_cast<const L*>(left);
+    auto r = reinterpret_cast<const R*>(right);
+    auto out = reinterpret_cast<V*>(output);
+    Func func;
+    for (size_t i = 0; i < num_rows; ++i)
+        out[i] = func.apply(l[i], r[i]);
+}
+
+template<typename Func, typename L, typename R>
+void comparison_kernel(const uint8_t* left, const uint8_t* right, uint8_t* output, size_t num_rows) {
+    using comp = typename arcticdb::Comparable<L, R>;
+    auto l = reinterpret_cast<const L*>(left);
+    auto r = reinterpret_cast<const R*>(right);
+    const Func func{};
+    for (size_t i = 0; i < num_rows; ++i)
+        output[i] = func(static_cast<typename comp::left_type>(l[i]), static_cast<typename comp::right_type>(r[i])) ? 1 : 0;
+}
+
+template<OperationType operation>
+void boolean_kernel(const uint8_t* left, const uint8_t* right, uint8_t* output, size_t num_rows) {
+    for (size_t i = 0; i < num_rows; ++i) {
+        const bool l = left[i] != 0;
+        if constexpr (operation == OperationType::IDENTITY) {
+            output[i] = l;
+        } else if constexpr (operation == OperationType::NOT) {
+            output[i] = !l;
+        } else {
+            const bool r = right[i] != 0;
+            if constexpr (operation == OperationType::AND)
+                output[i] = l && r;
+            else if constexpr (operation == OperationType::OR)
+                output[i] = l || r;
+            else
+                output[i] = l != r;
+        }
+    }
+}
+
+template<typename Func>
+std::optional<KernelAndType> unary_arithmetic_kernel_for(DataType data_type) {
+    std::optional<KernelAndType> result;
+    if (!is_numeric_type(data_type))
+        return result;
+
+    details::visit_type(data_type, [&result](auto tag) {
+        using TagType = decltype(tag);
+        if constexpr (is_numeric_type(TagType::data_type)) {
+            using RawType = typename TagType::raw_type;
+            using TargetType = typename unary_arithmetic_promoted_type<RawType, Func>::type;
+            result = KernelAndType{&unary_arithmetic_kernel<Func, RawType, TargetType>, data_type_from_raw_type<TargetType>()};
+        }
+    });
+    return result;
+}
+
+template<typename Callable>
+void visit_numeric_pair(DataType left, DataType right, Callable&& callable) {
+    if (!is_numeric_type(left) || !is_numeric_type(right))
+        return;
+
+    details::visit_type(left, [&](auto left_tag) {
+        using LeftTagType = decltype(left_tag);
+        if constexpr (is_numeric_type(LeftTagType::data_type)) {
+            details::visit_type(right, [&](auto right_tag) {
+                using RightTagType = decltype(right_tag);
+                if constexpr (is_numeric_type(RightTagType::data_type)) {
+                    callable(left_tag, right_tag);
+                }
+            });
+        }
+    });
+}
+
+template<typename Func>
+std::optional<KernelAndType> binary_arithmetic_kernel_for(DataType left, DataType right) {
+    std::optional<KernelAndType> result;
+    visit_numeric_pair(left, right, [&result](auto left_tag, auto right_tag) {
+        using LeftType = typename decltype(left_tag)::raw_type;
+        using RightType = typename decltype(right_tag)::raw_type;
+        using TargetType = typename type_arithmetic_promoted_type<LeftType, RightType, Func>::type;
+        result = KernelAndType{&binary_arithmetic_kernel<Func, LeftType, RightType, TargetType>, data_type_from_raw_type<TargetType>()};
+    });
+    return result;
+}
+
+template<typename Func>
+std::optional<KernelAndType> comparison_kernel_for(DataType left, DataType right) {
+    std::optional<KernelAndType> result;
+    visit_numeric_pair(left, right, [&result](auto left_tag, auto right_tag) {
+        using LeftType = typename decltype(left_tag)::raw_type;
+        using RightType = typename decltype(right_tag)::raw_type;
+        result = KernelAndType{&comparison_kernel<Func, LeftType, RightType>, DataType::BOOL8};
+    });
+    return result;
+}
+
+template<OperationType operation>
+std::optional<KernelAndType> boolean_kernel_for(DataType left, DataType right) {
+    if (!is_bool_type(left) || !is_bool_type(right))
+        return std::nullopt;
+
+    return KernelAndType{&boolean_kernel<operation>, DataType::BOOL8};
+}
+
+std::optional<KernelAndType> unary_kernel_for(OperationType operation, DataType data_type) {
+    switch (operation) {
+    case OperationType::ABS:
+        return unary_arithmetic_kernel_for<AbsOperator>(data_type);
+    case OperationType::NEG:
+        return unary_arithmetic_kernel_for<NegOperator>(data_type);
+    case OperationType::IDENTITY:
+        return boolean_kernel_for<OperationType::IDENTITY>(data_type, data_type);
+    case OperationType::NOT:
+        return boolean_kernel_for<OperationType::NOT>(data_type, data_type);
+    default:
+        return std::nullopt;
+    }
+}
+
+std::optional<KernelAndType> binary_kernel_for(OperationType operation, DataType left, DataType right) {
+    switch (operation) {
+    case OperationType::ADD:
+        return binary_arithmetic_kernel_for<PlusOperator>(left, right);
+    case OperationType::SUB:
+        return binary_arithmetic_kernel_for<MinusOperator>(left, right);
+    case OperationType::MUL:
+        return binary_arithmetic_kernel_for<TimesOperator>(left, right);
+    case OperationType::DIV:
+        return binary_arithmetic_kernel_for<DivideOperator>(left, right);
+    case OperationType::EQ:
+        return comparison_kernel_for<EqualsOperator>(left, right);
+    case OperationType::NE:
+        return comparison_kernel_for<NotEqualsOperator>(left, right);
+    case OperationType::LT:
+        return comparison_kernel_for<LessThanOperator>(left, right);
+    case OperationType::LE:
+        return comparison_kernel_for<LessThanEqualsOperator>(left, right);
+    case OperationType::GT:
+        return comparison_kernel_for<GreaterThanOperator>(left, right);
+    case OperationType::GE:
+        return comparison_kernel_for<GreaterThanEqualsOperator>(left, right);
+    case OperationType::AND:
+        return boolean_kernel_for<OperationType::AND>(left, right);
+    case OperationType::OR:
+        return boolean_kernel_for<OperationType::OR>(left, right);
+    case OperationType::XOR:
+        return boolean_kernel_for<OperationType::XOR>(left, right);
+    default:
+        return std::nullopt;
+    }
+}
+
+bool is_comparison_operation(OperationType operation) {
+    switch (operation) {
+    case OperationType::EQ:
+    case OperationType::NE:
+    case OperationType::LT:
+    case OperationType::LE:
+    case OperationType::GT:
+    case OperationType::GE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void broadcast_value(const Value& value, uint8_t* output, size_t num_rows) {
+    details::visit_type(value.data_type_, [&](auto tag) {
+        using TagType = decltype(tag);
+        if constexpr (is_numeric_type(TagType::data_type)) {
+            using RawType = typename TagType::raw_type;
+            std::fill_n(reinterpret_cast<RawType*>(output), num_rows, *reinterpret_cast<const RawType*>(value.data_));
+        } else {
+            util::raise_rte("Unexpected non-numeric value of type {} in fused expression", value.type());
+        }
+    });
+}
+
+// The blocks of a column register, with the first row of each block so that chunks never straddle two blocks
+struct ColumnBlocks {
+    std::vector<size_t> first_rows_;
+    std::vector<const uint8_t*> data_;
+    size_t current_ = 0;
+
+    ColumnBlocks(const Column& column, size_t num_rows) {
+        const auto type_size = get_type_size(column.type().data_type());
+        auto column_data = column.data();
+        size_t row = 0;
+        for (const auto& block : column_data.buffer().blocks()) {
+            const auto block_rows = block->bytes() / type_size;
+            if (block_rows == 0)
+                continue;
+
+            first_rows_.push_back(row);
+            data_.push_back(block->data());
+            row += block_rows;
+        }
+        util::check(row == num_rows, "Column blocks contain {} rows, expected {} in fused expression", row, num_rows);
+        first_rows_.push_back(row);
+    }
+
+    // Returns the data for the given row, and the first row after the end of the block containing it
+    std::pair<const uint8_t*, size_t> seek(size_t row, size_t type_size) {
+        while (first_rows_[current_ + 1] <= row)
+            ++current_;
+
+        return {data_[current_] + (row - first_rows_[current_]) * type_size, first_rows_[current_ + 1]};
+    }
+};
+
+} // namespace
+
+size_t FusedExpression::add_register(Register&& reg) {
+    registers_.emplace_back(std::move(reg));
+    return registers_.size() - 1;
+}
+
+std::optional<size_t> FusedExpression::compile_node(
+        const VariantNode& node,
+        ProcessingSegment& seg,
+        const std::shared_ptr<Store>& store) {
+    return util::variant_match(node,
+        [&](const ColumnName&) -> std::optional<size_t> {
+            auto data = seg.get(node, store);
+            auto column_with_strings = std::get_if<ColumnWithStrings>(&data);
+            if (!column_with_strings)
+                return std::nullopt;
+
+            const auto& column = column_with_strings->column_;
+            const auto data_type = column->type().data_type();
+            if (column->is_sparse() || column->type().dimension() != Dimension::Dim0 || !(is_numeric_type(data_type) || is_bool_type(data_type)))
+                return std::nullopt;
+
+            const auto row_count = static_cast<size_t>(column->row_count());
+            if (row_count_ && *row_count_ != row_count)
+                return std::nullopt;
+
+            row_count_ = row_count;
+            return add_register({RegisterSource::COLUMN, data_type, column, {}});
+        },
+        [&](const ValueName&) -> std::optional<size_t> {
+            auto data = seg.get(node, store);
+            auto value = std::get_if<std::shared_ptr<Value>>(&data);
+            if (!value || !is_numeric_type((*value)->data_type_))
+                return std::nullopt;
+
+            return add_register({RegisterSource::CONSTANT, (*value)->data_type_, {}, *value});
+        },
+        [&](const ExpressionName& expression_name) -> std::optional<size_t> {
+            if (seg.unfused_expressions_.count(expression_name.value) > 0)
+                return std::nullopt;
+
+            auto output = compile_expression(expression_name, seg, store);
+            if (!output)
+                seg.unfused_expressions_.insert(expression_name.value);
+
+            return output;
+        },
+        [](const auto&) -> std::optional<size_t> {
+            return std::nullopt;
+        });
+}
+
+std::optional<size_t> FusedExpression::compile_expression(
+        const ExpressionName& expression_name,
+        ProcessingSegment& seg,
+        const std::shared_ptr<Store>& store) {
+    auto expression_node = seg.execution_context_->expression_nodes_.get_value(expression_name.value);
+    const auto operation = expression_node->operation_type_;
+    auto left = compile_node(expression_node->left_, seg, store);
+    if (!left)
+        return std::nullopt;
+
+    std::optional<KernelAndType> kernel;
+    auto right = *left;
+    if (is_binary_operation(operation)) {
+        auto opt_right = compile_node(expression_node->right_, seg, store);
+        if (!opt_right)
+            return std::nullopt;
+
+        right = *opt_right;
+        // Comparing two values is rejected by the node by node evaluation, leave it to raise
+        if (is_comparison_operation(operation) &&
+            registers_[*left].source_ == RegisterSource::CONSTANT &&
+            registers_[right].source_ == RegisterSource::CONSTANT)
+            return std::nullopt;
+
+        kernel = binary_kernel_for(operation, registers_[*left].data_type_, registers_[right].data_type_);
+    } else {
+        kernel = unary_kernel_for(operation, registers_[*left].data_type_);
+    }
+
+    if (!kernel)
+        return std::nullopt;
+
+    auto output = add_register({RegisterSource::COMPUTED, kernel->second, {}, {}});
+    instructions_.emplace_back(Instruction{kernel->first, *left, right, output});
+    return output;
+}
+
+std::optional<FusedExpression> FusedExpression::compile(
+        const ExpressionName& root,
+        ProcessingSegment& seg,
+        const std::shared_ptr<Store>& store) {
+    FusedExpression expression;
+    auto output = expression.compile_node(VariantNode{root}, seg, store);
+    if (!output || expression.instructions_.size() < 2 || !expression.row_count_ || *expression.row_count_ == 0)
+        return std::nullopt;
+
+    return expression;
+}
+
+VariantData FusedExpression::evaluate() const {
+    const auto num_rows = *row_count_;
+    const auto result = instructions_.back().output_;
+    const auto result_type = registers_[result].data_type_;
+    const auto result_type_size = get_type_size(result_type);
+
+    std::vector<std::vector<uint8_t>> buffers(registers_.size());
+    std::vector<std::optional<ColumnBlocks>> column_blocks(registers_.size());
+    std::vector<const uint8_t*> inputs(registers_.size());
+    for (size_t i = 0; i < registers_.size(); ++i) {
+        const auto& reg = registers_[i];
+        switch (reg.source_) {
+        case RegisterSource::COLUMN:
+            column_blocks[i].emplace(*reg.column_, num_rows);
+            break;
+        case RegisterSource::CONSTANT:
+            buffers[i].resize(FusedChunkSize * get_type_size(reg.data_type_));
+            broadcast_value(*reg.value_, buffers[i].data(), FusedChunkSize);
+            inputs[i] = buffers[i].data();
+            break;
+        case RegisterSource::COMPUTED:
+            buffers[i].resize(FusedChunkSize * get_type_size(reg.data_type_));
+            inputs[i] = buffers[i].data();
+            break;
+        }
+    }
+
+    const bool is_filter = is_bool_type(result_type);
+    std::shared_ptr<util::BitSet> bitset;
+    std::optional<util::BitSet::bulk_insert_iterator> inserter;
+    std::unique_ptr<Column> column;
+    if (is_filter) {
+        bitset = std::make_shared<util::BitSet>(static_cast<util::BitSetSizeType>(num_rows));
+        inserter.emplace(*bitset);
+    } else {
+        column = std::make_unique<Column>(make_scalar_type(result_type), false);
+    }
+
+    for (size_t row = 0; row < num_rows;) {
+        auto chunk_end = std::min(row + FusedChunkSize, num_rows);
+        for (size_t i = 0; i < registers_.size(); ++i) {
+            if (column_blocks[i]) {
+                auto [data, block_end] = column_blocks[i]->seek(row, get_type_size(registers_[i].data_type_));
+                inputs[i] = data;
+                chunk_end = std::min(chunk_end, block_end);
+            }
+        }
+
+        const auto chunk_rows = chunk_end - row;
+        for (const auto& instruction : instructions_)
+            instruction.kernel_(inputs[instruction.left_], inputs[instruction.right_], buffers[instruction.output_].data(), chunk_rows);
+
+        const auto output = buffers[result].data();
+        if (is_filter) {
+            for (size_t i = 0; i < chunk_rows; ++i) {
+                if (output[i])
+                    *inserter = static_cast<util::BitSetSizeType>(row + i);
+            }
+        } else {
+            const auto nbytes = chunk_rows * result_type_size;
+            memcpy(column->allocate_data(nbytes), output, nbytes);
+            column->advance_data(nbytes);
+        }
+        row = chunk_end;
+    }
+
+    if (is_filter) {
+        inserter->flush();
+        return transform_to_placeholder(VariantData{std::move(bitset)});
+    }
+
+    column->set_row_data(num_rows - 1);
+    return VariantData{ColumnWithStrings(std::move(column))};
+}
+
+bool fused_expressions_enabled() {
+    return ConfigsMap::instance()->get_int("Expression.Fused", 1) != 0;
+}
+
+} //namespace arcticdb
@@ -0,0 +1,82 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include <arcticdb/processing/expression_node.hpp>
+#include <arcticdb/entity/types.hpp>
+
+namespace arcticdb {
+
+/*
+ * A tree of ExpressionNodes compiled into a flat list of typed kernels over a set of registers, so that a compound
+ * filter or projection such as ((a * 2 + b) > c) & (d < 5) is evaluated in a single pass over its input columns in
+ * cache-sized chunks, rather than materialising a full length column or bitset for every intermediate node.
+ *
+ * Only dense numeric and bool columns, numeric values, and the arithmetic, comparison, and boolean operators can be
+ * fused. compile returns std::nullopt for anything else (strings, value sets, sparse or missing columns, or trees with
+ * a single operation, where there is nothing to fuse), in which case the caller evaluates the tree node by node. Nodes
+ * whose subtrees can't be fused are recorded in the segment's unfused_expressions_, so that evaluating the tree node by
+ * node doesn't compile each subtree again. The kernels use the same type promotion rules and operator structs as
+ * operation_dispatch, so the results are identical.
+ */
+class FusedExpression {
+public:
+    using Kernel = void (*)(const uint8_t* left, const uint8_t* right, uint8_t* output, size_t num_rows);
+
+    static std::optional<FusedExpression> compile(
+        const ExpressionName& root,
+        ProcessingSegment& seg,
+        const std::shared_ptr<Store>& store);
+
+    VariantData evaluate() const;
+
+    size_t num_operations() const {
+        return instructions_.size();
+    }
+
+private:
+    enum class RegisterSource {
+        COLUMN,
+        CONSTANT,
+        COMPUTED
+    };
+
+    struct Register {
+        RegisterSource source_;
+        DataType data_type_;
+        std::shared_ptr<Column> column_;
+        std::shared_ptr<Value> value_;
+    };
+
+    struct Instruction {
+        Kernel kernel_;
+        size_t left_;
+        size_t right_;
+        size_t output_;
+    };
+
+    FusedExpression() = default;
+
+    std::optional<size_t> compile_node(const VariantNode& node, ProcessingSegment& seg, const std::shared_ptr<Store>& store);
+
+    std::optional<size_t> compile_expression(const ExpressionName& expression_name, ProcessingSegment& seg, const std::shared_ptr<Store>& store);
+
+    size_t add_register(Register&& reg);
+
+    std::vector<Register> registers_;
+    std::vector<Instruction> instructions_;
+    std::optional<size_t> row_count_;
+};
+
+// Controlled by the Expression.Fused config, defaults to enabled
+bool fused_expressions_enabled();
+
+} //namespace arcticdb
@@ -6,6 +6,7 @@
  */
 
 #include <arcticdb/processing/processing_segment.hpp>
+#include <arcticdb/processing/fused_expression.hpp>
 
 namespace arcticdb {
 void ProcessingSegment::apply_filter(const util::BitSet& bitset,
@@ -35,11 +36,16 @@ VariantData ProcessingSegment::get(const VariantNode &name, const std::shared_pt
         for (auto &slice_and_key: data_) {
             slice_and_key.segment(store).init_column_map();
             if (auto opt_idx = slice_and_key.segment(store).column_index(
-                column_name.value))
+                column_name.value)) {
+                auto column = slice_and_key.segment(store).column_ptr(position_t(opt_idx.value()));
+                // A column with no values in this segment matches nothing, as if the segment didn't have it
+                if (column->is_all_null() && execution_context_->dynamic_schema())
+                    return VariantData{EmptyResult{}};
+
                 return VariantData(ColumnWithStrings(
-                    slice_and_key.segment(store).column_ptr(
-                        position_t(position_t(opt_idx.value()))),
-                        slice_and_key.segment(store).string_pool_ptr()));
+                    std::move(column),
+                    slice_and_key.segment(store).string_pool_ptr()));
+            }
         }
         // Try multi-index column names
         std::string multi_index_column_name = fmt::format("__idx__{}",
@@ -70,8 +76,14 @@ VariantData ProcessingSegment::get(const VariantNode &name, const std::shared_pt
         computed != std::end(computed_data_)) {
             return computed->second;
         } else {
-            auto expr = execution_context_->expression_nodes_.get_value(expression_name.value);
-            auto data = expr->compute(self(), store);
+            // Compound numeric trees are evaluated in one pass where possible, anything else node by node
+            std::optional<FusedExpression> fused_expression;
+            if (fused_expressions_enabled())
+                fused_expression = FusedExpression::compile(expression_name, self(), store);
+
+            auto data = fused_expression ?
+                fused_expression->evaluate() :
+                execution_context_->expression_nodes_.get_value(expression_name.value)->compute(self(), store);
             computed_data_.try_emplace(expression_name.value, data);
             return data;
         }
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <fmt/core.h>
@@ -50,6 +51,9 @@ namespace arcticdb {
         std::vector<pipelines::SliceAndKey> data_;
         std::shared_ptr<ExecutionContext> execution_context_;
         std::unordered_map<std::string, VariantData> computed_data_;
+        // Expression nodes whose subtrees could not be fused, so that they are not compiled again when the nodes of a
+        // tree that could not be fused are evaluated one by one
+        std::unordered_set<std::string> unfused_expressions_;
 
         // Set by PartitioningClause
         std::optional<size_t> bucket_;
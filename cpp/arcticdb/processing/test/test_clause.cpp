@@ -226,3 +226,183 @@ TEST(Clause, Merge) {
         }
     }
 }
+
+TEST(Clause, Resample) {
+    using namespace arcticdb;
+    std::shared_ptr<Store> empty;
+    const auto num_rows = 20;
+    const auto split_rows = 5;
+    auto seg = get_standard_timeseries_segment("resample", num_rows);
+    auto context = std::make_shared<ExecutionContext>();
+    context->set_descriptor(seg.descriptor());
+
+    // Buckets of width 3 straddle the row slices, so the repartition has to chain them together
+    TimeBucketer bucketer{3, 0, ResampleBoundary::left, ResampleBoundary::left};
+    ResamplePartitionClause partition_clause{context, bucketer};
+    std::vector<AggregationFactory> aggregations;
+    aggregations.emplace_back(Sum{ColumnName("uint64"), ColumnName("uint64")});
+    aggregations.emplace_back(FirstOrLast{ColumnName("int8"), ColumnName("int8"), Occurrence::first});
+    ResampleClause resample_clause{context, bucketer, std::move(aggregations)};
+
+    std::vector<Composite<ProcessingSegment>> comps;
+    size_t start_row = 0;
+    for (auto &split : seg.split(split_rows)) {
+        const auto end_row = start_row + split.row_count();
+        Composite<ProcessingSegment> comp;
+        comp.push_back(ProcessingSegment{std::move(split), pipelines::FrameSlice{pipelines::ColRange{1, 4}, pipelines::RowRange{start_row, end_row}}});
+        comps.push_back(partition_clause.process(empty, std::move(comp)));
+        start_row = end_row;
+    }
+
+    auto partitioned = partition_clause.repartition(std::move(comps)).value();
+    ASSERT_GT(partitioned.size(), 1u);
+    // Resample the partitions in reverse, as they may finish in any order
+    std::vector<Composite<ProcessingSegment>> resampled;
+    for (auto comp = partitioned.rbegin(); comp != partitioned.rend(); ++comp)
+        resampled.push_back(resample_clause.process(empty, std::move(*comp)));
+
+    auto outputs = resample_clause.repartition(std::move(resampled)).value();
+    std::vector<timestamp> index;
+    std::vector<uint64_t> sums;
+    std::vector<int8_t> firsts;
+    for (auto &res : outputs) {
+        res.broadcast([&](auto &proc) {
+            ASSERT_EQ(proc.data()[0].slice().row_range.first, index.size());
+            const auto &output = proc.data()[0].segment(empty);
+            output.init_column_map();
+            for (size_t row = 0; row < output.row_count(); ++row) {
+                index.push_back(output.template scalar_at<timestamp>(row, 0).value());
+                sums.push_back(output.template scalar_at<uint64_t>(row, output.column_index("uint64").value()).value());
+                firsts.push_back(output.template scalar_at<int8_t>(row, output.column_index("int8").value()).value());
+            }
+        });
+    }
+
+    const size_t num_buckets = (num_rows + 2) / 3;
+    ASSERT_EQ(index.size(), num_buckets);
+    for (size_t bucket = 0; bucket < num_buckets; ++bucket) {
+        ASSERT_EQ(index[bucket], timestamp(bucket * 3));
+        uint64_t expected_sum = 0;
+        for (size_t row = bucket * 3; row < std::min<size_t>(bucket * 3 + 3, num_rows); ++row)
+            expected_sum += row * 2;
+        ASSERT_EQ(sums[bucket], expected_sum);
+        ASSERT_EQ(firsts[bucket], int8_t(bucket * 3));
+    }
+}
+
+TEST(Clause, TimeBucketerBoundaries) {
+    using namespace arcticdb;
+    TimeBucketer left{10, 0, ResampleBoundary::left, ResampleBoundary::left};
+    ASSERT_EQ(left.bucket_start(10), 10);
+    ASSERT_EQ(left.bucket_start(19), 10);
+    ASSERT_EQ(left.bucket_start(-1), -10);
+
+    TimeBucketer right{10, 5, ResampleBoundary::right, ResampleBoundary::right};
+    ASSERT_EQ(right.bucket_start(15), 5);
+    ASSERT_EQ(right.bucket_label(right.bucket_start(15)), 15);
+    ASSERT_EQ(right.bucket_start(16), 15);
+}
+
+TEST(Clause, GlobalSort) {
+    using namespace arcticdb;
+    ScopedConfig segment_size("Sort.SegmentSize", 7);
+    std::shared_ptr<Store> empty;
+    const auto num_segs = 3;
+    const auto num_rows = 10;
+    std::random_device rng;
+    std::mt19937 urng(rng());
+
+    // Each segment holds the same uint64 values, so the merge has to interleave all of them
+    std::vector<Composite<ProcessingSegment>> comps;
+    GlobalSortClause sort_clause("uint64");
+    for (auto x = 0u; x < num_segs; ++x) {
+        auto seg = get_standard_timeseries_segment(fmt::format("sort_{}", x), num_rows);
+        std::shuffle(seg.begin(), seg.end(), urng);
+        Composite<ProcessingSegment> comp;
+        const pipelines::RowRange row_range{x * num_rows, (x + 1) * num_rows};
+        comp.push_back(ProcessingSegment{std::move(seg), pipelines::FrameSlice{pipelines::ColRange{1, 4}, row_range}});
+        comps.push_back(sort_clause.process(empty, std::move(comp)));
+    }
+
+    auto res = sort_clause.repartition(std::move(comps)).value();
+    ASSERT_EQ(res.size(), 5u);
+    std::vector<uint64_t> values;
+    size_t expected_start_row = 0;
+    for (auto &comp : res) {
+        comp.broadcast([&](auto &proc) {
+            const auto &slice = proc.data()[0].slice();
+            ASSERT_EQ(slice.row_range.start(), expected_start_row);
+            const auto &seg = proc.data()[0].segment(empty);
+            expected_start_row += seg.row_count();
+            for (size_t row = 0; row < seg.row_count(); ++row) {
+                const auto value = seg.template scalar_at<uint64_t>(row, 2).value();
+                values.push_back(value);
+                ASSERT_EQ(seg.string_at(row, 3).value(), fmt::format("string_{}", value / 2));
+            }
+        });
+    }
+
+    ASSERT_EQ(values.size(), size_t(num_segs * num_rows));
+    ASSERT_TRUE(std::is_sorted(values.begin(), values.end()));
+}
+
+TEST(Clause, GlobalSortStableWithNaNs) {
+    using namespace arcticdb;
+    std::shared_ptr<Store> empty;
+    const auto num_segs = 3;
+    const auto num_rows = 6;
+    GlobalSortClause sort_clause("float64");
+    // Processed in reverse, so that the order of the runs doesn't match the order of the rows
+    std::vector<Composite<ProcessingSegment>> comps;
+    for (auto x = num_segs - 1; x >= 0; --x) {
+        auto wrapper = SinkWrapper(fmt::format("sort_{}", x), {scalar_field_proto(DataType::FLOAT64, "float64")});
+        for (auto i = 0; i < num_rows; ++i) {
+            wrapper.aggregator_.start_row(timestamp{x * num_rows + i})([&](auto &&rb) {
+                rb.set_scalar(1, i % 3 == 0 ? std::numeric_limits<double>::quiet_NaN() : double(i % 2));
+            });
+        }
+        wrapper.aggregator_.commit();
+        Composite<ProcessingSegment> comp;
+        const pipelines::RowRange row_range{size_t(x * num_rows), size_t((x + 1) * num_rows)};
+        comp.push_back(ProcessingSegment{wrapper.segment(), pipelines::FrameSlice{pipelines::ColRange{1, 2}, row_range}});
+        comps.push_back(sort_clause.process(empty, std::move(comp)));
+    }
+
+    auto res = sort_clause.repartition(std::move(comps)).value();
+    ASSERT_EQ(res.size(), 1u);
+    const auto &seg = std::get<ProcessingSegment>(res[0][0]).data()[0].segment(empty);
+    ASSERT_EQ(seg.row_count(), size_t(num_segs * num_rows));
+    std::optional<std::pair<double, timestamp>> previous;
+    for (size_t row = 0; row < seg.row_count(); ++row) {
+        const auto value = seg.template scalar_at<double>(row, 1).value();
+        const auto index = seg.template scalar_at<timestamp>(row, 0).value();
+        // NaN sorts after everything, so treat it as infinity to check the order
+        const std::pair<double, timestamp> current{std::isnan(value) ? std::numeric_limits<double>::infinity() : value, index};
+        if (previous)
+            ASSERT_LT(*previous, current);
+        previous = current;
+    }
+    ASSERT_TRUE(std::isnan(seg.template scalar_at<double>(seg.row_count() - 1, 1).value()));
+}
+
+TEST(Clause, GlobalSortLimit) {
+    using namespace arcticdb;
+    std::shared_ptr<Store> empty;
+    const auto limit = 4u;
+    std::vector<Composite<ProcessingSegment>> comps;
+    GlobalSortClause sort_clause("uint64", limit);
+    for (auto x = 0u; x < 2; ++x) {
+        auto seg = get_standard_timeseries_segment(fmt::format("sort_{}", x), 10);
+        Composite<ProcessingSegment> comp;
+        comp.push_back(ProcessingSegment{std::move(seg), pipelines::FrameSlice{pipelines::ColRange{1, 4}, pipelines::RowRange{x * 10, (x + 1) * 10}}});
+        comps.push_back(sort_clause.process(empty, std::move(comp)));
+    }
+
+    auto res = sort_clause.repartition(std::move(comps)).value();
+    ASSERT_EQ(res.size(), 1u);
+    const auto &seg = std::get<ProcessingSegment>(res[0][0]).data()[0].segment(empty);
+    ASSERT_EQ(seg.row_count(), limit);
+    std::vector<uint64_t> expected{0, 0, 2, 2};
+    for (size_t row = 0; row < limit; ++row)
+        ASSERT_EQ(seg.template scalar_at<uint64_t>(row, 2).value(), expected[row]);
+}
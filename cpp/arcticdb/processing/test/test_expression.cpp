@@ -9,6 +9,8 @@
 #include <arcticdb/processing/execution_context.hpp>
 #include <arcticdb/processing/expression_node.hpp>
 #include <arcticdb/processing/processing_segment.hpp>
+#include <arcticdb/processing/fused_expression.hpp>
+#include <arcticdb/util/configs_map.hpp>
 #include <arcticdb/util/test/generators.hpp>
 
 TEST(ExpressionNode, AddBasic) {
@@ -46,3 +48,99 @@ TEST(ExpressionNode, AddBasic) {
         ASSERT_EQ(col->scalar_at<uint64_t>(j), v1.value() + v2.value());
     }
 }
+
+namespace {
+
+// ((thing1 * 2) + thing2 > 6000) & (thing2 < thing3), with thing3 == 1 dropping every other row
+std::shared_ptr<arcticdb::ExecutionContext> compound_execution_context() {
+    using namespace arcticdb;
+    auto execution_context = std::make_shared<ExecutionContext>();
+    execution_context->add_value("two", std::make_shared<Value>(construct_value<int8_t>(2)));
+    execution_context->add_value("threshold", std::make_shared<Value>(construct_value<double>(6000.0)));
+    execution_context->add_expression_node("times", std::make_shared<ExpressionNode>(ColumnName("thing1"), ValueName("two"), OperationType::MUL));
+    execution_context->add_expression_node("plus", std::make_shared<ExpressionNode>(ExpressionName("times"), ColumnName("thing2"), OperationType::ADD));
+    execution_context->add_expression_node("gt", std::make_shared<ExpressionNode>(ExpressionName("plus"), ValueName("threshold"), OperationType::GT));
+    execution_context->add_expression_node("lt", std::make_shared<ExpressionNode>(ColumnName("thing2"), ColumnName("thing3"), OperationType::LT));
+    execution_context->add_expression_node("and", std::make_shared<ExpressionNode>(ExpressionName("gt"), ExpressionName("lt"), OperationType::AND));
+    return execution_context;
+}
+
+arcticdb::ProcessingSegment compound_segment(size_t num_rows) {
+    using namespace arcticdb;
+    auto wrapper = SinkWrapper(StreamId{"test_fused"}, {
+        scalar_field_proto(DataType::UINT32, "thing1"),
+        scalar_field_proto(DataType::INT16, "thing2"),
+        scalar_field_proto(DataType::FLOAT32, "thing3")
+    });
+
+    for(auto j = 0u; j < num_rows; ++j ) {
+        wrapper.aggregator_.start_row(timestamp(j))([&](auto &&rb) {
+            rb.set_scalar(1, uint32_t(j));
+            rb.set_scalar(2, int16_t(int(j % 3000) - 1000));
+            rb.set_scalar(3, float(j % 2 ? 2000.0 : -2000.0));
+        });
+    }
+    wrapper.aggregator_.commit();
+    return ProcessingSegment(std::move(wrapper.segment()));
+}
+
+} // namespace
+
+TEST(ExpressionNode, FusedMatchesNodeByNode) {
+    using namespace arcticdb;
+    constexpr size_t num_rows = 10000;
+    std::shared_ptr<Store> empty;
+
+    auto fused_proc = compound_segment(num_rows);
+    fused_proc.set_execution_context(compound_execution_context());
+    auto fused_expression = FusedExpression::compile(ExpressionName("and"), fused_proc, empty);
+    ASSERT_TRUE(fused_expression.has_value());
+    ASSERT_EQ(fused_expression->num_operations(), 5u);
+    auto fused = std::get<std::shared_ptr<util::BitSet>>(fused_expression->evaluate());
+
+    ScopedConfig disable_fused("Expression.Fused", 0);
+    auto proc = compound_segment(num_rows);
+    proc.set_execution_context(compound_execution_context());
+    auto expected = std::get<std::shared_ptr<util::BitSet>>(proc.get(ExpressionName("and"), empty));
+
+    ASSERT_GT(expected->count(), 0u);
+    ASSERT_EQ(fused->size(), expected->size());
+    ASSERT_EQ(fused->count(), expected->count());
+    ASSERT_TRUE(*fused == *expected);
+
+    auto projected = FusedExpression::compile(ExpressionName("plus"), fused_proc, empty);
+    ASSERT_TRUE(projected.has_value());
+    auto fused_column = std::get<ColumnWithStrings>(projected->evaluate()).column_;
+    auto expected_column = std::get<ColumnWithStrings>(proc.get(ExpressionName("plus"), empty)).column_;
+    ASSERT_EQ(fused_column->type(), expected_column->type());
+    ASSERT_EQ(static_cast<size_t>(fused_column->row_count()), num_rows);
+    for(auto j = 0u; j < num_rows; ++j)
+        ASSERT_EQ(fused_column->scalar_at<int64_t>(j), expected_column->scalar_at<int64_t>(j));
+}
+
+TEST(ExpressionNode, FusedFallsBackForSingleOperation) {
+    using namespace arcticdb;
+    std::shared_ptr<Store> empty;
+    auto proc = compound_segment(100);
+    proc.set_execution_context(compound_execution_context());
+    ASSERT_FALSE(FusedExpression::compile(ExpressionName("lt"), proc, empty).has_value());
+    // Part of a larger tree the same node can still be fused
+    ASSERT_TRUE(proc.unfused_expressions_.empty());
+    ASSERT_TRUE(FusedExpression::compile(ExpressionName("and"), proc, empty).has_value());
+}
+
+TEST(ExpressionNode, FusedRemembersUnfusableNodes) {
+    using namespace arcticdb;
+    std::shared_ptr<Store> empty;
+    auto proc = compound_segment(100);
+    auto execution_context = compound_execution_context();
+    // Comparing two values can't be fused, which stops every node above it being fused
+    execution_context->add_expression_node("values", std::make_shared<ExpressionNode>(ValueName("two"), ValueName("threshold"), OperationType::LT));
+    execution_context->add_expression_node("root", std::make_shared<ExpressionNode>(ExpressionName("gt"), ExpressionName("values"), OperationType::AND));
+    proc.set_execution_context(execution_context);
+
+    ASSERT_FALSE(FusedExpression::compile(ExpressionName("root"), proc, empty).has_value());
+    ASSERT_EQ(proc.unfused_expressions_, (std::unordered_set<std::string>{"values", "root"}));
+    ASSERT_FALSE(FusedExpression::compile(ExpressionName("root"), proc, empty).has_value());
+    ASSERT_TRUE(FusedExpression::compile(ExpressionName("gt"), proc, empty).has_value());
+}
@@ -24,6 +24,7 @@
 #include <arcticdb/util/global_lifetimes.hpp>
 #include <arcticdb/util/configs_map.hpp>
 #include <arcticdb/util/error_code.hpp>
+#include <arcticdb/util/task_arena.hpp>
 
 #include <pybind11/pybind11.h>
 #include <folly/system/ThreadName.h>
@@ -144,6 +145,22 @@ void register_configs_map_api(py::module& m) {
 #undef EXPOSE_TYPE
 }
 
+void register_allocator_stats(py::module& m) {
+    using namespace arcticdb;
+    m.def("get_task_arena_stats", []() {
+        const auto stats = TaskArena::global_stats();
+        py::dict res;
+        res["allocations"] = stats.allocations_;
+        res["hits"] = stats.hits_;
+        res["cached_frees"] = stats.cached_frees_;
+        res["released_blocks"] = stats.released_blocks_;
+        res["released_bytes"] = stats.released_bytes_;
+        res["peak_cached_bytes"] = stats.peak_cached_bytes_;
+        return res;
+    }, "Allocation counts of the arenas used by decode and processing tasks that have finished");
+    m.def("reset_task_arena_stats", &TaskArena::reset_global_stats);
+}
+
 #ifdef WIN32
 __declspec(noinline)
 #else
@@ -288,6 +305,7 @@ PYBIND11_MODULE(arcticdb_ext, m) {
     arcticdb::toolbox::apy::register_bindings(m);
     arcticdb::version_store::register_bindings(m);
     register_configs_map_api(m);
+    register_allocator_stats(m);
     register_log(m.def_submodule("log"));
     register_instrumentation(m.def_submodule("instrumentation"));
     register_metrics(m.def_submodule("metrics"));
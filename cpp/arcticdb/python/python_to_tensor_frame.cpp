@@ -12,9 +12,13 @@
 #include <arcticdb/entity/native_tensor.hpp>
 #include <arcticdb/python/python_utils.hpp>
 #include <arcticdb/python/python_types.hpp>
+#include <arcticdb/pipeline/arrow_c_data_interface.hpp>
 #include <pybind11/stl.h>
 #include <pybind11/numpy.h>
 
+#include <limits>
+#include <type_traits>
+
 namespace arcticdb::convert {
 
 using namespace arcticdb::pipelines;
@@ -157,4 +161,178 @@ InputTensorFrame py_ndf_to_frame(
     return res;
 }
 
+namespace {
+
+template<typename T>
+T* allocate_converted(InputTensorFrame& frame, size_t count) {
+    auto& words = frame.arrow_converted_buffers->emplace_back(std::max<size_t>(1, (count * sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t)), 0);
+    return reinterpret_cast<T*>(words.data());
+}
+
+bool arrow_bit_set(const void* bitmap, size_t pos) {
+    return static_cast<const uint8_t*>(bitmap)[pos / 8] & (1u << (pos % 8));
+}
+
+NativeTensor arrow_tensor(const void* values, shape_t rows, DataType data_type) {
+    const auto type_size = static_cast<ssize_t>(get_type_size(data_type));
+    return {rows * type_size, 1, nullptr, &rows, data_type, type_size, values};
+}
+
+template<typename RawType>
+NativeTensor arrow_numeric_tensor(const ArrowArray& array, const uint8_t* validity, DataType data_type, InputTensorFrame& frame) {
+    const auto rows = static_cast<size_t>(array.length);
+    const auto values = static_cast<const RawType*>(array.buffers[1]) + array.offset;
+    if (!validity)
+        return arrow_tensor(values, array.length, data_type);
+
+    // Nulls become NaN, so integers with nulls are written as floats, as pandas would have them
+    auto converted = allocate_converted<std::conditional_t<std::is_floating_point_v<RawType>, RawType, double>>(frame, rows);
+    for (size_t row = 0; row < rows; ++row) {
+        converted[row] = arrow_bit_set(validity, array.offset + row) ? values[row] : std::numeric_limits<double>::quiet_NaN();
+    }
+    return arrow_tensor(converted, array.length, std::is_floating_point_v<RawType> ? data_type : DataType::FLOAT64);
+}
+
+NativeTensor arrow_timestamp_tensor(const ArrowArray& array, const uint8_t* validity, int64_t multiplier, InputTensorFrame& frame) {
+    const auto rows = static_cast<size_t>(array.length);
+    const auto values = static_cast<const int64_t*>(array.buffers[1]) + array.offset;
+    if (!validity && multiplier == 1)
+        return arrow_tensor(values, array.length, DataType::MICROS_UTC64);
+
+    auto converted = allocate_converted<timestamp>(frame, rows);
+    for (size_t row = 0; row < rows; ++row) {
+        const bool valid = !validity || arrow_bit_set(validity, array.offset + row);
+        converted[row] = valid ? values[row] * multiplier : std::numeric_limits<timestamp>::min();
+    }
+    return arrow_tensor(converted, array.length, DataType::MICROS_UTC64);
+}
+
+NativeTensor arrow_to_tensor(const ArrowArray& array, const ArrowSchema& schema, size_t field_pos, InputTensorFrame& frame) {
+    util::check(schema.dictionary == nullptr, "Dictionary encoded Arrow column {} is not supported, decode it before writing", schema.name);
+    util::check(array.n_children == 0, "Nested Arrow column {} with format {} is not supported", schema.name, schema.format);
+    const std::string_view format{schema.format};
+    const auto validity = array.null_count != 0 ? static_cast<const uint8_t*>(array.buffers[0]) : nullptr;
+
+    if (format == "c") return arrow_numeric_tensor<int8_t>(array, validity, DataType::INT8, frame);
+    if (format == "s") return arrow_numeric_tensor<int16_t>(array, validity, DataType::INT16, frame);
+    if (format == "i") return arrow_numeric_tensor<int32_t>(array, validity, DataType::INT32, frame);
+    if (format == "l") return arrow_numeric_tensor<int64_t>(array, validity, DataType::INT64, frame);
+    if (format == "C") return arrow_numeric_tensor<uint8_t>(array, validity, DataType::UINT8, frame);
+    if (format == "S") return arrow_numeric_tensor<uint16_t>(array, validity, DataType::UINT16, frame);
+    if (format == "I") return arrow_numeric_tensor<uint32_t>(array, validity, DataType::UINT32, frame);
+    if (format == "L") return arrow_numeric_tensor<uint64_t>(array, validity, DataType::UINT64, frame);
+    if (format == "f") return arrow_numeric_tensor<float>(array, validity, DataType::FLOAT32, frame);
+    if (format == "g") return arrow_numeric_tensor<double>(array, validity, DataType::FLOAT64, frame);
+
+    if (format.substr(0, 2) == "ts") {
+        // Timestamps with a unit of seconds, milliseconds, microseconds or nanoseconds, followed by the timezone
+        static const std::unordered_map<char, int64_t> multipliers{{'s', 1'000'000'000}, {'m', 1'000'000}, {'u', 1'000}, {'n', 1}};
+        const auto multiplier = format.size() > 2 ? multipliers.find(format[2]) : multipliers.end();
+        util::check(multiplier != multipliers.end(), "Unsupported Arrow timestamp format {} in column {}", format, schema.name);
+        return arrow_timestamp_tensor(array, validity, multiplier->second, frame);
+    }
+
+    if (format == "b") {
+        const auto rows = static_cast<size_t>(array.length);
+        util::check(!validity, "Nulls in boolean Arrow column {} are not supported", schema.name);
+        auto converted = allocate_converted<bool>(frame, rows);
+        for (size_t row = 0; row < rows; ++row)
+            converted[row] = arrow_bit_set(array.buffers[1], array.offset + row);
+        return arrow_tensor(converted, array.length, DataType::BOOL8);
+    }
+
+    if (format == "u" || format == "U" || format == "z" || format == "Z") {
+        frame.arrow_strings.try_emplace(field_pos, ArrowStringColumn{
+            validity,
+            array.buffers[1],
+            static_cast<const char*>(array.buffers[2]),
+            array.offset,
+            format == "U" || format == "Z"});
+        const auto data_type = format == "u" || format == "U" ? DataType::UTF_DYNAMIC64 : DataType::ASCII_DYNAMIC64;
+        return arrow_tensor(array.buffers[1], array.length, data_type);
+    }
+
+    util::raise_rte("Unsupported Arrow format {} in column {}", format, schema.name);
+    return arrow_tensor(nullptr, 0, DataType::UNKNOWN);  // unreachable
+}
+
+SortedValue arrow_index_sorted(const NativeTensor& tensor) {
+    const auto values = static_cast<const timestamp*>(tensor.data());
+    bool ascending = true;
+    bool descending = true;
+    for (ssize_t row = 1; row < tensor.shape(0); ++row) {
+        ascending &= values[row - 1] <= values[row];
+        descending &= values[row - 1] >= values[row];
+    }
+    return ascending ? SortedValue::ASCENDING : descending ? SortedValue::DESCENDING : SortedValue::UNSORTED;
+}
+
+} // namespace
+
+InputTensorFrame arrow_to_frame(
+    const StreamId& stream_name,
+    const py::tuple &capsules,
+    const std::optional<std::string> &index_column,
+    const py::object &norm_meta,
+    const py::object &user_meta) {
+    ARCTICDB_SUBSAMPLE_DEFAULT(NormalizeArrowFrame)
+    util::check(capsules.size() == 2, "Expected Arrow schema and array capsules, got {} objects", capsules.size());
+    const auto schema = static_cast<ArrowSchema*>(PyCapsule_GetPointer(capsules[0].ptr(), "arrow_schema"));
+    const auto array = static_cast<ArrowArray*>(PyCapsule_GetPointer(capsules[1].ptr(), "arrow_array"));
+    util::check(schema != nullptr && array != nullptr, "Expected Arrow schema and array capsules");
+    util::check(std::string_view{schema->format} == "+s", "Expected an Arrow record batch, got format {}", schema->format);
+    util::check(array->release != nullptr, "Arrow array has already been released");
+    util::check(array->offset == 0, "Arrow record batches with an offset are not supported");
+
+    InputTensorFrame res;
+    res.desc.set_id(stream_name);
+    res.num_rows = array->length;
+    res.arrow_converted_buffers = std::make_shared<std::vector<std::vector<uint64_t>>>();
+    python_util::pb_from_python(norm_meta, res.norm_meta);
+    if (!user_meta.is_none())
+        python_util::pb_from_python(user_meta, res.user_meta);
+
+    std::optional<int64_t> index_pos;
+    for (int64_t i = 0; index_column && i < schema->n_children; ++i) {
+        if (schema->children[i]->name == index_column.value())
+            index_pos = i;
+    }
+    util::check(!index_column || index_pos, "Index column {} not found in Arrow record batch", index_column.value_or(""));
+
+    res.index = stream::RowCountIndex();
+    res.desc.set_index_type(IndexDescriptor::ROWCOUNT);
+    auto sorted = index_column ? SortedValue::UNKNOWN : SortedValue::ASCENDING;
+    if (index_pos) {
+        auto index_tensor = arrow_to_tensor(*array->children[*index_pos], *schema->children[*index_pos], 0, res);
+        if (index_tensor.data_type() == DataType::MICROS_UTC64) {
+            res.desc.set_index_field_count(1);
+            res.desc.set_index_type(IndexDescriptor::TIMESTAMP);
+            res.desc.add_scalar_field(index_tensor.dt_, index_column.value());
+            res.index = stream::TimeseriesIndex(index_column.value());
+            sorted = arrow_index_sorted(index_tensor);
+            res.index_tensor = std::move(index_tensor);
+        } else {
+            // As for dataframes, an index that isn't a timestamp is written as a column with a row count index
+            util::check(!is_sequence_type(index_tensor.data_type()), "String index column {} is not supported", index_column.value());
+            res.desc.add_scalar_field(index_tensor.dt_, index_column.value());
+            res.field_tensors.push_back(std::move(index_tensor));
+        }
+    }
+
+    for (int64_t i = 0; i < schema->n_children; ++i) {
+        if (index_pos && i == *index_pos)
+            continue;
+
+        auto tensor = arrow_to_tensor(*array->children[i], *schema->children[i], res.field_tensors.size(), res);
+        res.desc.add_field(scalar_field_proto(tensor.data_type(), schema->children[i]->name));
+        res.field_tensors.push_back(std::move(tensor));
+    }
+
+    res.set_sorted(sorted);
+    ARCTICDB_DEBUG(log::version(), "Received Arrow frame with descriptor {}", res.desc);
+    if (res.num_rows > 0)
+        res.set_index_range();
+    return res;
+}
+
 } // namespace arcticdb::convert
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include <pybind11/pybind11.h>
 #include <arcticdb/pipeline/input_tensor_frame.hpp>
 #include <arcticdb/entity/native_tensor.hpp>
+#include <optional>
 #include <string>
 
 namespace arcticdb::convert {
@@ -48,4 +49,13 @@ pipelines::InputTensorFrame py_ndf_to_frame(
     const py::object &norm_meta,
     const py::object &user_meta);
 
+// Converts a record batch exported through the Arrow C data interface, as a tuple of schema and array capsules. The
+// capsules must outlive the frame, as fixed width columns without nulls are used without copying
+pipelines::InputTensorFrame arrow_to_frame(
+    const StreamId& stream_name,
+    const py::tuple &capsules,
+    const std::optional<std::string> &index_column,
+    const py::object &norm_meta,
+    const py::object &user_meta);
+
 } // namespace arcticdb::convert
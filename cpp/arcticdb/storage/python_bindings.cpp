@@ -60,6 +60,8 @@ void register_bindings(py::module &m) {
         .value("TOMBSTONE_ALL", KeyType::TOMBSTONE_ALL)
         .value("SNAPSHOT_TOMBSTONE", KeyType::SNAPSHOT_TOMBSTONE)
         .value("LOG_COMPACTED", KeyType::LOG_COMPACTED)
+        .value("VERSION_INDEX", KeyType::VERSION_INDEX)
+        .value("SNAPSHOT_MEMBERSHIP", KeyType::SNAPSHOT_MEMBERSHIP)
         ;
 
     py::enum_<OpenMode>(storage, "OpenMode")
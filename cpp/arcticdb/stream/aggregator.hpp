@@ -230,6 +230,10 @@ class Aggregator {
         segment_.set_no_string_at(col, row, placeholder);
     }
 
+    void set_strings_at(position_t col, position_t first_row, const std::string_view* strings, size_t count) {
+        segment_.set_strings_at(col, first_row, strings, count);
+    }
+
     void set_offset(ssize_t offset) {
         segment_.set_offset(offset);
     }
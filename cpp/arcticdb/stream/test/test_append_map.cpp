@@ -34,7 +34,7 @@ TEST(Append, Simple) {
     pipeline_context->slice_and_keys_ = arcticdb::stream::get_incomplete(store, stream_id, range, 0, false, false);
     generate_filtered_field_descriptors(pipeline_context, {});
 
-    SegmentInMemory allocated_frame = allocate_frame(pipeline_context);
+    SegmentInMemory allocated_frame = allocate_frame(pipeline_context, ReadOptions{});
     ASSERT_EQ(allocated_frame.row_count(), size_t(frame.num_rows));
 }
 
@@ -13,6 +13,9 @@
 #include <arcticdb/util/clock.hpp>
 #include <folly/concurrency/ConcurrentHashMap.h>
 #include <arcticdb/util/slab_allocator.hpp>
+#include <arcticdb/util/task_arena.hpp>
+#include <arcticdb/util/file_mapped_allocator.hpp>
+#include <arcticdb/util/huge_page_allocator.hpp>
 #include <arcticdb/util/configs_map.hpp>
 #include <arcticdb/util/trace.hpp>
 #include <folly/ThreadCachedInt.h>
@@ -404,6 +407,50 @@ public:
         return std::make_pair(ret, ts);
     }
 
+    // The size to pass to pooled_alloc for a block of the given size. This is rounded up to the task arena's size
+    // class when an arena is active on this thread to recycle it, and is left as it is otherwise, so that blocks that
+    // can't be recycled don't take up to twice the memory they need
+    static size_t pooled_size(size_t size) {
+        return TaskArena::current() != nullptr ? TaskArena::rounded_size(size) : size;
+    }
+
+    // For blocks that are freed with their size, which can be recycled by the task arena of the freeing thread when
+    // the size is one of its classes, or mapped from a file or to huge pages when large and allocated in a file mapped
+    // or huge page scope. pooled_free must be passed the same size
+    static std::pair<uint8_t*, entity::timestamp> pooled_alloc(size_t size) {
+        util::check(size != 0, "Should not allocate zero bytes");
+        auto ts = current_timestamp();
+        uint8_t* ret = FileMappedAllocator::allocate(size);
+        if(ret == nullptr)
+            ret = HugePageAllocator::allocate(size);
+
+        if(auto arena = TaskArena::current(); ret == nullptr && arena != nullptr)
+            ret = arena->allocate(size);
+
+        if(ret == nullptr)
+            ret = internal_alloc(size);
+
+        util::check(ret != nullptr, "Failed to allocate {} bytes", size);
+        TracingPolicy::track_alloc(std::make_pair(uintptr_t(ret), ts), size);
+        return {ret, ts};
+    }
+
+    static void pooled_free(std::pair<uint8_t*, entity::timestamp> ptr, size_t size) {
+        if (ptr.first == nullptr)
+            return;
+
+        TracingPolicy::track_free(std::make_pair(uintptr_t(ptr.first), ptr.second));
+        if(FileMappedAllocator::deallocate(ptr.first, size) || HugePageAllocator::deallocate(ptr.first, size))
+            return;
+
+#ifndef USE_SLAB_ALLOCATOR
+        // The arena returns blocks to malloc, so can't cache those that came from the slab
+        if(auto arena = TaskArena::current(); arena != nullptr && arena->deallocate(ptr.first, size))
+            return;
+#endif
+        internal_free(ptr.first);
+    }
+
     static std::pair<uint8_t*, entity::timestamp> realloc(std::pair<uint8_t*, entity::timestamp> ptr, size_t size) {
         auto ret = internal_realloc(ptr.first, size);
 
@@ -0,0 +1,112 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/util/file_mapped_allocator.hpp>
+#include <arcticdb/util/mapped_block_registry.hpp>
+#include <arcticdb/log/log.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace arcticdb {
+
+namespace {
+
+thread_local const std::string* scope_directory = nullptr;
+
+// Leaked so that frames freed during shutdown can still be unmapped
+MappedBlockRegistry& file_mapped_blocks() {
+    static auto* blocks = new MappedBlockRegistry();
+    return *blocks;
+}
+
+#ifndef _WIN32
+uint8_t* map_file(const std::string& directory, size_t size) {
+    auto path = directory + "/arcticdb-frame-XXXXXX";
+    std::vector<char> path_template(path.begin(), path.end());
+    path_template.push_back('\0');
+    const auto fd = mkstemp(path_template.data());
+    if(fd == -1) {
+        log::memory().warn("Failed to create file in {} for mapped block: {}", directory, std::strerror(errno));
+        return nullptr;
+    }
+
+    // The mapping keeps the file's pages, and the file is removed with it
+    unlink(path_template.data());
+    void* ptr = MAP_FAILED;
+    if(ftruncate(fd, static_cast<off_t>(size)) == 0)
+        ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    const auto error = errno;
+    close(fd);
+    if(ptr == MAP_FAILED) {
+        log::memory().warn("Failed to map {} bytes from a file in {}: {}", size, directory, std::strerror(error));
+        return nullptr;
+    }
+    return static_cast<uint8_t*>(ptr);
+}
+#endif
+
+} // namespace
+
+uint8_t* FileMappedAllocator::allocate(size_t size) {
+#ifndef _WIN32
+    const auto* directory = scope_directory;
+    if(directory == nullptr || size < MinMappedSize)
+        return nullptr;
+
+    auto ptr = map_file(*directory, size);
+    if(ptr == nullptr)
+        return nullptr;
+
+    file_mapped_blocks().add(ptr, size);
+    return ptr;
+#else
+    return nullptr;
+#endif
+}
+
+bool FileMappedAllocator::deallocate(uint8_t* ptr, size_t size) {
+#ifndef _WIN32
+    if(size < MinMappedSize)
+        return false;
+
+    return file_mapped_blocks().unmap(ptr);
+#else
+    return false;
+#endif
+}
+
+bool FileMappedAllocator::is_mapped_block(const uint8_t* ptr) {
+    return file_mapped_blocks().contains(ptr);
+}
+
+size_t FileMappedAllocator::mapped_bytes() {
+    return file_mapped_blocks().mapped_bytes();
+}
+
+ScopedFileMappedAllocation::ScopedFileMappedAllocation(std::string directory) :
+    directory_(std::move(directory)),
+    previous_(scope_directory) {
+    scope_directory = &directory_;
+}
+
+ScopedFileMappedAllocation::~ScopedFileMappedAllocation() {
+    scope_directory = previous_;
+}
+
+const std::string* ScopedFileMappedAllocation::current_directory() {
+    return scope_directory;
+}
+
+} // namespace arcticdb
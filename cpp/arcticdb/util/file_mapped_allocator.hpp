@@ -0,0 +1,59 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/util/constructors.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace arcticdb {
+
+/*
+ * Maps large blocks from files in a scratch directory, so that a frame larger than memory can be read, with the
+ * kernel writing its pages back to the files and evicting them under memory pressure rather than the process running
+ * out of memory or swapping. Each block has a file of its own, which is unlinked as soon as it's mapped so that its
+ * space is returned when the block is unmapped or the process exits. Blocks are only mapped this way while a
+ * ScopedFileMappedAllocation is active on the allocating thread, which allocate_frame uses for reads with a mapped
+ * output directory. Mapped blocks are tracked so that the allocator can tell them apart when they're freed on any
+ * thread.
+ */
+class FileMappedAllocator {
+public:
+    // Smaller blocks come from malloc, as a file per block would cost more than the memory it saves
+    static constexpr size_t MinMappedSize = 1024 * 1024;
+
+    // Returns null if no scope is active on this thread, the size is smaller than MinMappedSize, or mapping fails
+    static uint8_t* allocate(size_t size);
+
+    // Returns false if the block wasn't allocated here, in which case the caller should free it
+    static bool deallocate(uint8_t* ptr, size_t size);
+
+    static bool is_mapped_block(const uint8_t* ptr);
+
+    static size_t mapped_bytes();
+};
+
+class ScopedFileMappedAllocation {
+public:
+    explicit ScopedFileMappedAllocation(std::string directory);
+
+    ARCTICDB_NO_MOVE_OR_COPY(ScopedFileMappedAllocation)
+
+    ~ScopedFileMappedAllocation();
+
+    // The directory of the scope active on this thread, or null if there is none
+    static const std::string* current_directory();
+
+private:
+    std::string directory_;
+    const std::string* previous_;
+};
+
+} // namespace arcticdb
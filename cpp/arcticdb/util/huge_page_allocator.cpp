@@ -0,0 +1,151 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/util/huge_page_allocator.hpp>
+#include <arcticdb/util/mapped_block_registry.hpp>
+#include <arcticdb/util/configs_map.hpp>
+#include <arcticdb/log/log.hpp>
+#include <arcticdb/util/preprocess.hpp>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+// Added in Linux 5.14, and fails with EINVAL on older kernels
+#if defined(__linux__) && !defined(MADV_POPULATE_WRITE)
+#define MADV_POPULATE_WRITE 23
+#endif
+
+namespace arcticdb {
+
+namespace {
+
+thread_local HugePageMode scope_mode = HugePageMode::DISABLED;
+
+// Leaked so that frames freed during shutdown can still be unmapped
+MappedBlockRegistry& huge_page_blocks() {
+    static auto* blocks = new MappedBlockRegistry();
+    return *blocks;
+}
+
+constexpr size_t round_to_huge_pages(size_t size) {
+    return (size + HugePageAllocator::HugePageSize - 1) / HugePageAllocator::HugePageSize * HugePageAllocator::HugePageSize;
+}
+
+#ifdef __linux__
+uint8_t* map_huge_pages(size_t size, HugePageMode mode) {
+    if(mode == HugePageMode::EXPLICIT) {
+        auto ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if(ptr != MAP_FAILED)
+            return static_cast<uint8_t*>(ptr);
+
+        ARCTICDB_DEBUG(log::memory(), "Failed to map {} bytes of explicit huge pages, using transparent huge pages", size);
+    }
+
+    // Over-map by a huge page so that the block can start on a huge page boundary, then unmap the slack either side
+    const auto mapped_size = size + HugePageAllocator::HugePageSize;
+    auto mapped = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(mapped == MAP_FAILED)
+        return nullptr;
+
+    const auto begin = reinterpret_cast<uintptr_t>(mapped);
+    const auto aligned = (begin + HugePageAllocator::HugePageSize - 1) & ~(HugePageAllocator::HugePageSize - 1);
+    if(aligned != begin)
+        munmap(mapped, aligned - begin);
+
+    if(const auto tail = begin + mapped_size - (aligned + size); tail != 0)
+        munmap(reinterpret_cast<void*>(aligned + size), tail);
+
+    auto ptr = reinterpret_cast<uint8_t*>(aligned);
+    madvise(ptr, size, MADV_HUGEPAGE);
+    return ptr;
+}
+#endif
+
+} // namespace
+
+HugePageMode HugePageAllocator::frame_mode() {
+    static const auto mode = static_cast<HugePageMode>(ConfigsMap::instance()->get_int("Allocator.HugePageFrames", 0));
+    return mode;
+}
+
+bool HugePageAllocator::prefault_frames() {
+    static const bool prefault = ConfigsMap::instance()->get_int("Allocator.HugePagePrefault", 0);
+    return prefault;
+}
+
+uint8_t* HugePageAllocator::allocate(size_t size) {
+#ifdef __linux__
+    const auto mode = scope_mode;
+    if(mode == HugePageMode::DISABLED || size < HugePageSize)
+        return nullptr;
+
+    const auto mapped_size = round_to_huge_pages(size);
+    auto ptr = map_huge_pages(mapped_size, mode);
+    if(ptr == nullptr) {
+        log::memory().warn("Failed to map {} bytes for huge page block, falling back to malloc", mapped_size);
+        return nullptr;
+    }
+
+    huge_page_blocks().add(ptr, mapped_size);
+    return ptr;
+#else
+    return nullptr;
+#endif
+}
+
+bool HugePageAllocator::deallocate(uint8_t* ptr, size_t size) {
+#ifdef __linux__
+    if(size < HugePageSize)
+        return false;
+
+    return huge_page_blocks().unmap(ptr);
+#else
+    return false;
+#endif
+}
+
+bool HugePageAllocator::is_huge_page_block(const uint8_t* ptr) {
+    return huge_page_blocks().contains(ptr);
+}
+
+bool HugePageAllocator::prefault(const uint8_t* ptr ARCTICDB_UNUSED) {
+#ifdef __linux__
+    // Pinned rather than faulted in under the registry's mutex, so that other blocks can be mapped and unmapped meanwhile
+    auto& blocks = huge_page_blocks();
+    const auto size = blocks.pin(ptr);
+    if(!size)
+        return false;
+
+    if(madvise(const_cast<uint8_t*>(ptr), *size, MADV_POPULATE_WRITE) != 0)
+        ARCTICDB_DEBUG(log::memory(), "Prefaulting {} bytes not supported, pages will be faulted on first write", *size);
+
+    blocks.unpin(ptr);
+    return true;
+#else
+    return false;
+#endif
+}
+
+size_t HugePageAllocator::mapped_bytes() {
+    return huge_page_blocks().mapped_bytes();
+}
+
+ScopedHugePageAllocation::ScopedHugePageAllocation(HugePageMode mode) :
+    previous_(scope_mode) {
+    scope_mode = mode;
+}
+
+ScopedHugePageAllocation::~ScopedHugePageAllocation() {
+    scope_mode = previous_;
+}
+
+HugePageMode ScopedHugePageAllocation::current_mode() {
+    return scope_mode;
+}
+
+} // namespace arcticdb
@@ -0,0 +1,74 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/util/constructors.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace arcticdb {
+
+enum class HugePageMode : int64_t {
+    // Large blocks come from malloc like any other
+    DISABLED = 0,
+    // Large blocks are mapped aligned to huge pages, and the kernel is advised to back them with transparent huge pages
+    TRANSPARENT = 1,
+    // Large blocks are mapped from the explicit huge page pool, falling back to transparent huge pages when it's empty
+    EXPLICIT = 2
+};
+
+/*
+ * Maps large blocks directly with mmap so that they can be backed by 2MB huge pages, which avoids the TLB misses and
+ * per-page faults of scanning a large frame made of malloc'd memory. Blocks are only mapped this way while a
+ * ScopedHugePageAllocation is active on the allocating thread, which allocate_frame uses for its presized columns.
+ * Mapped blocks are tracked so that the allocator can tell them apart when they're freed on any thread.
+ */
+class HugePageAllocator {
+public:
+    static constexpr size_t HugePageSize = 2 * 1024 * 1024;
+
+    // Mode used by allocate_frame, from Allocator.HugePageFrames
+    static HugePageMode frame_mode();
+
+    // Whether allocate_frame should prefault its huge page blocks on the IO threads, from Allocator.HugePagePrefault
+    static bool prefault_frames();
+
+    // Returns null if no scope is active on this thread, the size is smaller than a huge page, or mapping fails
+    static uint8_t* allocate(size_t size);
+
+    // Returns false if the block wasn't allocated here, in which case the caller should free it
+    static bool deallocate(uint8_t* ptr, size_t size);
+
+    static bool is_huge_page_block(const uint8_t* ptr);
+
+    /*
+     * Faults in the pages of a block without changing its contents, so is safe while other threads write to it. The
+     * block may have been freed since ptr was taken, in which case nothing is done and false is returned, as the block
+     * is kept mapped until this returns.
+     */
+    static bool prefault(const uint8_t* ptr);
+
+    static size_t mapped_bytes();
+};
+
+class ScopedHugePageAllocation {
+public:
+    explicit ScopedHugePageAllocation(HugePageMode mode);
+
+    ARCTICDB_NO_MOVE_OR_COPY(ScopedHugePageAllocation)
+
+    ~ScopedHugePageAllocation();
+
+    static HugePageMode current_mode();
+
+private:
+    HugePageMode previous_;
+};
+
+} // namespace arcticdb
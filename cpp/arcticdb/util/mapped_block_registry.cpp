@@ -0,0 +1,92 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/util/mapped_block_registry.hpp>
+#include <arcticdb/util/preconditions.hpp>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+namespace arcticdb {
+
+void MappedBlockRegistry::add(uint8_t* ptr, size_t size) {
+    std::lock_guard lock(mutex_);
+    blocks_.try_emplace(ptr, Block{size});
+    mapped_bytes_ += size;
+    ++num_mapped_;
+}
+
+bool MappedBlockRegistry::unmap(const uint8_t* ptr) {
+    // A block being freed was counted before its pointer was returned, so no block can be mapped when this is zero
+    if(num_mapped_ == 0)
+        return false;
+
+    size_t size;
+    {
+        std::lock_guard lock(mutex_);
+        auto it = blocks_.find(ptr);
+        if(it == blocks_.end() || it->second.unmapped_)
+            return false;
+
+        if(it->second.pins_ != 0) {
+            it->second.unmapped_ = true;
+            return true;
+        }
+        size = it->second.size_;
+        blocks_.erase(it);
+    }
+    release(const_cast<uint8_t*>(ptr), size);
+    return true;
+}
+
+std::optional<size_t> MappedBlockRegistry::pin(const uint8_t* ptr) {
+    std::lock_guard lock(mutex_);
+    auto it = blocks_.find(ptr);
+    if(it == blocks_.end() || it->second.unmapped_)
+        return std::nullopt;
+
+    ++it->second.pins_;
+    return it->second.size_;
+}
+
+void MappedBlockRegistry::unpin(const uint8_t* ptr) {
+    size_t size;
+    {
+        std::lock_guard lock(mutex_);
+        auto it = blocks_.find(ptr);
+        util::check(it != blocks_.end() && it->second.pins_ != 0, "Unpinning a mapped block that isn't pinned");
+        if(--it->second.pins_ != 0 || !it->second.unmapped_)
+            return;
+
+        size = it->second.size_;
+        blocks_.erase(it);
+    }
+    release(const_cast<uint8_t*>(ptr), size);
+}
+
+bool MappedBlockRegistry::contains(const uint8_t* ptr) {
+    std::lock_guard lock(mutex_);
+    auto it = blocks_.find(ptr);
+    return it != blocks_.end() && !it->second.unmapped_;
+}
+
+size_t MappedBlockRegistry::mapped_bytes() {
+    std::lock_guard lock(mutex_);
+    return mapped_bytes_;
+}
+
+void MappedBlockRegistry::release(uint8_t* ptr, size_t size) {
+#ifndef _WIN32
+    munmap(ptr, size);
+#endif
+    std::lock_guard lock(mutex_);
+    mapped_bytes_ -= size;
+    --num_mapped_;
+}
+
+} // namespace arcticdb
@@ -0,0 +1,62 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/util/constructors.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace arcticdb {
+
+/*
+ * The blocks an allocator has mapped with mmap, so that it can tell them apart from malloc'd blocks when they're freed
+ * on any thread, and unmap them with the size they were mapped with. A block can be pinned to keep it mapped while it
+ * is used without holding the registry's mutex, in which case unmapping it is left to the last unpin.
+ */
+class MappedBlockRegistry {
+public:
+    MappedBlockRegistry() = default;
+
+    ARCTICDB_NO_MOVE_OR_COPY(MappedBlockRegistry)
+
+    void add(uint8_t* ptr, size_t size);
+
+    // Unmaps the block now, or once it's unpinned, returning false if it isn't registered here
+    bool unmap(const uint8_t* ptr);
+
+    // Returns the size of the block, or nullopt if it isn't registered here, in which case it mustn't be unpinned
+    std::optional<size_t> pin(const uint8_t* ptr);
+
+    void unpin(const uint8_t* ptr);
+
+    bool contains(const uint8_t* ptr);
+
+    size_t mapped_bytes();
+
+private:
+    struct Block {
+        size_t size_;
+        size_t pins_ = 0;
+        bool unmapped_ = false;
+    };
+
+    void release(uint8_t* ptr, size_t size);
+
+    std::mutex mutex_;
+    std::unordered_map<const uint8_t*, Block> blocks_;
+    size_t mapped_bytes_ = 0;
+    // Read without the mutex, so that frees don't have to take it while nothing is mapped
+    std::atomic<size_t> num_mapped_ = 0;
+};
+
+} // namespace arcticdb
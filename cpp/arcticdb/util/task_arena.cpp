@@ -0,0 +1,78 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/util/task_arena.hpp>
+#include <arcticdb/util/configs_map.hpp>
+
+#include <atomic>
+
+namespace arcticdb {
+
+namespace {
+
+struct GlobalTaskArenaStats {
+    std::atomic<uint64_t> allocations_{0};
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> cached_frees_{0};
+    std::atomic<uint64_t> released_blocks_{0};
+    std::atomic<uint64_t> released_bytes_{0};
+    std::atomic<uint64_t> peak_cached_bytes_{0};
+};
+
+GlobalTaskArenaStats global_stats_;
+
+} // namespace
+
+TaskArenaStats TaskArena::global_stats() {
+    TaskArenaStats stats;
+    stats.allocations_ = global_stats_.allocations_.load();
+    stats.hits_ = global_stats_.hits_.load();
+    stats.cached_frees_ = global_stats_.cached_frees_.load();
+    stats.released_blocks_ = global_stats_.released_blocks_.load();
+    stats.released_bytes_ = global_stats_.released_bytes_.load();
+    stats.peak_cached_bytes_ = global_stats_.peak_cached_bytes_.load();
+    return stats;
+}
+
+void TaskArena::reset_global_stats() {
+    global_stats_.allocations_ = 0;
+    global_stats_.hits_ = 0;
+    global_stats_.cached_frees_ = 0;
+    global_stats_.released_blocks_ = 0;
+    global_stats_.released_bytes_ = 0;
+    global_stats_.peak_cached_bytes_ = 0;
+}
+
+// Arenas only add to the shared counters when their task ends, so that allocating doesn't contend on them
+void TaskArena::add_to_global_stats(const TaskArenaStats& stats) {
+    global_stats_.allocations_ += stats.allocations_;
+    global_stats_.hits_ += stats.hits_;
+    global_stats_.cached_frees_ += stats.cached_frees_;
+    global_stats_.released_blocks_ += stats.released_blocks_;
+    global_stats_.released_bytes_ += stats.released_bytes_;
+    auto peak = global_stats_.peak_cached_bytes_.load();
+    while(peak < stats.peak_cached_bytes_ && !global_stats_.peak_cached_bytes_.compare_exchange_weak(peak, stats.peak_cached_bytes_));
+}
+
+ScopedTaskArena::ScopedTaskArena() {
+    static const bool use_task_arena = ConfigsMap::instance()->get_int("Allocator.UseTaskArena", 1);
+    static const size_t max_cached_bytes = ConfigsMap::instance()->get_int("Allocator.TaskArenaMaxCachedBytes", 64 * 1024 * 1024);
+    if(use_task_arena && TaskArena::current_ == nullptr) {
+        arena_.emplace(max_cached_bytes);
+        TaskArena::current_ = &*arena_;
+    }
+}
+
+ScopedTaskArena::~ScopedTaskArena() {
+    if(arena_) {
+        TaskArena::current_ = nullptr;
+        arena_->release();
+        TaskArena::add_to_global_stats(arena_->stats());
+    }
+}
+
+} // namespace arcticdb
@@ -0,0 +1,160 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/util/constructors.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <vector>
+
+namespace arcticdb {
+
+struct TaskArenaStats {
+    uint64_t allocations_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t cached_frees_ = 0;
+    uint64_t released_blocks_ = 0;
+    uint64_t released_bytes_ = 0;
+    uint64_t peak_cached_bytes_ = 0;
+};
+
+/*
+ * Recycles freed allocations of power-of-two size classes for the duration of a task on one thread. Decoding and
+ * processing allocate and free many blocks of the same few sizes, which then come from the arena's free lists rather
+ * than from malloc, and every cached block is returned to malloc at once when the task ends.
+ *
+ * The arena only caches blocks that are freed, so blocks that outlive the task, such as the segments it returns, are
+ * ordinary malloc allocations that can be freed later on any thread. Pooled allocations made while an arena is active
+ * are rounded up to their class so that they can be reused for every request in it, and only blocks whose size is
+ * exactly a class are cached, so an unrounded block made without an arena is never handed out for a larger request.
+ */
+class TaskArena {
+public:
+    static constexpr size_t MinClassShift = 8;
+    static constexpr size_t MaxClassShift = 20;
+    static constexpr size_t NumClasses = MaxClassShift - MinClassShift + 1;
+    static constexpr size_t MaxClassSize = size_t(1) << MaxClassShift;
+
+    explicit TaskArena(size_t max_cached_bytes) :
+        max_cached_bytes_(max_cached_bytes) {
+    }
+
+    ARCTICDB_NO_MOVE_OR_COPY(TaskArena)
+
+    ~TaskArena() {
+        release();
+    }
+
+    static constexpr size_t class_index(size_t size) {
+        size_t index = 0;
+        while((size_t(1) << (index + MinClassShift)) < size)
+            ++index;
+
+        return index;
+    }
+
+    static constexpr size_t rounded_size(size_t size) {
+        return size > MaxClassSize ? size : size_t(1) << (class_index(size) + MinClassShift);
+    }
+
+    static constexpr bool is_class_size(size_t size) {
+        return size <= MaxClassSize && rounded_size(size) == size;
+    }
+
+    // Returns a cached block for an allocation of the given class size, or null if there is none
+    uint8_t* allocate(size_t size) {
+        ++stats_.allocations_;
+        if(!is_class_size(size))
+            return nullptr;
+
+        auto& free_list = free_lists_[class_index(size)];
+        if(free_list.empty())
+            return nullptr;
+
+        auto ptr = free_list.back();
+        free_list.pop_back();
+        cached_bytes_ -= size;
+        ++stats_.hits_;
+        return ptr;
+    }
+
+    // Caches a block of the given class size, returning false if the caller should free it instead
+    bool deallocate(uint8_t* ptr, size_t size) {
+        if(!is_class_size(size) || cached_bytes_ + size > max_cached_bytes_)
+            return false;
+
+        free_lists_[class_index(size)].push_back(ptr);
+        cached_bytes_ += size;
+        stats_.peak_cached_bytes_ = std::max(stats_.peak_cached_bytes_, static_cast<uint64_t>(cached_bytes_));
+        ++stats_.cached_frees_;
+        return true;
+    }
+
+    void release() {
+        for(auto& free_list : free_lists_) {
+            stats_.released_blocks_ += free_list.size();
+            for(auto ptr : free_list)
+                std::free(ptr);
+
+            free_list.clear();
+        }
+        stats_.released_bytes_ += cached_bytes_;
+        cached_bytes_ = 0;
+    }
+
+    [[nodiscard]] size_t cached_bytes() const {
+        return cached_bytes_;
+    }
+
+    [[nodiscard]] const TaskArenaStats& stats() const {
+        return stats_;
+    }
+
+    // The arena of the task running on this thread, if any
+    static TaskArena* current() {
+        return current_;
+    }
+
+    static TaskArenaStats global_stats();
+
+    static void reset_global_stats();
+
+private:
+    friend class ScopedTaskArena;
+
+    static void add_to_global_stats(const TaskArenaStats& stats);
+
+    std::array<std::vector<uint8_t*>, NumClasses> free_lists_;
+    size_t cached_bytes_ = 0;
+    size_t max_cached_bytes_;
+    TaskArenaStats stats_;
+
+    inline static thread_local TaskArena* current_ = nullptr;
+};
+
+/*
+ * Makes a task arena current on this thread until the end of the scope, when its cached blocks are freed. Nested
+ * scopes share the outermost arena, so that a task calling another task's code keeps its blocks until it finishes.
+ */
+class ScopedTaskArena {
+public:
+    ScopedTaskArena();
+
+    ARCTICDB_NO_MOVE_OR_COPY(ScopedTaskArena)
+
+    ~ScopedTaskArena();
+
+private:
+    std::optional<TaskArena> arena_;
+};
+
+} // namespace arcticdb
@@ -0,0 +1,66 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/util/file_mapped_allocator.hpp>
+#include <arcticdb/column_store/chunked_buffer.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <optional>
+
+using namespace arcticdb;
+
+TEST(FileMappedAllocator, OnlyInScope) {
+    const auto size = 3 * FileMappedAllocator::MinMappedSize;
+    ASSERT_EQ(ScopedFileMappedAllocation::current_directory(), nullptr);
+    auto outside_scope = ChunkedBuffer::presized(size);
+    ASSERT_FALSE(FileMappedAllocator::is_mapped_block(reinterpret_cast<uint8_t*>(outside_scope.blocks()[0])));
+
+    {
+        ScopedFileMappedAllocation scope{std::filesystem::temp_directory_path().string()};
+        // Too small to be worth a file
+        auto small = ChunkedBuffer::presized(1024);
+        ASSERT_FALSE(FileMappedAllocator::is_mapped_block(reinterpret_cast<uint8_t*>(small.blocks()[0])));
+    }
+    ASSERT_EQ(ScopedFileMappedAllocation::current_directory(), nullptr);
+}
+
+#ifndef _WIN32
+TEST(FileMappedAllocator, MapsAndUnmapsLargeBlocks) {
+    const auto size = 3 * FileMappedAllocator::MinMappedSize;
+    const auto mapped_before = FileMappedAllocator::mapped_bytes();
+    const auto directory = std::filesystem::temp_directory_path() / "arcticdb_test_file_mapped_allocator";
+    std::filesystem::create_directories(directory);
+    {
+        std::optional<ChunkedBuffer> buffer;
+        {
+            ScopedFileMappedAllocation scope{directory.string()};
+            buffer = ChunkedBuffer::presized(size);
+        }
+        auto block = reinterpret_cast<uint8_t*>(buffer->blocks()[0]);
+        ASSERT_TRUE(FileMappedAllocator::is_mapped_block(block));
+        ASSERT_EQ(FileMappedAllocator::mapped_bytes(), mapped_before + MemBlock::alloc_size(size));
+        // The file is unlinked once mapped, so the directory is left empty
+        ASSERT_TRUE(std::filesystem::is_empty(directory));
+
+        memset(buffer->data(), 1, size);
+        ASSERT_EQ(buffer->data()[size - 1], 1);
+    }
+    ASSERT_EQ(FileMappedAllocator::mapped_bytes(), mapped_before);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(FileMappedAllocator, FallsBackWhenDirectoryIsMissing) {
+    const auto size = 3 * FileMappedAllocator::MinMappedSize;
+    ScopedFileMappedAllocation scope{"/nonexistent/arcticdb_test_file_mapped_allocator"};
+    auto buffer = ChunkedBuffer::presized(size);
+    ASSERT_FALSE(FileMappedAllocator::is_mapped_block(reinterpret_cast<uint8_t*>(buffer.blocks()[0])));
+    memset(buffer.data(), 1, size);
+}
+#endif
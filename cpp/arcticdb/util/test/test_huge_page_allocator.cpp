@@ -0,0 +1,59 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/util/huge_page_allocator.hpp>
+#include <arcticdb/column_store/chunked_buffer.hpp>
+
+#include <cstring>
+#include <optional>
+
+using namespace arcticdb;
+
+TEST(HugePageAllocator, OnlyInScope) {
+    const auto size = 3 * HugePageAllocator::HugePageSize;
+    ASSERT_EQ(ScopedHugePageAllocation::current_mode(), HugePageMode::DISABLED);
+    auto outside_scope = ChunkedBuffer::presized(size);
+    ASSERT_FALSE(HugePageAllocator::is_huge_page_block(reinterpret_cast<uint8_t*>(outside_scope.blocks()[0])));
+
+    {
+        ScopedHugePageAllocation scope{HugePageMode::TRANSPARENT};
+        // Too small to be worth a huge page
+        auto small = ChunkedBuffer::presized(1024);
+        ASSERT_FALSE(HugePageAllocator::is_huge_page_block(reinterpret_cast<uint8_t*>(small.blocks()[0])));
+    }
+}
+
+#ifdef __linux__
+TEST(HugePageAllocator, MapsAndUnmapsLargeBlocks) {
+    const auto size = 3 * HugePageAllocator::HugePageSize;
+    const auto mapped_before = HugePageAllocator::mapped_bytes();
+    {
+        std::optional<ChunkedBuffer> buffer;
+        {
+            ScopedHugePageAllocation scope{HugePageMode::TRANSPARENT};
+            buffer = ChunkedBuffer::presized(size);
+        }
+        ASSERT_EQ(ScopedHugePageAllocation::current_mode(), HugePageMode::DISABLED);
+
+        auto block = reinterpret_cast<uint8_t*>(buffer->blocks()[0]);
+        ASSERT_TRUE(HugePageAllocator::is_huge_page_block(block));
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(block) % HugePageAllocator::HugePageSize, 0u);
+        ASSERT_EQ(HugePageAllocator::mapped_bytes(), mapped_before + 4 * HugePageAllocator::HugePageSize);
+
+        ASSERT_TRUE(HugePageAllocator::prefault(block));
+        memset(buffer->data(), 1, size);
+        ASSERT_EQ(buffer->data()[size - 1], 1);
+
+        // A block freed before it is prefaulted is left alone
+        buffer.reset();
+        ASSERT_FALSE(HugePageAllocator::prefault(block));
+    }
+    ASSERT_EQ(HugePageAllocator::mapped_bytes(), mapped_before);
+}
+#endif
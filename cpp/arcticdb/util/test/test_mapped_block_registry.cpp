@@ -0,0 +1,62 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/util/mapped_block_registry.hpp>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+
+using namespace arcticdb;
+
+namespace {
+
+uint8_t* map_anonymous(size_t size) {
+    auto ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return ptr == MAP_FAILED ? nullptr : static_cast<uint8_t*>(ptr);
+}
+
+} // namespace
+
+TEST(MappedBlockRegistry, UnmapsRegisteredBlocks) {
+    const size_t size = 64 * 1024;
+    MappedBlockRegistry registry;
+    auto block = map_anonymous(size);
+    ASSERT_NE(block, nullptr);
+    uint8_t other;
+    ASSERT_FALSE(registry.unmap(&other));
+
+    registry.add(block, size);
+    ASSERT_TRUE(registry.contains(block));
+    ASSERT_EQ(registry.mapped_bytes(), size);
+    ASSERT_TRUE(registry.unmap(block));
+    ASSERT_FALSE(registry.contains(block));
+    ASSERT_EQ(registry.mapped_bytes(), 0u);
+    ASSERT_FALSE(registry.unmap(block));
+}
+
+TEST(MappedBlockRegistry, PinnedBlockUnmappedOnUnpin) {
+    const size_t size = 64 * 1024;
+    MappedBlockRegistry registry;
+    auto block = map_anonymous(size);
+    ASSERT_NE(block, nullptr);
+    registry.add(block, size);
+
+    ASSERT_EQ(registry.pin(block), size);
+    ASSERT_TRUE(registry.unmap(block));
+    // Still mapped, but can't be pinned or freed again
+    ASSERT_FALSE(registry.contains(block));
+    ASSERT_FALSE(registry.pin(block).has_value());
+    ASSERT_FALSE(registry.unmap(block));
+    block[size - 1] = 1;
+    ASSERT_EQ(registry.mapped_bytes(), size);
+
+    registry.unpin(block);
+    ASSERT_EQ(registry.mapped_bytes(), 0u);
+}
+#endif
@@ -7,6 +7,7 @@
 
 #include <gtest/gtest.h> // googletest header file
 #include <unordered_map>
+#include <vector>
 
 #include <arcticdb/column_store/string_pool.hpp>
 #include <arcticdb/util/offset_string.hpp>
@@ -65,6 +66,46 @@ TEST(StringPool, StressTest) {
     timer.stop_timer(timer_name);
     GTEST_COUT << " " << timer.display_all() << std::endl;
 }
+
+TEST(StringPool, BatchMatchesSingleInserts) {
+    init_random(7);
+    auto distinct = random_string_vector(0x100);
+    std::vector<std::string_view> strings;
+    for (size_t i = 0; i < 3 * StringPool::BatchSize; ++i) {
+        // Include runs of the same string, some of which span batches
+        const auto& s = distinct[(i / 3) & 0xFF];
+        strings.emplace_back(s);
+    }
+
+    StringPool batch_pool;
+    std::vector<StringPool::offset_t> offsets(strings.size());
+    batch_pool.get_batch(strings.data(), strings.size(), offsets.data());
+
+    StringPool single_pool;
+    for (size_t i = 0; i < strings.size(); ++i) {
+        ASSERT_EQ(offsets[i], single_pool.get(strings[i]).offset());
+        ASSERT_EQ(batch_pool.get_view(offsets[i]), strings[i]);
+    }
+    ASSERT_EQ(batch_pool.size(), single_pool.size());
+
+    // Strings already in the pool are found rather than added again
+    const auto size = batch_pool.size();
+    std::vector<StringPool::offset_t> repeated(strings.size());
+    batch_pool.get_batch(strings.data(), strings.size(), repeated.data());
+    ASSERT_EQ(repeated, offsets);
+    ASSERT_EQ(batch_pool.size(), size);
+    ASSERT_TRUE(batch_pool.string_exists(strings[0]));
+    ASSERT_FALSE(batch_pool.string_exists("not in the pool"));
+}
+
+TEST(StringPool, CloneKeepsDeduplicating) {
+    StringPool pool;
+    auto offset = pool.get(std::string_view{"hello"}).offset();
+    auto clone = pool.clone();
+    ASSERT_EQ(clone->get(std::string_view{"hello"}).offset(), offset);
+    ASSERT_NE(clone->get(std::string_view{"world"}).offset(), offset);
+}
+
 //
 //TEST(StringPool, BitMagicTest) {
 //    bm::bvector<>   bv;
@@ -0,0 +1,97 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <gtest/gtest.h>
+
+#include <arcticdb/util/task_arena.hpp>
+#include <arcticdb/column_store/chunked_buffer.hpp>
+
+using namespace arcticdb;
+
+TEST(TaskArena, SizeClasses) {
+    ASSERT_EQ(TaskArena::rounded_size(1), 256u);
+    ASSERT_EQ(TaskArena::rounded_size(256), 256u);
+    ASSERT_EQ(TaskArena::rounded_size(257), 512u);
+    ASSERT_EQ(TaskArena::rounded_size(MemBlock::alloc_size(BufferSize)), 4096u);
+    ASSERT_EQ(TaskArena::rounded_size(TaskArena::MaxClassSize + 1), TaskArena::MaxClassSize + 1);
+    ASSERT_EQ(TaskArena::class_index(TaskArena::MaxClassSize), TaskArena::NumClasses - 1);
+    ASSERT_TRUE(TaskArena::is_class_size(4096));
+    ASSERT_FALSE(TaskArena::is_class_size(4000));
+    ASSERT_FALSE(TaskArena::is_class_size(TaskArena::MaxClassSize * 2));
+}
+
+TEST(TaskArena, RecyclesAndReleases) {
+    TaskArena arena{8192};
+    ASSERT_EQ(arena.allocate(4096), nullptr);
+
+    auto block = static_cast<uint8_t*>(std::malloc(4096));
+    ASSERT_TRUE(arena.deallocate(block, 4096));
+    ASSERT_EQ(arena.cached_bytes(), 4096u);
+    ASSERT_EQ(arena.allocate(2048), nullptr);
+    ASSERT_EQ(arena.allocate(4096), block);
+    ASSERT_EQ(arena.cached_bytes(), 0u);
+
+    // Blocks over the cache limit are left for the caller to free
+    auto other = static_cast<uint8_t*>(std::malloc(4096));
+    ASSERT_TRUE(arena.deallocate(block, 4096));
+    ASSERT_TRUE(arena.deallocate(other, 4096));
+    auto extra = static_cast<uint8_t*>(std::malloc(4096));
+    ASSERT_FALSE(arena.deallocate(extra, 4096));
+    std::free(extra);
+
+    arena.release();
+    ASSERT_EQ(arena.cached_bytes(), 0u);
+    ASSERT_EQ(arena.stats().hits_, 1u);
+    ASSERT_EQ(arena.stats().released_blocks_, 2u);
+    ASSERT_EQ(arena.stats().peak_cached_bytes_, 8192u);
+}
+
+TEST(TaskArena, ChunkedBufferBlocks) {
+    TaskArena::reset_global_stats();
+    ChunkedBuffer outlives_task;
+    {
+        ScopedTaskArena scope;
+        ASSERT_NE(TaskArena::current(), nullptr);
+        {
+            ScopedTaskArena nested;
+            ASSERT_NE(TaskArena::current(), nullptr);
+        }
+        outlives_task.ensure(BufferSize);
+        outlives_task.ensure(BufferSize * 2);
+        for(auto i = 0; i < 10; ++i) {
+            ChunkedBuffer temporary;
+            for(auto j = 1; j <= 4; ++j)
+                temporary.ensure(BufferSize * j);
+        }
+    }
+    ASSERT_EQ(TaskArena::current(), nullptr);
+
+    // Every temporary after the first reuses the blocks freed by the one before it
+    const auto stats = TaskArena::global_stats();
+    ASSERT_EQ(stats.hits_, 9u * 4u);
+    ASSERT_EQ(stats.released_blocks_, 4u);
+
+    outlives_task.ensure(BufferSize * 3);
+    outlives_task.clear();
+}
+
+TEST(TaskArena, RoundsOnlyWithinArena) {
+    const auto size = MemBlock::alloc_size(1000);
+    ASSERT_EQ(Allocator::pooled_size(size), size);
+
+    // A block made without an arena keeps its size, and isn't cached by an arena on the thread that frees it
+    auto [unrounded, ts] = Allocator::pooled_alloc(size);
+    ScopedTaskArena scope;
+    ASSERT_EQ(Allocator::pooled_size(size), TaskArena::rounded_size(size));
+    Allocator::pooled_free({unrounded, ts}, size);
+    ASSERT_EQ(TaskArena::current()->cached_bytes(), 0u);
+
+    const auto rounded = Allocator::pooled_size(size);
+    auto [block, block_ts] = Allocator::pooled_alloc(rounded);
+    Allocator::pooled_free({block, block_ts}, rounded);
+    ASSERT_EQ(TaskArena::current()->cached_bytes(), rounded);
+}
@@ -28,6 +28,7 @@ LocalVersionedEngine::LocalVersionedEngine(
     store_(std::make_shared<async::AsyncStore<util::SysClock>>(library, codec::default_lz4_codec())),
     symbol_list_(std::make_shared<SymbolList>(version_map_)){
     configure(library->config());
+    start_background_compaction();
     ARCTICDB_RUNTIME_DEBUG(log::version(), "Created versioned engine at {} for library path {}  with config {}", uintptr_t(this),
                          library->library_path(), [&cfg=cfg_]{  return util::format(cfg); });
 #ifdef USE_REMOTERY
@@ -67,6 +68,7 @@ FrameAndDescriptor LocalVersionedEngine::read_dataframe_internal(
     const ReadOptions& read_options) {
     ARCTICDB_RUNTIME_SAMPLE(ReadDataFrameInternal, 0)
     ARCTICDB_RUNTIME_DEBUG(log::version(), "Command: read_dataframe");
+    resolve_join_inputs(read_query);
     return read_dataframe_impl(
         store(),
         identifier,
@@ -226,6 +228,20 @@ IndexRange LocalVersionedEngine::get_index_range(
     return index::get_index_segment_range(version.value().key_, store());
 }
 
+void LocalVersionedEngine::resolve_join_inputs(const ReadQuery& read_query) {
+    for(const auto& join_input : read_query.join_inputs_) {
+        VersionQuery version_query;
+        if(join_input->version_id_)
+            version_query.set_version(*join_input->version_id_);
+
+        auto version = get_version_to_read(join_input->symbol_, version_query);
+        if(!version)
+            throw storage::NoDataFoundException(fmt::format("join: version not found for stream '{}'", join_input->symbol_));
+
+        join_input->resolve(store(), version->key_);
+    }
+}
+
 std::pair<VersionedItem, FrameAndDescriptor> LocalVersionedEngine::read_dataframe_version_internal(
     const StreamId &stream_id,
     const VersionQuery& version_query,
@@ -640,6 +656,8 @@ void LocalVersionedEngine::delete_trees_responsibly(
 
     read_opts.dont_warn_about_missing_key = true;
     auto data_keys_not_to_be_deleted = get_data_keys_set(store(), *not_to_delete, read_opts);
+    // Chained indexes reference earlier index keys, which are kept while a version that isn't deleted references them
+    data_keys_not_to_be_deleted.insert(not_to_delete->begin(), not_to_delete->end());
     not_to_delete.clear();
     log::version().debug("Forbidden: {} total of data keys", data_keys_not_to_be_deleted.size());
 
@@ -648,7 +666,8 @@ void LocalVersionedEngine::delete_trees_responsibly(
 
     std::vector<entity::VariantKey> vks;
     if (!dry_run) {
-        std::copy(keys_to_delete->begin(), keys_to_delete->end(), std::back_inserter(vks));
+        std::copy_if(keys_to_delete->begin(), keys_to_delete->end(), std::back_inserter(vks),
+                     [&](const auto& k) {return !data_keys_not_to_be_deleted.count(k);});
         store()->remove_keys(vks, remove_opts).get();
     }
 
@@ -731,11 +750,13 @@ VersionedItem LocalVersionedEngine::compact_incomplete_dynamic(
 
 folly::Future<FrameAndDescriptor> async_read_direct(
     const std::shared_ptr<Store>& store,
+    const AtomKey& index_key,
     SegmentInMemory&& index_segment,
     const ReadQuery& read_query,
     std::shared_ptr<BufferHolder> buffers,
     const ReadOptions& read_options) {
-    auto index_segment_reader = std::make_shared<index::IndexSegmentReader>(std::move(index_segment));
+    auto index_segment_reader = std::make_shared<index::IndexSegmentReader>(
+        index::resolve_index_chain(index::IndexSegmentReader{std::move(index_segment)}, index_key, store));
     auto pipeline_context = std::make_shared<PipelineContext>(StreamDescriptor{*index_segment_reader->mutable_tsd().mutable_stream_descriptor()});
     pipeline_context->set_selected_columns(read_query.columns);
     const bool dynamic_schema = opt_false(read_options.dynamic_schema_);
@@ -751,7 +772,7 @@ folly::Future<FrameAndDescriptor> async_read_direct(
 
     generate_filtered_field_descriptors(pipeline_context, read_query.columns);
     mark_index_slices(pipeline_context, dynamic_schema, bucketize_dynamic);
-    auto frame = allocate_frame(pipeline_context);
+    auto frame = allocate_frame(pipeline_context, read_options);
 
     return fetch_data(frame, pipeline_context, store, dynamic_schema, buffers).then(
         [pipeline_context, frame, &read_options] (auto&&) mutable {
@@ -777,7 +798,7 @@ std::pair<std::vector<AtomKey>, std::vector<FrameAndDescriptor>> LocalVersionedE
     auto i = 0u;
     util::check(read_queries.empty() || read_queries.size() == keys.size(), "Expected read queries to either be empty or equal to size of keys");
     for (auto&& [index_key, index_segment]: indexes) {
-        results_fut.push_back(async_read_direct(store(), std::move(index_segment), read_queries.empty() ? ReadQuery{} : read_queries[i++], std::make_shared<BufferHolder>(), read_options));
+        results_fut.push_back(async_read_direct(store(), to_atom(index_key), std::move(index_segment), read_queries.empty() ? ReadQuery{} : read_queries[i++], std::make_shared<BufferHolder>(), read_options));
     }
     Allocator::instance()->trim();
     return std::make_pair(keys, folly::collect(results_fut).get());
@@ -884,10 +905,22 @@ std::vector<AtomKey> LocalVersionedEngine::batch_append_internal(
     const WriteOptions& write_options,
     bool validate_index) {
 
+    // Read the index segments being appended to in one wave, rather than one read per symbol as each append starts
+    std::vector<folly::Future<std::pair<VariantKey, SegmentInMemory>>> index_reads;
+    index_reads.reserve(prevs.size());
+    for(const auto& prev : prevs)
+        index_reads.emplace_back(store()->read(prev));
+
+    auto index_segments = folly::collect(index_reads).get();
     std::vector<folly::Future<AtomKey>> append_futures;
     for(auto id : folly::enumerate(stream_ids)) {
         UpdateInfo update_info{prevs[id.index], version_ids[id.index]};
-        append_futures.emplace_back(async_append_impl(store(), update_info, std::move(frames[id.index]), write_options, validate_index));
+        append_futures.emplace_back(async_append_impl(store(),
+                                                      update_info,
+                                                      index::IndexSegmentReader{std::move(index_segments[id.index].second)},
+                                                      std::move(frames[id.index]),
+                                                      write_options,
+                                                      validate_index));
     }
 
     return folly::collect(append_futures).get();
@@ -1051,6 +1084,15 @@ void LocalVersionedEngine::delete_storage() {
     delete_all(store_, true);
 }
 
+void LocalVersionedEngine::start_background_compaction() {
+    // Compaction is only safe to run concurrently with writes when deletes are done with tombstones
+    if (!background_compaction_enabled() || !cfg().write_options().use_tombstones())
+        return;
+
+    version_map_compactor_ = std::make_shared<VersionMapCompactor>(store_, version_map_);
+    version_map_compactor_->start();
+}
+
 void LocalVersionedEngine::configure(const storage::LibraryDescriptor::VariantStoreConfig & cfg){
     util::variant_match(cfg,
                         [](std::monostate){ /* Unknown config */},
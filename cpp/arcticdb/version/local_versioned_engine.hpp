@@ -8,6 +8,7 @@
 #pragma once
 
 #include <arcticdb/version/version_map.hpp>
+#include <arcticdb/version/version_map_compactor.hpp>
 #include <arcticdb/async/async_store.hpp>
 #include <arcticdb/version/symbol_list.hpp>
 #include <arcticdb/version/snapshot.hpp>
@@ -106,6 +107,9 @@ public:
         ReadQuery& read_query,
         const ReadOptions& read_options) override;
 
+    // Reads the symbols joined by the query on the calling thread, so that its clauses never wait on storage
+    void resolve_join_inputs(const ReadQuery& read_query);
+
     std::pair<VersionedItem, FrameAndDescriptor> read_dataframe_version_internal(
         const StreamId &stream_id,
         const VersionQuery& version_query,
@@ -126,7 +130,7 @@ public:
         const std::vector<IndexTypeKey>& idx_to_be_deleted,
         const PreDeleteChecks& checks = default_pre_delete_checks
     ) override {
-        auto snapshot_map = get_master_snapshots_map(store());
+        auto snapshot_map = get_master_snapshots_map_for_keys(store(), idx_to_be_deleted);
         delete_trees_responsibly(idx_to_be_deleted, snapshot_map, std::nullopt, checks);
     };
 
@@ -297,6 +301,7 @@ protected:
 
     void set_store(std::shared_ptr<Store> store) override {
         store_ = std::move(store) ;
+        start_background_compaction();
     }
 
     /**
@@ -315,6 +320,9 @@ private:
     arcticdb::proto::storage::VersionStoreConfig cfg_;
     std::shared_ptr<VersionMap> version_map_ = std::make_shared<VersionMap>();
     std::shared_ptr<SymbolList> symbol_list_;
+    std::shared_ptr<VersionMapCompactor> version_map_compactor_;
+
+    void start_background_compaction();
 };
 
 } // arcticdb::version_store
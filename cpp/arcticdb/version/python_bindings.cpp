@@ -20,11 +20,35 @@
 #include <arcticdb/processing/execution_context.hpp>
 #include <arcticdb/pipeline/value_set.hpp>
 #include <arcticdb/python/adapt_read_dataframe.hpp>
+#include <arcticdb/pipeline/arrow_output_frame.hpp>
 #include <arcticdb/version/snapshot.hpp>
 #include <arcticdb/version/schema_checks.hpp>
 
 namespace arcticdb::version_store {
 
+namespace {
+
+// Capsules of the Arrow PyCapsule interface, which free the struct, releasing it first unless a consumer has moved it
+py::object arrow_schema_capsule(ArrowSchema* schema) {
+    return py::reinterpret_steal<py::object>(PyCapsule_New(schema, "arrow_schema", [](PyObject* capsule) {
+        auto schema = static_cast<ArrowSchema*>(PyCapsule_GetPointer(capsule, "arrow_schema"));
+        if(schema->release)
+            schema->release(schema);
+        delete schema;
+    }));
+}
+
+py::object arrow_array_capsule(ArrowArray* array) {
+    return py::reinterpret_steal<py::object>(PyCapsule_New(array, "arrow_array", [](PyObject* capsule) {
+        auto array = static_cast<ArrowArray*>(PyCapsule_GetPointer(capsule, "arrow_array"));
+        if(array->release)
+            array->release(array);
+        delete array;
+    }));
+}
+
+}
+
 void register_bindings(py::module &m) {
     auto version = m.def_submodule("version_store", "Versioned storage implementation apis");
 
@@ -164,10 +188,19 @@ void register_bindings(py::module &m) {
 
   //  version.def("ValueList", &construct_value_list);
 
+    py::enum_<ResampleBoundary>(version, "ResampleBoundary")
+            .value("LEFT", ResampleBoundary::left)
+            .value("RIGHT", ResampleBoundary::right);
+
+    py::enum_<JoinType>(version, "JoinType")
+            .value("INNER", JoinType::INNER)
+            .value("LEFT", JoinType::LEFT);
+
     py::class_<ClauseBuilder>(version, "ClauseBuilder")
             .def(py::init())
             .def("add_ProjectClause", &ClauseBuilder::add_ProjectClause)
             .def("add_FilterClause", &ClauseBuilder::add_FilterClause)
+            .def("add_GlobalSortClause", &ClauseBuilder::add_GlobalSortClause)
             .def("prepare_AggregationClause", &ClauseBuilder::prepare_AggregationClause)
             .def("add_MeanAggregationOperator", [&](ClauseBuilder& v,  std::string input_column, std::string output_column) {
                 return v.add_MeanAggregationOperator(ColumnName(input_column), ColumnName(output_column));
@@ -181,7 +214,19 @@ void register_bindings(py::module &m) {
             .def("add_MinAggregationOperator", [&](ClauseBuilder& v,  std::string input_column, std::string output_column) {
                 return v.add_MinAggregationOperator(ColumnName(input_column), ColumnName(output_column));
             })
-        .def("finalize_AggregationClause", &ClauseBuilder::finalize_AggregationClause);
+            .def("add_FirstAggregationOperator", [&](ClauseBuilder& v,  std::string input_column, std::string output_column) {
+                return v.add_FirstAggregationOperator(ColumnName(input_column), ColumnName(output_column));
+            })
+            .def("add_LastAggregationOperator", [&](ClauseBuilder& v,  std::string input_column, std::string output_column) {
+                return v.add_LastAggregationOperator(ColumnName(input_column), ColumnName(output_column));
+            })
+        .def("finalize_AggregationClause", &ClauseBuilder::finalize_AggregationClause)
+        .def("prepare_ResampleClause", &ClauseBuilder::prepare_ResampleClause)
+        .def("finalize_ResampleClause", &ClauseBuilder::finalize_ResampleClause)
+        .def("add_AsOfJoinClause", &ClauseBuilder::add_AsOfJoinClause)
+        .def("add_HashJoinClause", &ClauseBuilder::add_HashJoinClause)
+        .def("set_HeadLimit", &ClauseBuilder::set_HeadLimit)
+        .def("set_TailLimit", &ClauseBuilder::set_TailLimit);
 
     py::class_<VersionQuery>(version, "PythonVersionStoreVersionQuery")
         .def(py::init())
@@ -199,7 +244,10 @@ void register_bindings(py::module &m) {
         .def("set_incompletes", &ReadOptions::set_incompletes)
         .def("set_set_tz", &ReadOptions::set_set_tz)
         .def("set_optimise_string_memory", &ReadOptions::set_optimise_string_memory)
-        .def_property_readonly("incompletes", &ReadOptions::get_incompletes);
+        .def("set_arrow_output", &ReadOptions::set_arrow_output)
+        .def("set_output_mmap_dir", &ReadOptions::set_output_mmap_dir)
+        .def_property_readonly("incompletes", &ReadOptions::get_incompletes)
+        .def_property_readonly("arrow_output", &ReadOptions::get_arrow_output);
 
     using FrameDataWrapper = arcticdb::pipelines::FrameDataWrapper;
     py::class_<FrameDataWrapper, std::shared_ptr<FrameDataWrapper>>(version, "FrameDataWrapper")
@@ -219,7 +267,23 @@ void register_bindings(py::module &m) {
             return self.frame().offset();
         })
         .def_property_readonly("names", &PythonOutputFrame::names, py::return_value_policy::reference)
-        .def_property_readonly("index_columns", &PythonOutputFrame::index_columns, py::return_value_policy::reference);
+        .def_property_readonly("index_columns", &PythonOutputFrame::index_columns, py::return_value_policy::reference)
+        .def("arrow", [](PythonOutputFrame& self) {
+            return arcticdb::pipelines::ArrowOutputFrame{self.frame()};
+        });
+
+    using ArrowOutputFrame = arcticdb::pipelines::ArrowOutputFrame;
+    py::class_<ArrowOutputFrame>(version, "ArrowOutputFrame")
+        .def(py::init<const SegmentInMemory&>())
+        .def_property_readonly("names", &ArrowOutputFrame::names, py::return_value_policy::reference)
+        .def_property_readonly("index_columns", &ArrowOutputFrame::index_columns, py::return_value_policy::reference)
+        .def("__arrow_c_array__", [](const ArrowOutputFrame& self, const py::object&) {
+            auto schema = std::make_unique<ArrowSchema>();
+            auto array = std::make_unique<ArrowArray>();
+            self.export_record_batch(array.get(), schema.get());
+            auto schema_capsule = arrow_schema_capsule(schema.release());
+            return py::make_tuple(schema_capsule, arrow_array_capsule(array.release()));
+        }, py::arg("requested_schema") = py::none());
 
 
     // TODO: add repr.
@@ -466,6 +530,9 @@ void register_bindings(py::module &m) {
         .def("write_versioned_dataframe",
              &PythonVersionStore::write_versioned_dataframe,
              "Write the most recent version of this dataframe to the store")
+        .def("write_versioned_arrow",
+             &PythonVersionStore::write_versioned_arrow,
+             "Write an Arrow record batch as the most recent version of this symbol")
         .def("write_versioned_composite_data",
              &PythonVersionStore::write_versioned_composite_data,
              "Allows the user to write multiple dataframes in a batch with one version entity")
@@ -8,14 +8,29 @@
 #include <arcticdb/version/snapshot.hpp>
 #include <arcticdb/storage/storage.hpp>
 #include <arcticdb/version/version_log.hpp>
+#include <arcticdb/stream/index_aggregator.hpp>
+#include <arcticdb/util/configs_map.hpp>
+#include <arcticdb/util/storage_lock.hpp>
+#include <arcticdb/util/constants.hpp>
+
+#include <map>
+#include <mutex>
 
 using namespace arcticdb::entity;
 using namespace arcticdb::stream;
 
 namespace arcticdb {
 
+namespace {
+
+bool snapshot_membership_enabled() {
+    return ConfigsMap::instance()->get_int("Snapshot.MembershipIndex", 0) != 0;
+}
+
+} //namespace
+
 void write_snapshot_entry(
-        std::shared_ptr <StreamSink> store,
+        std::shared_ptr <Store> store,
         std::vector <AtomKey> &keys,
         const SnapshotId &snapshot_id,
         const py::object &user_meta,
@@ -45,18 +60,24 @@ void write_snapshot_entry(
     }
 
     snapshot_agg.commit();
+    add_snapshot_membership(store, snapshot_id, keys);
     if (log_changes) {
         log_create_snapshot(store, snapshot_id);
     }
 }
 
 void tombstone_snapshot(
-    std::shared_ptr<StreamSink> store,
+    std::shared_ptr<Store> store,
     const RefKey& key,
     SegmentInMemory&& segment_in_memory,
     bool log_changes
 ) {
+    std::vector<AtomKey> snapshot_keys;
+    for (size_t idx = 0; idx < segment_in_memory.row_count(); idx++)
+        snapshot_keys.emplace_back(read_key_row(segment_in_memory, idx));
+
     store->remove_key_sync(key); // Make the snapshot "disappear" to normal APIs
+    remove_snapshot_membership(store, key.id(), snapshot_keys);
     if (log_changes) {
         log_delete_snapshot(store, key.id());
     }
@@ -87,8 +108,14 @@ void tombstone_snapshot(
         bool log_changes
         ) {
     try {
-        auto key_segment_pair = store->read_compressed(key).get();
-        tombstone_snapshot(store, std::move(key_segment_pair), log_changes);
+        if (snapshot_membership_enabled()) {
+            // The membership index needs the contents of the snapshot to remove it
+            auto [snapshot_key, snapshot_segment] = store->read_sync(key);
+            tombstone_snapshot(store, key, std::move(snapshot_segment), log_changes);
+        } else {
+            auto key_segment_pair = store->read_compressed(key).get();
+            tombstone_snapshot(store, std::move(key_segment_pair), log_changes);
+        }
     } catch (const storage::KeyNotFoundException& e) {
         log::version().info("Cannot tombstone snapshot {}, key does not exist on the store", key);
     } catch (const std::exception& e) {
@@ -186,6 +213,12 @@ std::unordered_set<entity::AtomKey> get_index_keys_in_snapshots(
     ARCTICDB_SAMPLE(GetIndexKeysInSnapshot, 0)
 
     std::unordered_set<entity::AtomKey> index_keys_in_snapshots{};
+    if (auto membership = get_snapshot_membership(store, stream_id)) {
+        for (const auto& [index_key, snapshot_ids] : *membership)
+            index_keys_in_snapshots.insert(index_key);
+
+        return index_keys_in_snapshots;
+    }
 
     iterate_snapshots(store, [&](VariantKey &vk) {
         bool snapshot_using_ref = variant_key_type(vk) == KeyType::SNAPSHOT_REF;
@@ -363,4 +396,314 @@ MasterSnapshotMap get_master_snapshots_map(
     return out;
 }
 
+namespace {
+
+const StreamId snapshot_membership_coverage_id{"__snapshot_membership__"};
+const char* const SnapshotMembershipLockName = "SnapshotMembershipLock";
+const char* const SnapshotIdColumn = "snapshot_id";
+constexpr timestamp DEFAULT_COVERAGE_CHECK_INTERVAL = ONE_SECOND * 2;
+
+// When the index of each store was last found to cover exactly the snapshots in storage
+struct CoverageChecks {
+    std::mutex mutex_;
+    std::map<std::weak_ptr<Store>, timestamp, std::owner_less<>> checked_;
+};
+
+CoverageChecks& coverage_checks() {
+    static CoverageChecks checks;
+    return checks;
+}
+
+bool coverage_recently_checked(const std::shared_ptr<Store>& store) {
+    const timestamp interval = ConfigsMap::instance()->get_int("Snapshot.MembershipCheckInterval", DEFAULT_COVERAGE_CHECK_INTERVAL);
+    auto& checks = coverage_checks();
+    std::lock_guard lock(checks.mutex_);
+    auto it = checks.checked_.find(store);
+    return it != checks.checked_.end() && util::SysClock::coarse_nanos_since_epoch() - it->second < interval;
+}
+
+void set_coverage_checked(const std::shared_ptr<Store>& store, bool checked) {
+    auto& checks = coverage_checks();
+    std::lock_guard lock(checks.mutex_);
+    for (auto it = checks.checked_.begin(); it != checks.checked_.end();) {
+        if (it->first.expired())
+            it = checks.checked_.erase(it);
+        else
+            ++it;
+    }
+    if (checked)
+        checks.checked_.insert_or_assign(std::weak_ptr<Store>{store}, util::SysClock::coarse_nanos_since_epoch());
+    else
+        checks.checked_.erase(store);
+}
+
+std::string snapshot_name(const SnapshotId& snapshot_id) {
+    return fmt::format("{}", snapshot_id);
+}
+
+RefKey coverage_key() {
+    return RefKey{snapshot_membership_coverage_id, KeyType::SNAPSHOT_MEMBERSHIP};
+}
+
+std::optional<std::set<std::string>> read_coverage(const std::shared_ptr<Store>& store) {
+    try {
+        auto [key, seg] = store->read_sync(coverage_key());
+        std::set<std::string> output;
+        for (size_t idx = 0; idx < seg.row_count(); idx++)
+            output.emplace(seg.string_at(idx, 0).value());
+
+        return output;
+    } catch (const storage::KeyNotFoundException&) {
+        return std::nullopt;
+    }
+}
+
+void write_coverage(const std::shared_ptr<Store>& store, const std::set<std::string>& snapshot_names) {
+    SegmentInMemory seg{StreamDescriptor{stream_descriptor(snapshot_membership_coverage_id, RowCountIndex(), {
+        scalar_field_proto(DataType::UTF_DYNAMIC64, SnapshotIdColumn)})}};
+    for (const auto& name : snapshot_names) {
+        seg.set_string(0, name);
+        seg.end_row();
+    }
+    store->write_sync(KeyType::SNAPSHOT_MEMBERSHIP, snapshot_membership_coverage_id, std::move(seg));
+}
+
+void remove_coverage(const std::shared_ptr<Store>& store) {
+    set_coverage_checked(store, false);
+    store->remove_key_sync(coverage_key(), storage::RemoveOpts{true});
+}
+
+std::set<std::string> list_snapshot_names(const std::shared_ptr<Store>& store) {
+    std::set<std::string> output;
+    for (auto key_type : {KeyType::SNAPSHOT_REF, KeyType::SNAPSHOT}) {
+        store->iterate_type(key_type, [&output](VariantKey&& vk) {
+            output.emplace(snapshot_name(variant_key_id(vk)));
+        });
+    }
+    return output;
+}
+
+SnapshotMembership membership_from_segment(const SegmentInMemory& seg) {
+    SnapshotMembership output;
+    if (seg.row_count() == 0)
+        return output;
+
+    const auto snapshot_column = seg.column_index(SnapshotIdColumn);
+    util::check(snapshot_column.has_value(), "Expected {} column in snapshot membership segment", SnapshotIdColumn);
+    for (size_t idx = 0; idx < seg.row_count(); idx++) {
+        auto snapshot_id = seg.string_at(idx, *snapshot_column);
+        util::check(snapshot_id.has_value(), "Missing snapshot id in snapshot membership row {}", idx);
+        output[read_key_row(seg, idx)].emplace(std::string{*snapshot_id});
+    }
+    return output;
+}
+
+SegmentInMemory membership_to_segment(const StreamId& stream_id, const SnapshotMembership& membership) {
+    auto desc = idx_stream_desc(stream_id, RowCountIndex{});
+    const auto snapshot_column = desc.field_count();
+    desc.add_scalar_field(DataType::UTF_DYNAMIC64, SnapshotIdColumn);
+    SegmentInMemory seg{std::move(desc)};
+    for (const auto& [index_key, snapshot_ids] : membership) {
+        for (const auto& snapshot_id : snapshot_ids) {
+            seg.set_string(snapshot_column, snapshot_name(snapshot_id));
+            write_key_to_segment(seg, index_key);
+        }
+    }
+    return seg;
+}
+
+std::unordered_map<StreamId, SnapshotMembership> read_memberships(
+        const std::shared_ptr<Store>& store,
+        const std::vector<StreamId>& stream_ids) {
+    std::vector<folly::Future<std::pair<VariantKey, SegmentInMemory>>> reads;
+    reads.reserve(stream_ids.size());
+    for (const auto& stream_id : stream_ids)
+        reads.emplace_back(store->read(RefKey{stream_id, KeyType::SNAPSHOT_MEMBERSHIP}));
+
+    auto results = folly::collectAll(reads).get();
+    std::unordered_map<StreamId, SnapshotMembership> output;
+    for (size_t idx = 0; idx < stream_ids.size(); idx++) {
+        if (results[idx].hasException<storage::KeyNotFoundException>())
+            output.try_emplace(stream_ids[idx]);
+        else
+            output.try_emplace(stream_ids[idx], membership_from_segment(results[idx].value().second));
+    }
+    return output;
+}
+
+void write_memberships(
+        const std::shared_ptr<Store>& store,
+        const std::unordered_map<StreamId, SnapshotMembership>& memberships) {
+    std::vector<folly::Future<folly::Unit>> writes;
+    writes.reserve(memberships.size());
+    for (const auto& [stream_id, membership] : memberships) {
+        if (membership.empty())
+            writes.emplace_back(store->remove_key(RefKey{stream_id, KeyType::SNAPSHOT_MEMBERSHIP}, storage::RemoveOpts{true}).unit());
+        else
+            writes.emplace_back(store->write(KeyType::SNAPSHOT_MEMBERSHIP, stream_id, membership_to_segment(stream_id, membership)).unit());
+    }
+    folly::collect(writes).get();
+}
+
+std::vector<StreamId> symbols_of_keys(const std::vector<AtomKey>& keys) {
+    std::unordered_set<StreamId> stream_ids;
+    for (const auto& key : keys)
+        stream_ids.insert(key.id());
+
+    return {stream_ids.begin(), stream_ids.end()};
+}
+
+// Returns true if the index covers exactly the snapshots in storage, rebuilding it first if it doesn't. Listing the
+// snapshots is as costly as the lookups the index saves, so when allow_cached is set it is only repeated once the
+// check interval has passed. Another process may drop the coverage within the interval without updating the index, so
+// callers that delete keys based on the result must not allow a cached check
+bool snapshot_membership_usable(const std::shared_ptr<Store>& store, bool allow_cached) {
+    if (!snapshot_membership_enabled())
+        return false;
+
+    if (allow_cached && coverage_recently_checked(store))
+        return true;
+
+    try {
+        if (auto coverage = read_coverage(store); coverage && *coverage == list_snapshot_names(store)) {
+            set_coverage_checked(store, true);
+            return true;
+        }
+
+        log::version().info("Snapshot membership index is missing or out of date, rebuilding");
+        return rebuild_snapshot_membership(store);
+    } catch (const std::exception& e) {
+        log::version().warn("Could not use snapshot membership index: {}", e.what());
+        return false;
+    }
+}
+
+// Applies update to the index, if it has been built, under the storage lock. If the lock can't be taken or the update
+// fails then the coverage is dropped, so that the index is not used until rebuilt
+template<typename Update>
+void update_snapshot_membership(const std::shared_ptr<Store>& store, Update&& update) {
+    try {
+        if (!read_coverage(store))
+            return;
+
+        StorageLock lock{SnapshotMembershipLockName};
+        if (!lock.try_lock(store)) {
+            log::version().info("Could not lock snapshot membership index, dropping it to be rebuilt");
+            remove_coverage(store);
+            return;
+        }
+        OnExit on_exit([&lock, &store]() { lock.unlock(store); });
+        // Read again inside the lock, as it may have been dropped or rebuilt in the meantime
+        auto coverage = read_coverage(store);
+        if (!coverage)
+            return;
+
+        try {
+            update(*coverage);
+            write_coverage(store, *coverage);
+        } catch (const std::exception& e) {
+            log::version().warn("Failed to update snapshot membership index, dropping it to be rebuilt: {}", e.what());
+            remove_coverage(store);
+        }
+    } catch (const storage::PermissionException&) {
+        ARCTICDB_DEBUG(log::version(), "Can't update snapshot membership index in read-only mode");
+    }
+}
+
+} //namespace
+
+std::optional<SnapshotMembership> get_snapshot_membership(
+        const std::shared_ptr<Store>& store,
+        const StreamId& stream_id,
+        bool allow_cached) {
+    if (!snapshot_membership_usable(store, allow_cached))
+        return std::nullopt;
+
+    return std::move(read_memberships(store, {stream_id}).at(stream_id));
+}
+
+MasterSnapshotMap get_master_snapshots_map_for_keys(
+        const std::shared_ptr<Store>& store,
+        const std::vector<IndexTypeKey>& keys) {
+    if (!snapshot_membership_usable(store, false))
+        return get_master_snapshots_map(store);
+
+    MasterSnapshotMap output;
+    for (auto&& [stream_id, membership] : read_memberships(store, symbols_of_keys(keys))) {
+        if (!membership.empty())
+            output.try_emplace(stream_id, std::move(membership));
+    }
+    return output;
+}
+
+bool rebuild_snapshot_membership(const std::shared_ptr<Store>& store) {
+    StorageLock lock{SnapshotMembershipLockName};
+    if (!lock.try_lock(store)) {
+        ARCTICDB_DEBUG(log::version(), "Snapshot membership index is locked, not rebuilding");
+        return false;
+    }
+    OnExit on_exit([&lock, &store]() { lock.unlock(store); });
+    remove_coverage(store);
+
+    std::set<std::string> snapshot_names;
+    std::unordered_map<StreamId, SnapshotMembership> memberships;
+    iterate_snapshots(store, [&store, &snapshot_names, &memberships](VariantKey& sk) {
+        auto snapshot_segment = store->read_sync(sk).second;
+        SnapshotId snapshot_id{snapshot_name(variant_key_id(sk))};
+        for (size_t idx = 0; idx < snapshot_segment.row_count(); idx++) {
+            auto index_key = read_key_row(snapshot_segment, idx);
+            memberships[index_key.id()][index_key].insert(snapshot_id);
+        }
+        snapshot_names.insert(snapshot_name(snapshot_id));
+    });
+
+    std::vector<VariantKey> stale;
+    store->iterate_type(KeyType::SNAPSHOT_MEMBERSHIP, [&stale, &memberships](VariantKey&& vk) {
+        const auto& stream_id = variant_key_id(vk);
+        if (stream_id != snapshot_membership_coverage_id && memberships.find(stream_id) == memberships.end())
+            stale.emplace_back(std::move(vk));
+    });
+    store->remove_keys(stale, storage::RemoveOpts{true}).get();
+
+    write_memberships(store, memberships);
+    write_coverage(store, snapshot_names);
+    set_coverage_checked(store, true);
+    log::version().info("Rebuilt snapshot membership index for {} snapshots and {} symbols",
+                        snapshot_names.size(), memberships.size());
+    return true;
+}
+
+void add_snapshot_membership(
+        const std::shared_ptr<Store>& store,
+        const SnapshotId& snapshot_id,
+        const std::vector<AtomKey>& keys) {
+    update_snapshot_membership(store, [&](std::set<std::string>& coverage) {
+        auto memberships = read_memberships(store, symbols_of_keys(keys));
+        for (const auto& key : keys)
+            memberships[key.id()][key].insert(SnapshotId{snapshot_name(snapshot_id)});
+
+        write_memberships(store, memberships);
+        coverage.insert(snapshot_name(snapshot_id));
+    });
+}
+
+void remove_snapshot_membership(
+        const std::shared_ptr<Store>& store,
+        const SnapshotId& snapshot_id,
+        const std::vector<AtomKey>& keys) {
+    update_snapshot_membership(store, [&](std::set<std::string>& coverage) {
+        auto memberships = read_memberships(store, symbols_of_keys(keys));
+        for (const auto& key : keys) {
+            auto& membership = memberships[key.id()];
+            if (auto it = membership.find(key); it != membership.end()) {
+                it->second.erase(SnapshotId{snapshot_name(snapshot_id)});
+                if (it->second.empty())
+                    membership.erase(it);
+            }
+        }
+        write_memberships(store, memberships);
+        coverage.erase(snapshot_name(snapshot_id));
+    });
+}
+
 }
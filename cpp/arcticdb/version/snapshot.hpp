@@ -36,7 +36,7 @@ struct SnapshotRefData {
 };
 
 void write_snapshot_entry(
-    std::shared_ptr <StreamSink> store,
+    std::shared_ptr <Store> store,
     std::vector <AtomKey> &keys,
     const SnapshotId &snapshot_id,
     const py::object &user_meta,
@@ -45,7 +45,7 @@ void write_snapshot_entry(
 );
 
 void tombstone_snapshot(
-    std::shared_ptr<StreamSink> store,
+    std::shared_ptr<Store> store,
     const RefKey& key,
     SegmentInMemory&& segment_in_memory,
     bool log_changes
@@ -128,4 +128,52 @@ MasterSnapshotMap get_master_snapshots_map(
     const std::optional<const std::tuple<const SnapshotVariantKey&, std::vector<IndexTypeKey>&>>& get_keys_in_snapshot =
             std::nullopt
 );
+
+/*
+ * SNAPSHOT MEMBERSHIP INDEX
+ * When Snapshot.MembershipIndex is set, the snapshots that contain each index key are kept in a reverse index, so that
+ * finding the snapshotted versions of a symbol reads one key rather than every snapshot in the library. It consists of
+ * one SNAPSHOT_MEMBERSHIP ref key per symbol that is in any snapshot, holding (index key, snapshot name) rows, and one
+ * with a reserved id holding the names of the snapshots the index covers.
+ *
+ * The index is only used when the covered names match the snapshots listed in storage, so snapshots written or
+ * deleted by a client that does not maintain it cause a fallback to reading the snapshots (and a rebuild) rather than
+ * a wrong answer. It is built lazily on first use, and updated under a storage lock when snapshots are written or
+ * removed; if the lock cannot be taken the coverage is dropped, forcing a rebuild. Snapshots modified in place by
+ * clients that do not maintain the index are not detected, so it should only be enabled once every writer to the
+ * library maintains it.
+ *
+ * Lookups that only report snapshot membership, such as list_versions, may skip listing the snapshots for
+ * Snapshot.MembershipCheckInterval nanoseconds (two seconds by default) after the last check, so they can briefly
+ * miss such changes. Anything that decides which keys are safe to delete always checks the coverage in storage.
+ */
+using SnapshotMembership = MasterSnapshotMap::mapped_type;
+
+// Returns the snapshot membership of the index keys of the symbol, or std::nullopt if the index is disabled or cannot
+// be used or built. allow_cached lets a recent check of the coverage be reused, and must not be set when the result
+// decides what to delete
+std::optional<SnapshotMembership> get_snapshot_membership(
+    const std::shared_ptr<Store>& store,
+    const StreamId& stream_id,
+    bool allow_cached = false);
+
+// As get_master_snapshots_map, but only guaranteed to cover the symbols of the given keys, which lets it use the
+// snapshot membership index rather than reading every snapshot when the index is enabled
+MasterSnapshotMap get_master_snapshots_map_for_keys(
+    const std::shared_ptr<Store>& store,
+    const std::vector<IndexTypeKey>& keys);
+
+// Rebuilds the whole index from the snapshots in storage, returns false if the storage lock could not be taken
+bool rebuild_snapshot_membership(const std::shared_ptr<Store>& store);
+
+// Update the index, if it has been built, for a snapshot that has been written or removed
+void add_snapshot_membership(
+    const std::shared_ptr<Store>& store,
+    const SnapshotId& snapshot_id,
+    const std::vector<AtomKey>& keys);
+
+void remove_snapshot_membership(
+    const std::shared_ptr<Store>& store,
+    const SnapshotId& snapshot_id,
+    const std::vector<AtomKey>& keys);
 }
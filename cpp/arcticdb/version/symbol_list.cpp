@@ -26,7 +26,7 @@ static const StreamId compaction_id {CompactionId};
                 if (lock.try_lock(store)) {
                     SYMBOL_LIST_RUNTIME_LOG("Got lock");
                     OnExit on_exit([&, store = store]() { lock.unlock(store); });
-                    write_symbols(store, symbols, compaction_id, creation_ts).get();
+                    cache_compaction(write_symbols(store, symbols, compaction_id, creation_ts).get(), symbols);
                     delete_keys(store, all_keys);
                 } else {
                     SYMBOL_LIST_RUNTIME_LOG("Not writing symbols as another write is in progress");
@@ -45,9 +45,11 @@ static const StreamId compaction_id {CompactionId};
                 SYMBOL_LIST_RUNTIME_LOG("Symbol chain too long, doing compaction");
                 return compact(store, all_keys);
             }
+            else if(maybe_last_compaction) {
+                return load_from_cached_compaction(store, all_keys, maybe_last_compaction.value());
+            }
             else {
-                auto compaction_and_deltas = KeyVector{all_keys.begin() + maybe_last_compaction.value_or(0), all_keys.end()};
-                return load_from_storage(store, compaction_and_deltas);
+                return load_from_storage(store, all_keys);
             }
         }
     }
@@ -63,8 +65,7 @@ static const StreamId compaction_id {CompactionId};
                 // is just finishing (N.B. unlikely)
                 auto all_symbols = get_all_symbol_list_keys(store);
                 auto symbols = load_from_storage(store, all_symbols);
-                write_symbols(store, symbols, compaction_id, symbol_keys.rbegin()->creation_ts()).get();
-
+                cache_compaction(write_symbols(store, symbols, compaction_id, symbol_keys.rbegin()->creation_ts()).get(), symbols);
 
                 delete_keys(store, all_symbols);
                 return symbols;
@@ -82,6 +83,58 @@ static const StreamId compaction_id {CompactionId};
         return load_from_storage(store, all_symbols);
     }
 
+    SymbolList::CollectionType SymbolList::load_from_cached_compaction(
+            const std::shared_ptr<StreamSource>& store,
+            const KeyVector& keys,
+            KeyVector::difference_type compaction_pos) {
+        const auto& compaction_key = keys[compaction_pos];
+        const auto deltas_begin = keys.begin() + compaction_pos + 1;
+        const auto num_deltas = static_cast<size_t>(std::distance(deltas_begin, keys.end()));
+
+        std::lock_guard lock{cache_mutex_};
+        if(!cache_ || cache_->compaction_key_ != compaction_key) {
+            SYMBOL_LIST_RUNTIME_LOG("Reading compacted symbol list {}", compaction_key);
+            CollectionType compacted;
+            read_list_from_storage(store, compaction_key, compacted);
+            cache_ = CachedSymbols{compaction_key, std::move(compacted), {}, {}};
+            cache_->symbols_ = cache_->compacted_symbols_;
+        }
+
+        auto& applied = cache_->applied_deltas_;
+        if(applied.size() > num_deltas || !std::equal(applied.begin(), applied.end(), deltas_begin)) {
+            // Journal entries have arrived out of timestamp order, or been removed, so replay them all
+            SYMBOL_LIST_RUNTIME_LOG("Journal entries changed since last load, replaying {} entries", num_deltas);
+            applied.clear();
+            cache_->symbols_ = cache_->compacted_symbols_;
+        }
+
+        const auto new_deltas_begin = deltas_begin + applied.size();
+        SYMBOL_LIST_RUNTIME_LOG("Applying {} new journal entries", std::distance(new_deltas_begin, keys.end()));
+        for(auto it = new_deltas_begin; it != keys.end(); ++it)
+            apply_delta(*it, cache_->symbols_);
+
+        applied.insert(applied.end(), new_deltas_begin, keys.end());
+        return cache_->symbols_;
+    }
+
+    void SymbolList::cache_compaction(const VariantKey& compaction_key, const CollectionType& symbols) {
+        std::lock_guard lock{cache_mutex_};
+        cache_ = CachedSymbols{to_atom(compaction_key), symbols, {}, symbols};
+    }
+
+    void SymbolList::apply_delta(const AtomKey& key, CollectionType& symbols) {
+        const auto& action = key.id();
+        const auto& symbol = key.start_index();
+        if(action == StreamId{DeleteSymbol}) {
+            ARCTICDB_DEBUG(log::version(), "Got delete action for symbol '{}'", symbol);
+            symbols.erase(symbol);
+        }
+        else {
+            ARCTICDB_DEBUG(log::version(), "Got insert action for symbol '{}'", symbol);
+            symbols.insert(symbol);
+        }
+    }
+
     void SymbolList::write_journal(const std::shared_ptr<Store>& store, const StreamId& symbol, std::string action) {
         SegmentInMemory seg{journal_stream_descriptor(action, symbol)};
         util::variant_match(symbol,
@@ -157,16 +210,7 @@ static const StreamId compaction_id {CompactionId};
                 read_compaction = true;
             }
             else {
-                const auto& action = key.id();
-                const auto& symbol = key.start_index();
-                if(action == StreamId{DeleteSymbol}) {
-                    ARCTICDB_DEBUG(log::version(), "Got delete action for symbol '{}'", symbol);
-                    symbols.erase(symbol);
-                }
-                else {
-                    ARCTICDB_DEBUG(log::version(), "Got insert action for symbol '{}'", symbol);
-                    symbols.insert(symbol);
-                }
+                apply_delta(key, symbols);
             }
         }
         SYMBOL_LIST_RUNTIME_LOG("Post load, got {} symbols", symbols.size());
@@ -210,8 +254,12 @@ static const StreamId compaction_id {CompactionId};
             output.push_back(to_atom(key));
         });
 
+        // Ties are broken on the whole key so that successive listings give the same order, which lets
+        // load_from_cached_compaction recognise the journal entries it has already applied
         std::sort(output.begin(), output.end(), [] (const AtomKey& left, const AtomKey& right) {
-            return left.creation_ts() < right.creation_ts();
+            if(left.creation_ts() != right.creation_ts())
+                return left.creation_ts() < right.creation_ts();
+            return left < right;
         });
         return output;
     }
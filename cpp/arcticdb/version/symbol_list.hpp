@@ -49,6 +49,18 @@ class SymbolList {
     uint64_t max_delta_ = 0;
     std::shared_ptr<VersionMap> version_map_;
 
+    // The last compacted list this client read or wrote, and the journal entries since applied on top of it, so that
+    // repeated loads only read the compacted segment when a new compaction has happened, and only replay the journal
+    // entries that are new since the previous load
+    struct CachedSymbols {
+        AtomKey compaction_key_;
+        CollectionType compacted_symbols_;
+        KeyVector applied_deltas_;
+        CollectionType symbols_;
+    };
+    std::mutex cache_mutex_;
+    std::optional<CachedSymbols> cache_;
+
   public:
     explicit SymbolList(std::shared_ptr<VersionMap> version_map, StreamId type_indicator = StringId()) :
         type_holder_(std::move(type_indicator)),
@@ -86,6 +98,8 @@ class SymbolList {
 
     void clear(const std::shared_ptr<Store>& store) {
         delete_all_keys_of_type(KeyType::SYMBOL_LIST, store, true);
+        std::lock_guard lock{cache_mutex_};
+        cache_.reset();
     }
 
     void reload(const std::shared_ptr<Store>& store) {
@@ -100,6 +114,13 @@ private:
 
     CollectionType compact(std::shared_ptr<Store> store, const std::vector<AtomKey>& symbol_keys);
 
+    CollectionType load_from_cached_compaction(const std::shared_ptr<StreamSource>& store, const KeyVector& keys,
+            KeyVector::difference_type compaction_pos);
+
+    void cache_compaction(const VariantKey& compaction_key, const CollectionType& symbols);
+
+    static void apply_delta(const AtomKey& key, CollectionType& symbols);
+
     void write_symbol(const std::shared_ptr<Store>& store, const StreamId& symbol) {
         write_journal(store, symbol, AddSymbol);
     }
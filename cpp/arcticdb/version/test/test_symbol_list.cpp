@@ -117,6 +117,31 @@ TEST(SymbolList, MultipleWrites) {
     ASSERT_THAT(symbols, UnorderedElementsAre(symbol_1, symbol_2, symbol_3));
 }
 
+TEST(SymbolList, IncrementalLoad) {
+    write_initial_compaction_key();
+
+    symbol_list.add_symbol(store, symbol_1);
+    ASSERT_THAT(symbol_list.get_symbols(store, true), UnorderedElementsAre(symbol_1));
+
+    symbol_list.add_symbol(store, symbol_2);
+    symbol_list.remove_symbol(store, symbol_1);
+    ASSERT_THAT(symbol_list.get_symbols(store, true), UnorderedElementsAre(symbol_2));
+
+    // A journal entry from a writer with a lagging clock sorts before the entries already applied
+    std::optional<timestamp> compaction_ts;
+    store->iterate_type(entity::KeyType::SYMBOL_LIST, [&compaction_ts](const auto& k) {
+        if (to_atom(k).id() == StreamId{CompactionId})
+            compaction_ts = to_atom(k).creation_ts();
+    });
+    ASSERT_TRUE(compaction_ts);
+    store->write(KeyType::SYMBOL_LIST, 0, StreamId{AddSymbol}, *compaction_ts + 1, IndexValue{symbol_3},
+                 IndexValue{symbol_3}, SegmentInMemory{}).get();
+    ASSERT_THAT(symbol_list.get_symbols(store, true), UnorderedElementsAre(symbol_2, symbol_3));
+
+    SymbolList another_instance{version_map};
+    ASSERT_THAT(another_instance.get_symbols(store, true), UnorderedElementsAre(symbol_2, symbol_3));
+}
+
 TEST(SymbolList, WriteWithCompaction) {
     write_initial_compaction_key();
 
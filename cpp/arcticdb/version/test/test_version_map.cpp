@@ -14,9 +14,13 @@
 #include <arcticdb/storage/test/in_memory_store.hpp>
 #include <arcticdb/version/version_log.hpp>
 #include <arcticdb/version/version_map_batch_methods.hpp>
+#include <arcticdb/version/version_map_compactor.hpp>
 #include <arcticdb/util/test/gtest_utils.hpp>
 #include <arcticdb/stream/test/stream_test_common.hpp>
 
+#include <atomic>
+#include <thread>
+
 namespace arcticdb {
 
 using ::testing::UnorderedElementsAre;
@@ -582,6 +586,385 @@ TEST(VersionMap, StorageLogging) {
 
 #define GTEST_COUT std::cerr << "[          ] [ INFO ]"
 
+TEST(VersionMap, VersionIndex) {
+    auto store = std::make_shared<InMemoryStore>();
+    StreamId id{"test_version_index"};
+    ScopedConfig index_interval("VersionMap.IndexInterval", 10);
+    ScopedConfig reload_interval("VersionMap.ReloadInterval", 0); // always reload
+
+    auto version_map = std::make_shared<VersionMap>();
+    version_map->set_validate(true);
+    std::vector<AtomKey> keys;
+    for (auto i = 0ULL; i < 35; ++i) {
+        keys.emplace_back(atom_key_builder().version_id(i).creation_ts(PilotedClock::nanos_since_epoch())
+            .content_hash(i).start_index(4).end_index(5).build(id, KeyType::TABLE_INDEX));
+        version_map->write_version(store, keys.back());
+        if (i == 12)
+            tombstone_version(store, version_map, id, 3);
+    }
+
+    auto version_index = read_version_index(store, id);
+    ASSERT_TRUE(version_index);
+    ASSERT_EQ(version_index->head_.version_id(), 30);
+
+    // Loading via the index gives the same entry as following every key in the chain
+    auto expected = std::make_shared<VersionMapEntry>();
+    {
+        ScopedConfig no_index("VersionMap.IndexInterval", 0);
+        auto plain_store = std::make_shared<InMemoryStore>();
+        auto plain_map = std::make_shared<VersionMap>();
+        for (const auto& key : keys) {
+            plain_map->write_version(plain_store, key);
+            if (key.version_id() == 12)
+                tombstone_version(plain_store, plain_map, id, 3);
+        }
+        ASSERT_FALSE(read_version_index(plain_store, id));
+        plain_map->load_via_ref_key(plain_store, id, LoadParameter{LoadType::LOAD_ALL}, expected);
+    }
+    auto entry = std::make_shared<VersionMapEntry>();
+    version_map->load_via_ref_key(store, id, LoadParameter{LoadType::LOAD_ALL}, entry);
+    ASSERT_EQ(entry->get_indexes(true), expected->get_indexes(true));
+    ASSERT_EQ(entry->get_indexes(false), expected->get_indexes(false));
+    ASSERT_TRUE(entry->is_tombstoned(3));
+
+    // Once the index is written, the version keys below its head are not needed to load old versions
+    std::vector<VariantKey> below_index;
+    store->iterate_type(KeyType::VERSION, [&](VariantKey&& vk) {
+        if (to_atom(vk).version_id() < version_index->head_.version_id())
+            below_index.emplace_back(std::move(vk));
+    });
+    for (const auto& key : below_index)
+        store->remove_key_sync(key, storage::RemoveOpts{});
+
+    ASSERT_EQ(get_specific_version(store, version_map, id, 1, false, false), keys[1]);
+    ASSERT_FALSE(get_specific_version(store, version_map, id, 3, false, false));
+    ASSERT_EQ(get_version_key_from_time(store, version_map, id, keys[5].creation_ts(), false, false), keys[5]);
+
+    // Later indexes are built on the previous one, so don't need the version keys below it either
+    for (auto i = 35ULL; i < 45; ++i) {
+        keys.emplace_back(atom_key_builder().version_id(i).creation_ts(PilotedClock::nanos_since_epoch())
+            .content_hash(i).start_index(4).end_index(5).build(id, KeyType::TABLE_INDEX));
+        version_map->write_version(store, keys.back());
+    }
+    ASSERT_EQ(read_version_index(store, id)->head_.version_id(), 40);
+    ASSERT_EQ(get_specific_version(store, version_map, id, 1, false, false), keys[1]);
+    ASSERT_EQ(get_specific_version(store, version_map, id, 42, false, false), keys[42]);
+}
+
+TEST(VersionMap, ConcurrentReadsAcrossSymbols) {
+    auto store = std::make_shared<InMemoryStore>();
+    ScopedConfig reload_interval("VersionMap.ReloadInterval", 0); // always reload
+
+    auto version_map = std::make_shared<VersionMap>();
+    const size_t num_symbols = 20;
+    const uint64_t num_versions = 5;
+    for (auto i = 0ULL; i < num_symbols; ++i) {
+        StreamId id{fmt::format("symbol_{}", i)};
+        for (auto v = 0ULL; v < num_versions; ++v) {
+            version_map->write_version(store, atom_key_builder().version_id(v).creation_ts(PilotedClock::nanos_since_epoch())
+                .content_hash(v).start_index(4).end_index(5).build(id, KeyType::TABLE_INDEX));
+        }
+    }
+
+    std::atomic<size_t> failures{0};
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < 8; ++t) {
+        threads.emplace_back([&, t] () {
+            for (auto i = 0ULL; i < num_symbols * 10; ++i) {
+                StreamId id{fmt::format("symbol_{}", (i + t) % num_symbols)};
+                auto entry = version_map->check_reload(store, id, LoadParameter{LoadType::LOAD_ALL}, true, false, __FUNCTION__);
+                if (entry->get_indexes(false).size() != num_versions)
+                    ++failures;
+                if (t % 2 == 0)
+                    version_map->flush();
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(failures, 0);
+}
+
+TEST(VersionMap, WritesLeaveCachedEntryUnchanged) {
+    auto store = std::make_shared<InMemoryStore>();
+    StreamId id{"test"};
+    THREE_SIMPLE_KEYS
+
+    auto version_map = std::make_shared<VersionMap>();
+    version_map->set_validate(true);
+    version_map->write_version(store, key1);
+    version_map->write_version(store, key2);
+
+    // A reader holding the cached entry doesn't see later writes, which publish a new entry
+    auto cached = version_map->check_reload(store, id, LoadParameter{LoadType::LOAD_ALL}, true, false, __FUNCTION__);
+    const auto cached_keys = cached->keys_;
+    version_map->write_version(store, key3);
+    tombstone_version(store, version_map, id, VersionId{1});
+    ASSERT_EQ(cached->keys_, cached_keys);
+    ASSERT_EQ(cached->get_indexes(false), (std::vector<AtomKey>{key2, key1}));
+
+    auto latest = version_map->check_reload(store, id, LoadParameter{LoadType::LOAD_ALL}, true, false, __FUNCTION__);
+    ASSERT_NE(latest, cached);
+    ASSERT_EQ(latest->get_indexes(false), (std::vector<AtomKey>{key3, key2}));
+}
+
+TEST(VersionMap, BatchLoadInWaves) {
+    auto store = std::make_shared<InMemoryStore>();
+    ScopedConfig index_interval("VersionMap.IndexInterval", 4);
+    ScopedConfig reload_interval("VersionMap.ReloadInterval", 0); // always reload
+
+    auto version_map = std::make_shared<VersionMap>();
+    version_map->set_validate(true);
+    std::vector<StreamId> stream_ids;
+    for (auto i = 0ULL; i < 6; ++i) {
+        StreamId id{fmt::format("symbol_{}", i)};
+        stream_ids.push_back(id);
+        // Chains of different depths, some long enough to be walked via the version index
+        for (auto v = 0ULL; v < i * 3; ++v) {
+            version_map->write_version(store, atom_key_builder().version_id(v).creation_ts(PilotedClock::nanos_since_epoch())
+                .content_hash(v).start_index(4).end_index(5).build(id, KeyType::TABLE_INDEX));
+            if (v == 5)
+                tombstone_version(store, version_map, id, 2);
+        }
+    }
+    stream_ids.emplace_back("missing");
+
+    for (auto load_type : {LoadType::LOAD_LATEST, LoadType::LOAD_LATEST_UNDELETED, LoadType::LOAD_UNDELETED, LoadType::LOAD_ALL}) {
+        std::vector<LoadParameter> load_params(stream_ids.size(), LoadParameter{load_type});
+        auto entries = batch_load_version_entries(store, version_map, stream_ids, load_params);
+        ASSERT_EQ(entries.size(), stream_ids.size());
+        for (auto i = 0ULL; i < stream_ids.size(); ++i) {
+            auto expected = std::make_shared<VersionMapEntry>();
+            version_map->load_via_ref_key(store, stream_ids[i], load_params[i], expected);
+            ASSERT_EQ(entries[i]->get_indexes(true), expected->get_indexes(true));
+            ASSERT_EQ(entries[i]->get_indexes(false), expected->get_indexes(false));
+        }
+    }
+
+    std::map<StreamId, VersionId> sym_versions{{stream_ids[3], 1}, {stream_ids[5], 12}};
+    auto specific = batch_get_specific_version(store, version_map, sym_versions);
+    ASSERT_EQ(specific->size(), 2u);
+    ASSERT_EQ(specific->at(stream_ids[3]).version_id(), 1);
+    ASSERT_EQ(specific->at(stream_ids[5]).version_id(), 12);
+}
+
+namespace {
+
+AtomKey index_key_for(const StreamId& id, VersionId version_id) {
+    return atom_key_builder().version_id(version_id).creation_ts(PilotedClock::nanos_since_epoch()).content_hash(version_id)
+        .start_index(4).end_index(5).build(id, KeyType::TABLE_INDEX);
+}
+
+// Fails every VERSION key write for one symbol once fail_version_writes is called
+class FailingVersionWriteStore : public InMemoryStore {
+public:
+    using InMemoryStore::write;
+
+    void fail_version_writes(const StreamId& stream_id) {
+        failing_id_ = stream_id;
+    }
+
+    folly::Future<VariantKey> write(PartialKey pk, SegmentInMemory &&segment) override {
+        if (pk.key_type == KeyType::VERSION && failing_id_ && pk.stream_id == *failing_id_)
+            return folly::makeFuture<VariantKey>(std::runtime_error("Simulated version write failure"));
+
+        return InMemoryStore::write(pk, std::move(segment));
+    }
+
+private:
+    std::optional<StreamId> failing_id_;
+};
+
+} // namespace
+
+TEST(VersionMap, WriteVersionsDistinctSymbols) {
+    auto store = std::make_shared<InMemoryStore>();
+    auto version_map = std::make_shared<VersionMap>();
+    version_map->set_validate(true);
+    std::vector<StreamId> stream_ids{StreamId{"existing"}, StreamId{"new"}};
+    const auto existing_key = index_key_for(stream_ids[0], 0);
+    version_map->write_version(store, existing_key);
+
+    std::vector<LoadParameter> load_params(stream_ids.size(), LoadParameter{LoadType::LOAD_LATEST});
+    auto entries = batch_load_version_entries(store, version_map, stream_ids, load_params);
+    const std::vector<AtomKey> keys{index_key_for(stream_ids[0], 1), index_key_for(stream_ids[1], 0)};
+    version_map->write_versions(store, keys, entries);
+    ASSERT_EQ(store->num_ref_keys_of_type(KeyType::VERSION_REF), 2);
+
+    auto reloaded = std::make_shared<VersionMap>();
+    ASSERT_EQ(get_all_versions(store, reloaded, stream_ids[0], true, false),
+              (std::vector<AtomKey>{keys[0], existing_key}));
+    ASSERT_EQ(get_all_versions(store, reloaded, stream_ids[1], true, false), std::vector<AtomKey>{keys[1]});
+}
+
+TEST(VersionMap, WriteVersionsRethrowsFailedWrite) {
+    StreamId failing_id{"failing"};
+    StreamId other_id{"other"};
+    auto store = std::make_shared<FailingVersionWriteStore>();
+    store->fail_version_writes(failing_id);
+    auto version_map = std::make_shared<VersionMap>();
+    std::vector<StreamId> stream_ids{failing_id, other_id};
+    std::vector<LoadParameter> load_params(stream_ids.size(), LoadParameter{LoadType::LOAD_LATEST});
+    auto entries = batch_load_version_entries(store, version_map, stream_ids, load_params);
+    const std::vector<AtomKey> keys{index_key_for(failing_id, 0), index_key_for(other_id, 0)};
+    ASSERT_THROW(version_map->write_versions(store, keys, entries), std::runtime_error);
+
+    // The symbol that could be written still is
+    auto reloaded = std::make_shared<VersionMap>();
+    ASSERT_EQ(get_all_versions(store, reloaded, other_id, true, false), std::vector<AtomKey>{keys[1]});
+    ASSERT_TRUE(get_all_versions(store, reloaded, failing_id, true, false).empty());
+}
+
+TEST(VersionMap, BatchWriteVersionDistinctSymbols) {
+    auto store = std::make_shared<InMemoryStore>();
+    auto version_map = std::make_shared<VersionMap>();
+    version_map->set_validate(true);
+    std::vector<AtomKey> keys;
+    for (auto i = 0ULL; i < 4; ++i) {
+        StreamId id{fmt::format("symbol_{}", i)};
+        version_map->write_version(store, index_key_for(id, 0));
+        keys.push_back(index_key_for(id, 1));
+    }
+    keys.push_back(index_key_for(StreamId{"new"}, 0));
+    batch_write_version(store, version_map, keys);
+
+    auto reloaded = std::make_shared<VersionMap>();
+    for (const auto& key : keys) {
+        auto versions = get_all_versions(store, reloaded, key.id(), true, false);
+        ASSERT_FALSE(versions.empty());
+        ASSERT_EQ(versions[0], key);
+        ASSERT_EQ(versions.size(), key.version_id() + 1);
+    }
+}
+
+TEST(VersionMap, BatchWriteVersionRepeatedSymbol) {
+    auto store = std::make_shared<InMemoryStore>();
+    auto version_map = std::make_shared<VersionMap>();
+    StreamId id{"repeated"};
+    StreamId other_id{"other"};
+    const std::vector<AtomKey> keys{index_key_for(id, 0), index_key_for(other_id, 0), index_key_for(id, 1)};
+    batch_write_version(store, version_map, keys);
+
+    auto reloaded = std::make_shared<VersionMap>();
+    ASSERT_THAT(get_all_versions(store, reloaded, id, true, false), UnorderedElementsAre(keys[0], keys[2]));
+    ASSERT_EQ(get_all_versions(store, reloaded, other_id, true, false), std::vector<AtomKey>{keys[1]});
+}
+
+TEST(VersionMap, BatchWriteVersionRethrowsFailedWrite) {
+    StreamId failing_id{"failing"};
+    StreamId other_id{"other"};
+    auto store = std::make_shared<FailingVersionWriteStore>();
+    auto version_map = std::make_shared<VersionMap>();
+    const auto failing_key = index_key_for(failing_id, 0);
+    const auto other_key = index_key_for(other_id, 0);
+    version_map->write_version(store, failing_key);
+    version_map->write_version(store, other_key);
+    store->fail_version_writes(failing_id);
+
+    // Both symbols have ref keys, so are written together by write_versions
+    const std::vector<AtomKey> keys{index_key_for(failing_id, 1), index_key_for(other_id, 1)};
+    ASSERT_THROW(batch_write_version(store, version_map, keys), std::runtime_error);
+
+    auto reloaded = std::make_shared<VersionMap>();
+    ASSERT_EQ(get_all_versions(store, reloaded, failing_id, true, false), std::vector<AtomKey>{failing_key});
+    ASSERT_EQ(get_all_versions(store, reloaded, other_id, true, false), (std::vector<AtomKey>{keys[1], other_key}));
+}
+
+TEST(VersionMap, BatchWriteVersionLegacyJournal) {
+    StreamId legacy_id{"legacy"};
+    StreamId other_id{"other"};
+    auto store = std::make_shared<InMemoryStore>();
+    auto version_map = std::make_shared<VersionMap>();
+    const auto other_key = index_key_for(other_id, 0);
+    version_map->write_version(store, other_key);
+
+    // A library written before ref keys existed has only journal keys for the symbol
+    const auto legacy_key1 = index_key_for(legacy_id, 1);
+    const auto legacy_key2 = index_key_for(legacy_id, 2);
+    write_old_style_journal_entry(legacy_key1, store);
+    write_old_style_journal_entry(legacy_key2, store);
+    version_map->flush();
+
+    const std::vector<AtomKey> keys{index_key_for(legacy_id, 3), index_key_for(other_id, 1)};
+    batch_write_version(store, version_map, keys);
+    ASSERT_EQ(store->num_atom_keys_of_type(KeyType::VERSION_JOURNAL), 0);
+
+    auto reloaded = std::make_shared<VersionMap>();
+    ASSERT_EQ(get_all_versions(store, reloaded, legacy_id, true, false),
+              (std::vector<AtomKey>{keys[0], legacy_key2, legacy_key1}));
+    ASSERT_EQ(get_all_versions(store, reloaded, other_id, true, false),
+              (std::vector<AtomKey>{keys[1], other_key}));
+}
+
+TEST(VersionMap, BackgroundCompactionPass) {
+    auto store = std::make_shared<InMemoryStore>();
+    ScopedConfig max_blocks("VersionMap.MaxVersionBlocks", 3);
+    ScopedConfig max_symbols("VersionMap.BackgroundCompactionMaxSymbols", 1);
+
+    auto version_map = std::make_shared<VersionMap>();
+    version_map->set_validate(true);
+    size_t num_notifications = 0;
+    version_map->set_compaction_listener([&num_notifications]() { ++num_notifications; });
+
+    StreamId short_id{"short"};
+    for (auto v = 0ULL; v < 2; ++v)
+        version_map->write_version(store, atom_key_builder().version_id(v).creation_ts(PilotedClock::nanos_since_epoch())
+            .content_hash(v).start_index(4).end_index(5).build(short_id, KeyType::TABLE_INDEX));
+    ASSERT_EQ(num_notifications, 0);
+
+    std::vector<StreamId> long_ids{StreamId{"long_1"}, StreamId{"long_2"}};
+    for (const auto& id : long_ids) {
+        for (auto v = 0ULL; v < 5; ++v)
+            version_map->write_version(store, atom_key_builder().version_id(v).creation_ts(PilotedClock::nanos_since_epoch())
+                .content_hash(v).start_index(4).end_index(5).build(id, KeyType::TABLE_INDEX));
+    }
+    // Only notified when a symbol first needs compacting
+    ASSERT_EQ(num_notifications, 2);
+    ASSERT_EQ(store->num_atom_keys_of_type(KeyType::VERSION), 12);
+
+    VersionMapCompactor compactor{store, version_map};
+    ASSERT_EQ(compactor.run_pass(), 1);
+    ASSERT_TRUE(version_map->has_compaction_candidates());
+    ASSERT_EQ(compactor.run_pass(), 1);
+    ASSERT_FALSE(version_map->has_compaction_candidates());
+    ASSERT_EQ(compactor.run_pass(), 0);
+    ASSERT_EQ(store->num_atom_keys_of_type(KeyType::VERSION), 6);
+
+    for (const auto& id : long_ids) {
+        std::vector<VersionId> versions;
+        for (const auto& key : get_all_versions(store, version_map, id, false, false))
+            versions.push_back(key.version_id());
+        ASSERT_THAT(versions, testing::ElementsAre(4, 3, 2, 1, 0));
+    }
+}
+
+TEST(VersionMap, BackgroundCompactionKeepsCandidatesWhenLocked) {
+    auto store = std::make_shared<InMemoryStore>();
+    ScopedConfig max_blocks("VersionMap.MaxVersionBlocks", 3);
+    ScopedConfig lock_wait("StorageLock.WaitMs", 1);
+
+    auto version_map = std::make_shared<VersionMap>();
+    version_map->set_compaction_listener([]() {});
+    StreamId id{"long"};
+    for (auto v = 0ULL; v < 5; ++v)
+        version_map->write_version(store, atom_key_builder().version_id(v).creation_ts(PilotedClock::nanos_since_epoch())
+            .content_hash(v).start_index(4).end_index(5).build(id, KeyType::TABLE_INDEX));
+    ASSERT_TRUE(version_map->has_compaction_candidates());
+
+    VersionMapCompactor compactor{store, version_map};
+    {
+        // Another client compacting
+        StorageLock other{"VersionMapCompactionLock"};
+        ASSERT_TRUE(other.try_lock(store));
+        ASSERT_EQ(compactor.run_pass(), 0);
+        ASSERT_TRUE(version_map->has_compaction_candidates());
+        other.unlock(store);
+    }
+    ASSERT_EQ(compactor.run_pass(), 1);
+    ASSERT_FALSE(version_map->has_compaction_candidates());
+}
+
 TEST_F(VersionMapStore, StressTestWrite) {
     using namespace arcticdb;
     std::vector<AtomKey> keys;
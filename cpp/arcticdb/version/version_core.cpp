@@ -131,9 +131,51 @@ folly::Future<AtomKey> async_append_impl(
     bool validate_index) {
 
     util::check(update_info.previous_index_key_.has_value(), "Cannot append as there is no previous index key to append to");
+    return async_append_impl(store,
+                             update_info,
+                             index::get_unresolved_index_reader(*(update_info.previous_index_key_), store),
+                             std::move(frame),
+                             options,
+                             validate_index);
+}
+
+namespace {
+/*
+ * While the previous index is chained less than VersionStore.AppendIndexChainMaxDepth deep, an append writes an index
+ * referencing it rather than copying its slices, so the cost of the append doesn't grow with the history of the symbol.
+ * Returns the previous index key to reference in that case.
+ */
+std::optional<AtomKey> append_index_chain_base(
+    const UpdateInfo& update_info,
+    const index::IndexSegmentReader& previous,
+    const InputTensorFrame& frame) {
+    const auto max_depth = ConfigsMap::instance()->get_int("VersionStore.AppendIndexChainMaxDepth", 0);
+    if (previous.index_chain_depth() >= static_cast<size_t>(max_depth))
+        return std::nullopt;
+
+    const auto& previous_key = update_info.previous_index_key_;
+    if (!previous_key || previous_key->type() != KeyType::TABLE_INDEX || previous.tsd().total_rows() == 0 ||
+        frame.num_rows == 0 || previous.bucketize_dynamic())
+        return std::nullopt;
+
+    return previous_key;
+}
+}
+
+folly::Future<AtomKey> async_append_impl(
+    const std::shared_ptr<Store>& store,
+    const UpdateInfo& update_info,
+    index::IndexSegmentReader&& unresolved_index_segment_reader,
+    InputTensorFrame&& frame,
+    const WriteOptions& options,
+    bool validate_index) {
+
     const StreamId stream_id = frame.desc.id();
     ARCTICDB_DEBUG(log::version(), "append stream_id: {} , version_id: {}", stream_id, update_info.next_version_id_);
-    auto index_segment_reader = index::get_index_reader(*(update_info.previous_index_key_), store);
+    const auto chain_base = append_index_chain_base(update_info, unresolved_index_segment_reader, frame);
+    auto index_segment_reader = chain_base ?
+        std::move(unresolved_index_segment_reader) :
+        index::resolve_index_chain(std::move(unresolved_index_segment_reader), *(update_info.previous_index_key_), store);
     bool bucketize_dynamic = index_segment_reader.bucketize_dynamic();
     auto row_offset = index_segment_reader.tsd().total_rows();
     util::check_rte(!index_segment_reader.is_pickled(), "Cannot append to pickled data");
@@ -146,7 +188,7 @@ folly::Future<AtomKey> async_append_impl(
 
     frame.set_bucketize_dynamic(bucketize_dynamic);
     auto slicing_arg = get_slicing_policy(options, frame);
-    return append_frame(IndexPartialKey{stream_id, update_info.next_version_id_}, std::move(frame), slicing_arg, index_segment_reader, store, options.dynamic_schema, options.ignore_sort_order);
+    return append_frame(IndexPartialKey{stream_id, update_info.next_version_id_}, std::move(frame), slicing_arg, index_segment_reader, store, options.dynamic_schema, options.ignore_sort_order, chain_base);
 }
 
 VersionedItem append_impl(
@@ -221,6 +263,74 @@ inline std::pair<std::vector<SliceAndKey>, std::vector<SliceAndKey>> intersectin
     return std::make_pair(std::move(intersect_before), std::move(intersect_after));
 }
 
+/*
+ * update and delete_range keep the slices before the affected range, so when the previous index is chained those are
+ * often all the slices of one of the indexes in the chain. The new index then references that index in place of its
+ * slices, as appends do, rather than listing them again. Returns the depth of the chain written, zero if no index could
+ * be shared.
+ */
+size_t share_unchanged_index(
+    std::vector<SliceAndKey>& slice_and_keys,
+    const AtomKey& previous_key,
+    bool bucketize_dynamic,
+    const std::shared_ptr<Store>& store) {
+    const auto max_depth = static_cast<size_t>(ConfigsMap::instance()->get_int("VersionStore.AppendIndexChainMaxDepth", 0));
+    if (max_depth == 0 || bucketize_dynamic || previous_key.type() != KeyType::TABLE_INDEX)
+        return 0;
+
+    // The previous index and the indexes it chains onto, newest, so covering the most rows, first
+    std::vector<std::pair<AtomKey, size_t>> candidates;
+    std::optional<AtomKey> key = previous_key;
+    while (key) {
+        auto unresolved = index::get_unresolved_index_reader(*key, store);
+        const auto depth = unresolved.index_chain_depth();
+        if (depth < max_depth)
+            candidates.emplace_back(*key, depth);
+
+        key.reset();
+        if (depth > 0) {
+            for (const auto& slice_and_key : unresolved) {
+                if (slice_and_key.key().type() == KeyType::TABLE_INDEX)
+                    key = slice_and_key.key();
+            }
+        }
+    }
+
+    std::unordered_map<AtomKey, FrameSlice> slice_by_key;
+    for (const auto& slice_and_key : slice_and_keys)
+        slice_by_key.try_emplace(slice_and_key.key(), slice_and_key.slice_);
+
+    for (const auto& [candidate, depth] : candidates) {
+        auto base = index::get_cached_index_reader(candidate, store);
+        if (base->tsd().total_rows() == 0)
+            continue;
+
+        const auto unchanged = std::all_of(base->begin(), base->end(), [&slice_by_key] (const SliceAndKey& base_slice) {
+            auto it = slice_by_key.find(base_slice.key());
+            return it != slice_by_key.end() && it->second == base_slice.slice_;
+        });
+        if (!unchanged)
+            continue;
+
+        std::unordered_set<AtomKey> shared;
+        std::transform(base->begin(), base->end(), std::inserter(shared, shared.end()), [] (const SliceAndKey& base_slice) {
+            return base_slice.key();
+        });
+        slice_and_keys.erase(std::remove_if(std::begin(slice_and_keys), std::end(slice_and_keys), [&shared] (const SliceAndKey& slice_and_key) {
+            return shared.count(slice_and_key.key()) != 0;
+        }), std::end(slice_and_keys));
+
+        const auto& tsd = base->tsd();
+        slice_and_keys.emplace_back(
+            FrameSlice{ColRange{0, static_cast<size_t>(tsd.stream_descriptor().fields_size())}, RowRange{0, tsd.total_rows()}},
+            candidate);
+        std::sort(std::begin(slice_and_keys), std::end(slice_and_keys));
+        ARCTICDB_DEBUG(log::version(), "Sharing {} unchanged slices of index {}", shared.size(), candidate);
+        return depth + 1;
+    }
+    return 0;
+}
+
 } // namespace
 
 VersionedItem delete_range_impl(
@@ -267,7 +377,9 @@ VersionedItem delete_range_impl(
 
     std::sort(std::begin(flattened_slice_and_keys), std::end(flattened_slice_and_keys));
     bool bucketize_dynamic = index_segment_reader.bucketize_dynamic();
+    const auto chain_depth = share_unchanged_index(flattened_slice_and_keys, prev, bucketize_dynamic, store);
     auto time_series = make_descriptor(row_count, std::move(index_segment_reader), std::nullopt, bucketize_dynamic);
+    time_series.set_index_chain_depth(chain_depth);
     auto version_key_fut = util::variant_match(index, [&time_series, &flattened_slice_and_keys, &stream_id, &version_id, &store] (auto idx) {
         using IndexType = decltype(idx);
         return pipelines::index::write_index<IndexType>(std::move(time_series), std::move(flattened_slice_and_keys), IndexPartialKey{stream_id, version_id}, store);
@@ -352,7 +464,9 @@ VersionedItem update_impl(
     auto desc = stream::merge_descriptors(StreamDescriptor{std::move(*index_segment_reader.mutable_tsd().mutable_stream_descriptor())}, { frame.desc.fields() }, {});
     // At this stage the updated data must be sorted
     desc.set_sorted(arcticdb::entity::SortedValue::ASCENDING);
+    const auto chain_depth = share_unchanged_index(flattened_slice_and_keys, *(update_info.previous_index_key_), bucketize_dynamic, store);
     auto time_series = make_descriptor(row_count, std::move(desc), frame.norm_meta, std::move(frame.user_meta), std::nullopt, bucketize_dynamic);
+    time_series.set_index_chain_depth(chain_depth);
     auto index = index_type_from_descriptor(time_series.stream_descriptor());
 
     auto version_key_fut = util::variant_match(index, [&time_series, &flattened_slice_and_keys, &stream_id, &update_info, &store] (auto idx) {
@@ -385,6 +499,107 @@ FrameAndDescriptor read_multi_key(
     return {res.frame_, multi_key_desc, keys, std::shared_ptr<BufferHolder>{}};
 }
 
+namespace {
+
+size_t processed_row_count(const ProcessingSegment& proc) {
+    return proc.data_.empty() ? 0u : proc.data_[0].slice_.row_range.diff();
+}
+
+/*
+ * Keeps only the first (or last) row_limit.num_rows_ rows of the processed output, which must be in index order.
+ * The row group straddling the limit is filtered down, and all row groups beyond it are dropped.
+ */
+std::vector<Composite<ProcessingSegment>> apply_row_limit(
+    std::vector<Composite<ProcessingSegment>>&& composites,
+    const RowLimit& row_limit,
+    const std::shared_ptr<Store>& store) {
+    std::vector<ProcessingSegment> procs;
+    for(auto& composite : composites) {
+        composite.broadcast([&procs] (ProcessingSegment& proc) {
+            procs.emplace_back(std::move(proc));
+        });
+    }
+
+    if(row_limit.from_end_)
+        std::reverse(std::begin(procs), std::end(procs));
+
+    std::vector<ProcessingSegment> output;
+    size_t remaining = row_limit.num_rows_;
+    for(auto& proc : procs) {
+        if(remaining == 0)
+            break;
+
+        const auto rows = processed_row_count(proc);
+        if(rows > remaining) {
+            util::BitSet bitset(static_cast<util::BitSet::size_type>(rows));
+            if(row_limit.from_end_)
+                bitset.set_range(rows - remaining, rows - 1);
+            else
+                bitset.set_range(0, remaining - 1);
+
+            proc.apply_filter(bitset, store);
+            remaining = 0;
+        } else {
+            remaining -= rows;
+        }
+        output.emplace_back(std::move(proc));
+    }
+
+    if(row_limit.from_end_)
+        std::reverse(std::begin(output), std::end(output));
+
+    std::vector<Composite<ProcessingSegment>> res;
+    if(!output.empty())
+        res.emplace_back(std::move(output));
+
+    return res;
+}
+
+/*
+ * Reads and processes row groups in waves, starting from the front for a head limit or the back for a tail limit,
+ * and stops scheduling further reads once enough rows have survived the clauses to satisfy the limit. Only valid when
+ * no clause requires repartitioning, as each row group's output is then final.
+ */
+std::vector<Composite<ProcessingSegment>> read_and_process_with_row_limit(
+    const std::shared_ptr<Store>& store,
+    std::vector<Composite<SliceAndKey>>&& rows,
+    const ReadQuery& read_query,
+    const StreamDescriptor& desc,
+    const std::shared_ptr<std::unordered_set<std::string>>& filter_columns) {
+    const auto& row_limit = *read_query.row_limit_;
+    if(row_limit.from_end_)
+        std::reverse(std::begin(rows), std::end(rows));
+
+    const auto wave_size = static_cast<size_t>(ConfigsMap::instance()->get_int("RowLimit.WaveSize", async::TaskScheduler::instance()->cpu_thread_count()));
+    util::check(wave_size > 0, "RowLimit.WaveSize must be positive");
+
+    std::vector<Composite<ProcessingSegment>> output;
+    size_t rows_found = 0;
+    auto row_it = std::begin(rows);
+    while(row_it != std::end(rows) && rows_found < row_limit.num_rows_) {
+        auto wave_end = std::next(row_it, std::min(wave_size, static_cast<size_t>(std::distance(row_it, std::end(rows)))));
+        std::vector<Composite<SliceAndKey>> wave{std::make_move_iterator(row_it), std::make_move_iterator(wave_end)};
+        row_it = wave_end;
+
+        auto wave_output = store->batch_read_uncompressed(std::move(wave), read_query.query_, desc, filter_columns, BatchReadArgs{});
+        for(auto& composite : wave_output) {
+            composite.broadcast([&rows_found] (const ProcessingSegment& proc) {
+                rows_found += processed_row_count(proc);
+            });
+            output.emplace_back(std::move(composite));
+        }
+    }
+    ARCTICDB_DEBUG(log::version(), "Row limit of {} satisfied after processing {} of {} row groups",
+                   row_limit.num_rows_, rows.size() - std::distance(row_it, std::end(rows)), rows.size());
+
+    if(row_limit.from_end_)
+        std::reverse(std::begin(output), std::end(output));
+
+    return apply_row_limit(std::move(output), row_limit, store);
+}
+
+} // namespace
+
 /*
  * Processes the slices in the given pipeline_context.
  *
@@ -394,6 +609,9 @@ FrameAndDescriptor read_multi_key(
  * The processing of a Composite<SliceAndKey> is scheduled via the Async Store. Within a single thread, the
  * segments will be retrieved from storage and decompressed before being passed to a MemSegmentProcessingTask which
  * will process all clauses up until a reducing clause.
+ *
+ * If the query has a row limit and no clause requires repartitioning, row groups are processed in waves and reading
+ * stops as soon as the limit is satisfied.
  */
 std::vector<SliceAndKey> read_and_process(
     const std::shared_ptr<Store>& store,
@@ -443,7 +661,16 @@ std::vector<SliceAndKey> read_and_process(
         }
     }
 
-    auto parallel_output = store->batch_read_uncompressed(std::move(rows), read_query.query_, pipeline_context->descriptor(), filter_columns, BatchReadArgs{});
+    const bool early_termination = read_query.row_limit_.has_value() &&
+        std::none_of(std::begin(*read_query.query_), std::end(*read_query.query_), [] (const Clause& clause) {
+            return clause.requires_repartition();
+        });
+
+    std::vector<Composite<ProcessingSegment>> parallel_output;
+    if(early_termination)
+        parallel_output = read_and_process_with_row_limit(store, std::move(rows), read_query, pipeline_context->descriptor(), filter_columns);
+    else
+        parallel_output = store->batch_read_uncompressed(std::move(rows), read_query.query_, pipeline_context->descriptor(), filter_columns, BatchReadArgs{});
 
     size_t clause_index = 0;
     for (const auto& clause : *read_query.query_) {
@@ -473,6 +700,9 @@ std::vector<SliceAndKey> read_and_process(
         clause_index++;
     }
 
+    if(read_query.row_limit_ && !early_termination)
+        parallel_output = apply_row_limit(std::move(parallel_output), *read_query.row_limit_, store);
+
     //TODO split pipeline context into load_context and output_context
         for(auto clause  = read_query.query_->rbegin(); clause != read_query.query_->rend(); ++clause ) {
         if(clause->execution_context() && clause->execution_context()->output_descriptor_)
@@ -489,7 +719,7 @@ SegmentInMemory read_direct(const std::shared_ptr<Store>& store,
                             const ReadOptions& read_options) {
     ARCTICDB_DEBUG(log::version(), "Allocating frame");
     ARCTICDB_SAMPLE_DEFAULT(ReadDirect)
-    auto frame = allocate_frame(pipeline_context);
+    auto frame = allocate_frame(pipeline_context, read_options);
     util::print_total_mem_usage(__FILE__, __LINE__, __FUNCTION__);
 
     ARCTICDB_DEBUG(log::version(), "Fetching frame data");
@@ -518,6 +748,10 @@ FrameAndDescriptor read_index_impl(
     const VersionedItem& version) {
     auto fut_index = store->read(version.key_);
     auto [index_key, index_seg] = std::move(fut_index).get();
+    if (version.key_.type() == KeyType::TABLE_INDEX) {
+        auto index_segment_reader = index::resolve_index_chain(index::IndexSegmentReader{std::move(index_seg)}, version.key_, store);
+        index_seg = index_segment_reader.seg();
+    }
     arcticdb::proto::descriptors::TimeSeriesDescriptor tsd;
     tsd.set_total_rows(index_seg.row_count());
     tsd.mutable_stream_descriptor()->CopyFrom(index_seg.descriptor().proto());
@@ -547,10 +781,19 @@ void check_column_and_date_range_filterable(const pipelines::index::IndexSegment
 }
 }
 
-std::optional<pipelines::index::IndexSegmentReader> get_index_segment_reader(
+std::shared_ptr<const pipelines::index::IndexSegmentReader> get_index_segment_reader(
     const std::shared_ptr<Store>& store,
     const std::shared_ptr<PipelineContext>& pipeline_context,
     const VersionedItem& version_info) {
+    if (version_info.key_.type() != KeyType::MULTI_KEY) {
+        try {
+            return index::get_cached_index_reader(version_info.key_, store);
+        } catch (const std::exception& ex) {
+            ARCTICDB_DEBUG(log::version(), "Key not found from versioned item {}: {}", version_info.key_, ex.what());
+            throw storage::NoDataFoundException(version_info.key_.id());
+        }
+    }
+
     std::pair<entity::VariantKey, SegmentInMemory> index_key_seg;
     try {
         index_key_seg = store->read_sync(version_info.key_);
@@ -558,12 +801,8 @@ std::optional<pipelines::index::IndexSegmentReader> get_index_segment_reader(
         ARCTICDB_DEBUG(log::version(), "Key not found from versioned item {}: {}", version_info.key_, ex.what());
         throw storage::NoDataFoundException(version_info.key_.id());
     }
-
-    if (variant_key_type(index_key_seg.first) == KeyType::MULTI_KEY) {
-        pipeline_context->multi_key_ = index_key_seg.second;
-        return std::nullopt;
-    }
-    return std::make_optional<pipelines::index::IndexSegmentReader>(std::move(index_key_seg.second));
+    pipeline_context->multi_key_ = std::move(index_key_seg.second);
+    return nullptr;
 }
 
 void read_indexed_keys_to_pipeline(
@@ -577,7 +816,8 @@ void read_indexed_keys_to_pipeline(
     if(!maybe_reader)
         return;
 
-    auto index_segment_reader = std::move(maybe_reader.value());
+    // The reader may be shared through the index cache, so the descriptors are copied out of it rather than moved
+    const auto& index_segment_reader = *maybe_reader;
     ARCTICDB_DEBUG(log::version(), "Read index segment with {} keys", index_segment_reader.size());
     check_column_and_date_range_filterable(index_segment_reader, read_query);
 
@@ -585,7 +825,7 @@ void read_indexed_keys_to_pipeline(
 
     read_query.calculate_row_filter(static_cast<int64_t>(index_segment_reader.tsd().total_rows()));
     bool bucketize_dynamic = index_segment_reader.bucketize_dynamic();
-    pipeline_context->desc_ = StreamDescriptor{std::move(*index_segment_reader.mutable_tsd().mutable_stream_descriptor())};
+    pipeline_context->desc_ = StreamDescriptor{index_segment_reader.tsd().stream_descriptor()};
 
     bool dynamic_schema = opt_false(read_options.dynamic_schema_);
     auto queries = get_column_bitset_and_query_functions<index::IndexSegmentReader>(
@@ -596,8 +836,8 @@ void read_indexed_keys_to_pipeline(
 
     pipeline_context->slice_and_keys_ = filter_index(index_segment_reader, combine_filter_functions(queries));
     pipeline_context->total_rows_ = pipeline_context->calc_rows();
-    pipeline_context->norm_meta_ = std::make_shared<arcticdb::proto::descriptors::NormalizationMetadata>(std::move(*index_segment_reader.mutable_tsd().mutable_normalization()));
-    pipeline_context->user_meta_ = std::make_unique<arcticdb::proto::descriptors::UserDefinedMetadata>(std::move(*index_segment_reader.mutable_tsd().mutable_user_meta()));
+    pipeline_context->norm_meta_ = std::make_shared<arcticdb::proto::descriptors::NormalizationMetadata>(index_segment_reader.tsd().normalization());
+    pipeline_context->user_meta_ = std::make_unique<arcticdb::proto::descriptors::UserDefinedMetadata>(index_segment_reader.tsd().user_meta());
     pipeline_context->bucketize_dynamic_ = bucketize_dynamic;
 }
 
@@ -729,7 +969,7 @@ SegmentInMemory prepare_output_frame(std::vector<SliceAndKey>&& items, const std
         row.set_string_pool(row.slice_and_key().segment(store).string_pool_ptr());
     }
 
-    auto frame = allocate_frame(pipeline_context);
+    auto frame = allocate_frame(pipeline_context, read_options);
     copy_segments_to_frame(store, pipeline_context, frame);
 
     return frame;
@@ -55,6 +55,16 @@ folly::Future<AtomKey> async_append_impl(
     const WriteOptions& options,
     bool validate_index);
 
+// As above, with the index segment of update_info.previous_index_key_ already read as stored, without resolving any
+// index chain, so that batches can read them together
+folly::Future<AtomKey> async_append_impl(
+    const std::shared_ptr<Store>& store,
+    const UpdateInfo& update_info,
+    pipelines::index::IndexSegmentReader&& index_segment_reader,
+    InputTensorFrame&& frame,
+    const WriteOptions& options,
+    bool validate_index);
+
 VersionedItem append_impl(
     const std::shared_ptr<Store>& store,
     const UpdateInfo& update_info,
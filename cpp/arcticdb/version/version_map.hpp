@@ -33,7 +33,10 @@
 
 #include <unordered_set>
 #include <map>
+#include <unordered_map>
+#include <array>
 #include <deque>
+#include <functional>
 
 namespace arcticdb {
 
@@ -91,10 +94,23 @@ class VersionMapImpl {
      * Note that VERSION_JOURNAL is a key type which is only there for backwards compatibility reasons and is never
      * used in for new libraries.
      *
+     * VERSION INDEX
+     * Every VersionMap.IndexInterval versions the whole chain is written to a VERSION_INDEX ref key (see VersionIndex),
+     * recording the version key that was the head at the time. The writer builds it from its cached entry and the
+     * previous index, so only reads the part of the chain that its entry doesn't hold and the previous index doesn't
+     * cover. Readers walking deep into the chain fetch it and, on reaching that version key, load the remainder of the
+     * chain from it in one read. Anything that rewrites or removes version keys removes the index, and an index whose
+     * head is no longer in the chain is never reached, so a stale index costs at most one wasted read.
+     *
      * CACHING in VERSION MAP
      * when someone requests the latest version, we do have a grace period of DEFAULT_RELOAD_INTERVAL where we will
      * just use the data in the in memory map if it exists rather than reading the ref key from the storage.
      *
+     * The cache is split into NUM_MAP_SHARDS shards by hash of the stream id, each behind its own mutex, so batch
+     * methods and concurrent readers working on different symbols rarely contend. A shard mutex only guards the
+     * shard's map: entries are handed out as shared_ptrs, and a reload from storage publishes a new entry rather than
+     * modifying the cached one in place, so a reader holding an entry keeps a consistent snapshot of it.
+     *
      */
 
     /**
@@ -103,17 +119,26 @@ class VersionMapImpl {
      * Methods already declared with const& were not touched during this change.
      */
     using StreamIdArg = const StreamId&;
-    using MapType =  std::map<StreamId, std::shared_ptr<VersionMapEntry>>;
+    using MapType = std::unordered_map<StreamId, std::shared_ptr<VersionMapEntry>>;
+
+    struct MapShard {
+        std::mutex mutex_;
+        MapType map_;
+    };
 
     static constexpr uint64_t DEFAULT_CLOCK_UNSYNC_TOLERANCE = ONE_SECOND * 2;
     static constexpr uint64_t DEFAULT_RELOAD_INTERVAL = ONE_SECOND * 2;
-    MapType map_;
+    static constexpr int64_t DEFAULT_VERSION_INDEX_INTERVAL = 100;
+    static constexpr size_t NUM_MAP_SHARDS = 64;
+    mutable std::array<MapShard, NUM_MAP_SHARDS> map_shards_;
     bool validate_ = false;
     bool log_changes_ = false;
     bool fast_tombstone_all_ = false;
     std::optional<timestamp> reload_interval_;
-    mutable std::mutex map_mutex_;
     std::shared_ptr<LockTable> lock_table_ = std::make_shared<LockTable>();
+    std::function<void()> compaction_listener_;
+    std::mutex compaction_mutex_;
+    std::unordered_set<StreamId> compaction_candidates_;
 
 public:
     VersionMapImpl() = default;
@@ -140,6 +165,36 @@ public:
         reload_interval_ = std::make_optional<timestamp>(interval);
     }
 
+    /*
+     * When a listener is set, symbols whose version chain needs compacting are recorded as their entries are written
+     * or reloaded, and the listener is called, so that a background compactor can find them without scanning the
+     * cache or storage. Must be set before the map is shared between threads.
+     */
+    void set_compaction_listener(std::function<void()> listener) {
+        compaction_listener_ = std::move(listener);
+    }
+
+    std::vector<StreamId> take_compaction_candidates(size_t max_symbols) {
+        std::lock_guard lock(compaction_mutex_);
+        std::vector<StreamId> output;
+        for (auto it = compaction_candidates_.begin(); it != compaction_candidates_.end() && output.size() < max_symbols;) {
+            output.emplace_back(*it);
+            it = compaction_candidates_.erase(it);
+        }
+        return output;
+    }
+
+    // Puts back candidates that were taken but not compacted, so that a later pass finds them
+    void return_compaction_candidates(const std::vector<StreamId>& stream_ids) {
+        std::lock_guard lock(compaction_mutex_);
+        compaction_candidates_.insert(std::begin(stream_ids), std::end(stream_ids));
+    }
+
+    bool has_compaction_candidates() {
+        std::lock_guard lock(compaction_mutex_);
+        return !compaction_candidates_.empty();
+    }
+
     bool validate() const {
         return validate_;
     }
@@ -149,23 +204,14 @@ public:
         const VersionMapEntry& ref_entry,
         const std::shared_ptr<VersionMapEntry>& entry,
         const LoadParameter& load_params) const {
-        auto next_key = ref_entry.head_;
-        entry->head_ = ref_entry.head_;
-        auto loaded_until = std::numeric_limits<VersionId>::max();
-
-        if ((load_params.load_type_ == LoadType::LOAD_LATEST || load_params.load_type_ == LoadType::LOAD_LATEST_UNDELETED ) && is_index_key_type(ref_entry.keys_[0].type())) {
-            entry->keys_.push_back(ref_entry.keys_[0]);
-        } else {
-            do {
-                auto [key, seg] = store->read_sync(next_key.value());
-                std::tie(next_key, loaded_until) = read_segment_with_keys(seg, entry);
-            } while (next_key
-            && need_to_load_further(load_params, loaded_until)
-            && load_latest_ongoing(load_params, entry)
-            && looking_for_undeleted(load_params, entry));
-
-            if(load_params.load_type_ == LoadType::LOAD_DOWNTO)
-                entry->loaded_until_ = loaded_until;
+        VersionChainWalk walk{ref_entry, entry, load_params};
+        while (!walk.done()) {
+            if (walk.wants_version_index()) {
+                walk.load_version_index(read_version_index(store, walk.stream_id()));
+            } else {
+                auto [key, seg] = store->read_sync(walk.next_key());
+                walk.load_segment(seg);
+            }
         }
     }
 
@@ -180,8 +226,11 @@ public:
             try {
                 VersionMapEntry ref_entry;
                 read_symbol_ref(store, stream_id, ref_entry);
-                if (ref_entry.empty())
+                if (ref_entry.empty()) {
+                    // There is no chain, so all of it is loaded
+                    entry->load_type_ = LoadType::LOAD_ALL;
                     return;
+                }
 
                 follow_version_chain(store, ref_entry, entry, load_params);
 
@@ -202,8 +251,10 @@ public:
     }
 
     void flush() {
-        std::lock_guard lock(map_mutex_);
-        map_.clear();
+        for (auto& shard : map_shards_) {
+            std::lock_guard lock(shard.mutex_);
+            shard.map_.clear();
+        }
     }
 
     void load_via_iteration(
@@ -230,14 +281,73 @@ public:
             entry->validate();
         if(log_changes_)
             log_write(store, key.id(), key.version_id());
+
+        maybe_write_version_index(store, key, *entry);
+    }
+
+    /*
+     * As write_version for each of keys, which must be for distinct symbols, given their entries as loaded by
+     * batch_load_version_entries. The VERSION keys of all the symbols are written in one wave of concurrent storage
+     * writes and then the ref keys in a second, rather than two sequential round trips per symbol. A symbol whose
+     * VERSION key can't be written is skipped, and the first failure is rethrown once the other symbols are written.
+     */
+    void write_versions(
+        const std::shared_ptr<Store>& store,
+        const std::vector<AtomKey>& keys,
+        const std::vector<std::shared_ptr<VersionMapEntry>>& entries) {
+        util::check(keys.size() == entries.size(), "Mismatched keys ({}) and entries ({}) in write_versions", keys.size(), entries.size());
+        std::vector<folly::Future<VariantKey>> journal_writes;
+        journal_writes.reserve(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (validate_)
+                entries[i]->validate();
+
+            journal_writes.emplace_back(store->write(journal_partial_key(keys[i]), journal_segment(keys[i], entries[i]->head_)));
+        }
+        auto journal_keys = folly::collectAll(journal_writes).get();
+
+        std::optional<folly::exception_wrapper> error;
+        std::vector<size_t> written;
+        std::vector<std::shared_ptr<VersionMapEntry>> updated_entries;
+        std::vector<folly::Future<VariantKey>> ref_writes;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (journal_keys[i].hasException()) {
+                log::version().warn("Failed to write version {} of {}: {}", keys[i].version_id(), keys[i].id(), journal_keys[i].exception().what());
+                if (!error)
+                    error = journal_keys[i].exception();
+                continue;
+            }
+            const auto& journal_key = to_atom(journal_keys[i].value());
+            updated_entries.emplace_back(write_to_entry(*entries[i], keys[i], journal_key));
+            ref_writes.emplace_back(store->write(KeyType::VERSION_REF, keys[i].id(), symbol_ref_segment(keys[i], journal_key)));
+            written.push_back(i);
+        }
+        auto ref_keys = folly::collectAll(ref_writes).get();
+
+        for (size_t j = 0; j < written.size(); ++j) {
+            const auto& key = keys[written[j]];
+            if (ref_keys[j].hasException()) {
+                log::version().warn("Failed to write version ref of {}: {}", key.id(), ref_keys[j].exception().what());
+                if (!error)
+                    error = ref_keys[j].exception();
+                continue;
+            }
+            publish_entry(key.id(), updated_entries[j]);
+            if (log_changes_)
+                log_write(store, key.id(), key.version_id());
+
+            maybe_write_version_index(store, key, *updated_entries[j]);
+        }
+
+        if (error)
+            error->throw_exception();
     }
 
     AtomKey write_tombstone_all_key(
             const std::shared_ptr<Store>& store,
             const AtomKey& previous_key,
-            const std::shared_ptr<VersionMapEntry>& entry) {
+            std::shared_ptr<VersionMapEntry>& entry) {
         auto tombstone_key = get_tombstone_all_key(previous_key, store->current_timestamp());
-        entry->try_set_tombstone_all(tombstone_key);
         do_write(store, tombstone_key, entry);
         return tombstone_key;
     }
@@ -255,7 +365,9 @@ public:
             const StreamId& stream_id,
             std::optional<AtomKey> first_key_to_tombstone = std::nullopt
             ) {
-        return tombstone_from_key_or_all_internal(store, stream_id, first_key_to_tombstone);
+        auto load_type = fast_tombstone_all_ ? LoadType::LOAD_UNDELETED : LoadType::LOAD_ALL;
+        auto entry = check_reload(store, stream_id, LoadParameter{load_type}, true, false, __FUNCTION__);
+        return tombstone_from_key_or_all_internal(store, stream_id, first_key_to_tombstone, entry);
     }
 
     std::string dump_entry(const std::shared_ptr<Store> store, const StreamId& stream_id) {
@@ -278,6 +390,7 @@ public:
         if (log_changes_)
             log_write(store, key.id(), key.version_id());
 
+        maybe_write_version_index(store, key, *entry);
         return result;
     }
 
@@ -345,7 +458,9 @@ public:
         if (validate_)
             new_entry->validate();
 
-        std::swap(entry, new_entry);
+        // Writes made while compacting published entries built on the old chain, so reload rather than publishing
+        // new_entry
+        invalidate_entry(stream_id);
     }
 
     AtomKey update_version_key(
@@ -391,6 +506,7 @@ public:
         std::copy_if(parent + 1, std::end(new_entry->keys_), std::back_inserter(index_keys_compacted),
                      [](const auto& k){return is_index_or_tombstone(k);});
 
+        remove_version_index(store, stream_id);
         update_version_key(store, *parent, index_keys_compacted, stream_id);
         store->remove_keys(version_keys_compacted).get();
 
@@ -427,40 +543,49 @@ public:
         log::version().info("Compacted {} out of {} total symbols", num_sym_compacted, total_symbols);
     }
 
-    void compact(std::shared_ptr<Store> store, StreamIdArg stream_id) {
+    // Returns true if the version chain was long enough to be compacted. Callers that can run alongside writers
+    // must hold the symbol's lock from get_lock_object
+    bool compact(std::shared_ptr<Store> store, StreamIdArg stream_id) {
         ARCTICDB_DEBUG(log::version(), "Version map compacting versions for stream {}", stream_id);
-        auto entry = check_reload(store, stream_id, LoadParameter{LoadType::LOAD_ALL}, true, false, __FUNCTION__);
+        // Compacts a private copy, as the cached entry is shared with readers
+        auto entry = std::make_shared<VersionMapEntry>(
+            *check_reload(store, stream_id, LoadParameter{LoadType::LOAD_ALL}, true, false, __FUNCTION__));
         if (entry->empty()) {
             log::version().warn("Entry is empty in compact");
-            return;
+            return false;
         }
 
         if (entry->keys_.size() < 3)
-            return;
+            return false;
 
         if (!requires_compaction(entry))
-            return;
+            return false;
 
         auto new_entry = compact_entry(store, stream_id, entry);
 
         if (validate_)
             new_entry->validate();
 
-        std::swap(entry, new_entry);
+        // Writes made while compacting published entries built on the old chain, so reload rather than publishing
+        // new_entry
+        invalidate_entry(stream_id);
+        return true;
     }
 
     void overwrite_symbol_tree(
             std::shared_ptr<Store> store, StreamIdArg stream_id, const std::vector<AtomKey>& index_keys) {
-        auto entry = check_reload(store, stream_id, LoadParameter{LoadType::LOAD_ALL}, true, false, __FUNCTION__);
-        auto old_entry = *entry;
+        auto old_entry = check_reload(store, stream_id, LoadParameter{LoadType::LOAD_ALL}, true, false, __FUNCTION__);
         if (!index_keys.empty()) {
+            auto entry = std::make_shared<VersionMapEntry>(*old_entry);
             entry->keys_.assign(std::begin(index_keys), std::end(index_keys));
             auto new_version_id = index_keys[0].version_id();
             entry->head_ = write_entry_to_storage(store, stream_id, new_version_id, entry);
             if (validate_)
                 entry->validate();
+
+            publish_entry(stream_id, entry);
         }
-        remove_entry_version_keys(store, old_entry, stream_id);
+        remove_entry_version_keys(store, *old_entry, stream_id);
     }
 
 
@@ -473,8 +598,8 @@ public:
         const char* function ARCTICDB_UNUSED) {
         ARCTICDB_DEBUG(log::version(), "Check reload in function {}", function);
 
-        if (has_cached_entry(stream_id, load_param))
-            return get_entry(stream_id);
+        if (auto cached = get_cached_entry(stream_id, load_param))
+            return cached;
 
         if (!skip_compat && !has_stored_entry(store, stream_id))
             do_backwards_compat_check(store, stream_id);
@@ -482,24 +607,57 @@ public:
         return storage_reload(store, stream_id, load_param, iterate_on_failure);
     }
 
+    /*
+     * The following three are for callers that load entries from storage themselves, such as the batch methods, which
+     * read the chains of many symbols together rather than calling check_reload for each
+     */
+    std::shared_ptr<VersionMapEntry> find_cached_entry(StreamIdArg stream_id, const LoadParameter load_param) const {
+        return get_cached_entry(stream_id, load_param);
+    }
+
+    // An empty entry stamped as reloaded now, to be filled from storage
+    std::shared_ptr<VersionMapEntry> make_reload_entry(const LoadParameter load_param) const {
+        auto entry = std::make_shared<VersionMapEntry>();
+        const auto clock_unsync_tolerance = ConfigsMap::instance()->get_int("VersionMap.UnsyncTolerance",
+                                                                            DEFAULT_CLOCK_UNSYNC_TOLERANCE);
+        entry->last_reload_time_ = Clock::nanos_since_epoch() - clock_unsync_tolerance;
+        entry->load_type_ = load_param.load_type_;
+        return entry;
+    }
+
+    void publish_reloaded_entry(StreamIdArg stream_id, const std::shared_ptr<VersionMapEntry>& entry) {
+        util::check(entry->keys_.empty() || entry->head_, "Non-empty VersionMapEntry should set head");
+        if (validate_)
+            entry->validate();
+
+        publish_entry(stream_id, entry);
+    }
+
+    /*
+     * Writes key to the head of the symbol's version chain. The entry may be the cached one that readers are using, so
+     * it is left as it is, and a copy with the key added is published in its place once the ref key is written. entry
+     * is then pointed at the copy.
+     */
     void do_write(
         std::shared_ptr<Store> store,
         const AtomKey &key,
-        const std::shared_ptr<VersionMapEntry> &entry) {
+        std::shared_ptr<VersionMapEntry> &entry) {
         if (validate_)
             entry->validate();
 
         auto fut_journal_key = journal_single_key(store, key, entry->head_);
         auto journal_key = to_atom(std::move(fut_journal_key).get());
-        write_to_entry(entry, key, journal_key);
+        auto updated = write_to_entry(*entry, key, journal_key);
         write_symbol_ref(store, key, journal_key);
+        publish_entry(key.id(), updated);
+        entry = std::move(updated);
     }
 
     AtomKey write_tombstone(
         std::shared_ptr<Store> store,
         const std::variant<AtomKey, VersionId>& key,
         StreamIdArg stream_id,
-        const std::shared_ptr<VersionMapEntry>& entry,
+        std::shared_ptr<VersionMapEntry>& entry,
         const std::optional<timestamp>& creation_ts=std::nullopt) {
         if (validate_)
             entry->validate();
@@ -525,6 +683,7 @@ public:
         const std::shared_ptr<Store>& store,
         const VersionMapEntry& entry,
         const StreamId &stream_id) const {
+        remove_version_index(store, stream_id);
         if (entry.head_) {
             util::check(entry.head_.value().id() == stream_id, "Id mismatch for entry {} vs stream id {}",
                         entry.head_.value().id(), stream_id);
@@ -540,68 +699,146 @@ public:
     }
 
 private:
-    void write_to_entry(
-        const std::shared_ptr<VersionMapEntry>& entry,
+    // entry is the entry that key was just written to
+    void maybe_write_version_index(const std::shared_ptr<Store>& store, const AtomKey& key, const VersionMapEntry& entry) {
+        const auto interval = ConfigsMap::instance()->get_int("VersionMap.IndexInterval", DEFAULT_VERSION_INDEX_INTERVAL);
+        if (interval <= 0 || !is_index_key_type(key.type()) || key.version_id() == 0 || key.version_id() % interval != 0)
+            return;
+
+        // The index is only an optimisation for readers, so failing to write it must not fail the write
+        try {
+            write_version_index(store, build_version_index(store, entry));
+        } catch (const std::exception& err) {
+            log::version().warn("Failed to write version index for {}: {}", key.id(), err.what());
+        }
+    }
+
+    /*
+     * Builds the checkpoint of the chain headed by entry from the keys the entry holds and the previous checkpoint. The
+     * part of the chain between the oldest version key in the entry and the head of the previous checkpoint is read,
+     * which is none of it when the writer's cached entry has reached back that far.
+     */
+    VersionIndex build_version_index(const std::shared_ptr<Store>& store, const VersionMapEntry& entry) const {
+        util::check(static_cast<bool>(entry.head_), "Cannot build version index for entry without head");
+        auto previous = read_version_index(store, entry.head_->id());
+        if (auto version_index = extend_version_index(entry, previous))
+            return *version_index;
+
+        // The keys after the oldest version key in the entry may be only some of those in it, so it is read again
+        auto tail = std::find_if(entry.keys_.rbegin(), entry.keys_.rend(), [] (const AtomKey& key) {
+            return key.type() == KeyType::VERSION;
+        });
+        VersionMapEntry ref_entry;
+        ref_entry.head_ = tail == entry.keys_.rend() ? entry.head_ : std::make_optional(*tail);
+        auto remainder = std::make_shared<VersionMapEntry>();
+        VersionChainWalk walk{ref_entry, remainder, LoadParameter{LoadType::LOAD_ALL}};
+        walk.load_version_index(std::move(previous));
+        while (!walk.done()) {
+            auto [key, seg] = store->read_sync(walk.next_key());
+            walk.load_segment(seg);
+        }
+
+        VersionIndex output{entry.head_.value(), std::vector<AtomKey>(std::begin(entry.keys_), tail.base())};
+        output.keys_.insert(std::end(output.keys_), std::begin(remainder->keys_), std::end(remainder->keys_));
+        return output;
+    }
+
+    // Returns a copy of entry with key written to the head of the chain in journal_key
+    std::shared_ptr<VersionMapEntry> write_to_entry(
+        const VersionMapEntry& entry,
         const AtomKey& key,
         const AtomKey& journal_key) const {
-        if (entry->head_)
-            entry->unshift_key(entry->head_.value());
+        auto updated = std::make_shared<VersionMapEntry>(entry);
+        if (updated->head_)
+            updated->unshift_key(updated->head_.value());
 
-        entry->unshift_key(key);
-        entry->head_ = journal_key;
+        updated->unshift_key(key);
+        updated->head_ = journal_key;
+        if (key.type() == KeyType::TOMBSTONE)
+            updated->tombstones_.try_emplace(key.version_id(), key);
+        else if (key.type() == KeyType::TOMBSTONE_ALL)
+            updated->try_set_tombstone_all(key);
 
         if (validate_)
-            entry->validate();
+            updated->validate();
+
+        return updated;
+    }
+
+    MapShard& shard_for(const StreamId& stream_id) const {
+        return map_shards_[std::hash<StreamId>{}(stream_id) % NUM_MAP_SHARDS];
     }
 
-    bool has_cached_entry(const StreamId &stream_id, const LoadParameter load_param) const {
+    // Returns the cached entry if it is recent enough and loaded far enough for load_param, otherwise nullptr
+    std::shared_ptr<VersionMapEntry> get_cached_entry(const StreamId &stream_id, const LoadParameter load_param) const {
         load_param.validate();
-        MapType::const_iterator entry;
-        std::optional<VersionMapEntry> output;
+        std::shared_ptr<VersionMapEntry> entry;
         {
-            std::lock_guard lock(map_mutex_);
-            entry = map_.find(stream_id);
-            if (entry == map_.cend()) {
+            auto& shard = shard_for(stream_id);
+            std::lock_guard lock(shard.mutex_);
+            auto it = shard.map_.find(stream_id);
+            if (it == shard.map_.cend()) {
                 ARCTICDB_DEBUG(log::version(), "Did not find cached entry for stream id {}", stream_id);
-                return false;
+                return nullptr;
             }
+            entry = it->second;
         }
         const timestamp reload_interval = reload_interval_.value_or(ConfigsMap::instance()->get_int("VersionMap.ReloadInterval", DEFAULT_RELOAD_INTERVAL));
 
-        if (const timestamp cache_timing = now() - entry->second->last_reload_time_; cache_timing > reload_interval) {
+        if (const timestamp cache_timing = now() - entry->last_reload_time_; cache_timing > reload_interval) {
             ARCTICDB_DEBUG(log::version(),
                     "Latest read time {} too long ago for last acceptable cached timing {} (cache period {})",
-                    entry->second->last_reload_time_, cache_timing, reload_interval);
+                    entry->last_reload_time_, cache_timing, reload_interval);
 
-            return false;
+            return nullptr;
         }
 
-        if (entry->second->load_type_ < load_param.load_type_) {
-            ARCTICDB_DEBUG(log::version(), "Required load type {} exceeds existing load type {}, will reload", load_param.load_type_, entry->second->load_type_);
-            return false;
+        if (entry->load_type_ < load_param.load_type_) {
+            ARCTICDB_DEBUG(log::version(), "Required load type {} exceeds existing load type {}, will reload", load_param.load_type_, entry->load_type_);
+            return nullptr;
         }
 
-        if(entry->second->load_type_ == LoadType::LOAD_DOWNTO && ((
-            load_param.load_type_ == LoadType::LOAD_DOWNTO && entry->second->loaded_until_ > load_param.load_until_.value())
+        if(entry->load_type_ == LoadType::LOAD_DOWNTO && ((
+            load_param.load_type_ == LoadType::LOAD_DOWNTO && entry->loaded_until_ > load_param.load_until_.value())
             || load_param.load_type_ == LoadType::LOAD_UNDELETED)) {
-            ARCTICDB_DEBUG(log::version(), "Not loaded as far as required value {}, only have {}", load_param.load_until_.value(), entry->second->loaded_until_);
-            return false;
+            ARCTICDB_DEBUG(log::version(), "Not loaded as far as required value {}, only have {}", load_param.load_until_.value(), entry->loaded_until_);
+            return nullptr;
         }
 
-        if(load_param.load_type_ == LoadType::LOAD_UNDELETED && !entry->second->tombstone_all_ &&
-           entry->second->load_type_ != LoadType::LOAD_UNDELETED)
-            return false;
+        if(load_param.load_type_ == LoadType::LOAD_UNDELETED && !entry->tombstone_all_ &&
+           entry->load_type_ != LoadType::LOAD_UNDELETED)
+            return nullptr;
 
         ARCTICDB_DEBUG(log::version(), "{} Using cached entry for symbol {}", uintptr_t(this), stream_id);
-        return true;
+        return entry;
+    }
+
+    void publish_entry(const StreamId& stream_id, std::shared_ptr<VersionMapEntry> entry) {
+        note_compaction_candidate(stream_id, entry);
+        auto& shard = shard_for(stream_id);
+        std::lock_guard lock(shard.mutex_);
+        shard.map_.insert_or_assign(stream_id, std::move(entry));
     }
 
-    std::shared_ptr<VersionMapEntry>& get_entry(const StreamId& stream_id) {
-        std::lock_guard lock(map_mutex_);
-        if(auto result = map_.find(stream_id); result != std::end(map_))
-            return result->second;
+    void note_compaction_candidate(const StreamId& stream_id, const std::shared_ptr<VersionMapEntry>& entry) {
+        if (!compaction_listener_ || entry->keys_.empty() || !requires_compaction(entry))
+            return;
+
+        {
+            std::lock_guard lock(compaction_mutex_);
+            if (!compaction_candidates_.insert(stream_id).second)
+                return;
+        }
+        compaction_listener_();
+    }
 
-        return map_.try_emplace(stream_id, std::make_shared<VersionMapEntry>()).first->second;
+    // Replaces the cached entry with an empty one, so that the next lookup reloads from storage
+    void invalidate_entry(const StreamId& stream_id) {
+        publish_entry(stream_id, std::make_shared<VersionMapEntry>());
+        if (compaction_listener_) {
+            std::lock_guard lock(compaction_mutex_);
+            compaction_candidates_.erase(stream_id);
+        }
     }
 
     AtomKey write_entry_to_storage(std::shared_ptr<Store> store, const StreamId &stream_id, VersionId version_id,
@@ -645,17 +882,11 @@ private:
          * be much slower, though always consistent.
          */
 
-        auto entry = get_entry(stream_id);
-        entry->clear();
-        const auto clock_unsync_tolerance = ConfigsMap::instance()->get_int("VersionMap.UnsyncTolerance",
-                                                                            DEFAULT_CLOCK_UNSYNC_TOLERANCE);
-        entry->last_reload_time_ = Clock::nanos_since_epoch() - clock_unsync_tolerance;
-        entry->load_type_ = load_param.load_type_;
-
+        auto entry = make_reload_entry(load_param);
         try {
             auto temp = std::make_shared<VersionMapEntry>(*entry);
             load_via_ref_key(store, stream_id, load_param, temp);
-            std::swap(*entry, *temp);
+            entry = std::move(temp);
         }
         catch (const std::runtime_error &err) {
             ARCTICDB_DEBUG(log::version(),
@@ -669,10 +900,7 @@ private:
             entry->load_type_ = LoadType::LOAD_ALL;
         }
 
-        util::check(entry->keys_.empty() || entry->head_, "Non-empty VersionMapEntry should set head");
-        if (validate_)
-            entry->validate();
-
+        publish_reloaded_entry(stream_id, entry);
         return entry;
     }
 
@@ -682,25 +910,30 @@ private:
         std::optional<AtomKey> prev_journal_key) {
         ARCTICDB_SAMPLE(WriteJournalEntry, 0)
         ARCTICDB_DEBUG(log::version(), "Version map writing version for key {}", key);
+        return store->write_sync(journal_partial_key(key), journal_segment(key, prev_journal_key));
+    }
 
-        folly::Future<VariantKey> journal_key = folly::Future<VariantKey>::makeEmpty();
-        IndexAggregator<RowCountIndex> journal_agg(key.id(), [&store, &journal_key, &key](auto &&segment) {
-            stream::StreamSink::PartialKey pk{
-                KeyType::VERSION,
-                key.version_id(),
-                key.id(),
-                IndexValue(0),
-                IndexValue(0)
-            };
-
-            journal_key = store->write_sync(pk, std::forward<SegmentInMemory>(segment));
+    static stream::StreamSink::PartialKey journal_partial_key(const AtomKey& key) {
+        return stream::StreamSink::PartialKey{
+            KeyType::VERSION,
+            key.version_id(),
+            key.id(),
+            IndexValue(0),
+            IndexValue(0)
+        };
+    }
+
+    static SegmentInMemory journal_segment(const AtomKey& key, const std::optional<AtomKey>& prev_journal_key) {
+        SegmentInMemory output;
+        IndexAggregator<RowCountIndex> journal_agg(key.id(), [&output](auto &&segment) {
+            output = std::forward<SegmentInMemory>(segment);
         });
         journal_agg.add_key(key);
         if (prev_journal_key)
             journal_agg.add_key(prev_journal_key.value());
 
         journal_agg.commit();
-        return journal_key;
+        return output;
     }
 
     timestamp now() const {
@@ -770,8 +1003,8 @@ public:
 
     void scan_and_rewrite(std::shared_ptr<Store> store, StreamIdArg stream_id) {
         log::version().warn("Version map scanning and rewriting  versions for stream {}", stream_id);
-        auto entry = get_entry(stream_id);
-        entry->clear();
+        invalidate_entry(stream_id);
+        auto entry = std::make_shared<VersionMapEntry>();
         load_via_iteration(store, stream_id, entry, false);
         fix_stream_ids_of_index_keys(store, stream_id, entry);
         remove_duplicate_index_keys(entry);
@@ -780,9 +1013,9 @@ public:
 
     void remove_and_rewrite_version_keys(std::shared_ptr<Store> store, StreamIdArg stream_id) {
         log::version().warn("Rewriting all index keys for {}", stream_id);
-        auto entry = get_entry(stream_id);
+        invalidate_entry(stream_id);
+        auto entry = std::make_shared<VersionMapEntry>();
         auto old_entry = entry;
-        entry->clear();
         load_via_iteration(store, stream_id, entry, true);
         fix_stream_ids_of_index_keys(store, stream_id, entry);
         remove_duplicate_index_keys(entry);
@@ -828,9 +1061,9 @@ public:
     }
 
     void recover_deleted(std::shared_ptr<Store> store, StreamIdArg stream_id) {
-        auto &entry = get_entry(stream_id);
-        entry->clear();
+        auto entry = std::make_shared<VersionMapEntry>();
         load_via_iteration(store, stream_id, entry);
+        publish_entry(stream_id, entry);
 
         auto missing_versions = find_deleted_version_keys_for_entry(store, stream_id, entry);
 
@@ -866,7 +1099,7 @@ private:
 
     std::shared_ptr<VersionMapEntry> do_backwards_compat_check(std::shared_ptr<Store> store, StreamIdArg stream_id) {
         ARCTICDB_TRACE(log::version(), "Didn't find a ref entry, scanning for old-style journal keys");
-        auto entry = get_entry(stream_id);
+        auto entry = std::make_shared<VersionMapEntry>();
         if (auto old_entry = load_from_old_journal_keys(store, stream_id); !old_entry->keys_.empty()) {
             entry->keys_ = std::move(old_entry->keys_);
             entry->head_ = rewrite_old_journal_keys(store, stream_id, entry);
@@ -875,14 +1108,10 @@ private:
         return entry;
     }
 
+    // Points entry at the published entry that the tombstones were written to
     std::vector<AtomKey> tombstone_from_key_or_all_internal(std::shared_ptr<Store> store, const StreamId& stream_id,
-                                                            std::optional<AtomKey> first_key_to_tombstone = std::nullopt,
-                                                            std::shared_ptr<VersionMapEntry> entry = nullptr) {
-        if (!entry) {
-            auto load_type = fast_tombstone_all_ ? LoadType::LOAD_UNDELETED : LoadType::LOAD_ALL;
-            entry = check_reload(store, stream_id, LoadParameter{load_type}, true, false,
-                                 __FUNCTION__);
-        }
+                                                            std::optional<AtomKey> first_key_to_tombstone,
+                                                            std::shared_ptr<VersionMapEntry>& entry) {
         if (!first_key_to_tombstone)
             first_key_to_tombstone = entry->get_first_index(false);
 
@@ -902,15 +1131,14 @@ private:
                     log_tombstone_all(store, stream_id, tombstone_key.version_id());
 
             } else {
-                for (const auto &index : output) {
-                    auto tombstone = write_tombstone(store, index, index.id(), entry);
-                    entry->tombstones_.insert(std::make_pair(index.version_id(), std::move(tombstone)));
-                }
+                for (const auto &index : output)
+                    write_tombstone(store, index, index.id(), entry);
             }
         }
 
         // Get rid of tombstone_all key if not set on this library
         if(!fast_tombstone_all_ && entry->tombstone_all_) {
+            entry = std::make_shared<VersionMapEntry>(*entry);
             auto all_indexes = entry->get_indexes(true);
             for(const auto& index_key : all_indexes) {
                 if(entry->is_tombstoned_via_tombstone_all(index_key.version_id()) &&
@@ -931,6 +1159,7 @@ private:
 
             auto version_id = all_indexes.begin()->version_id();
             entry->head_ = write_entry_to_storage(store, stream_id, version_id, entry);
+            publish_entry(stream_id, entry);
         }
 
         return output;
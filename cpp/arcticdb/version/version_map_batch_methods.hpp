@@ -14,6 +14,121 @@
 
 namespace arcticdb {
 
+/*
+ * Loads the version map entries of many symbols, equivalent to calling check_reload for each of them, but with the
+ * reads from storage done in waves: one wave reading the ref keys of all the symbols that are not usably cached, then
+ * one wave reading the next version key (or version index) of every chain that still needs to go further, and so on.
+ * The number of round trips to storage is therefore bounded by the depth of the deepest chain rather than growing with
+ * the number of symbols. Symbols whose ref key is missing or malformed, or whose chain changes underneath the walk
+ * (e.g. due to a concurrent compaction), are loaded individually with check_reload, which retries and handles
+ * old-style ref keys.
+ */
+inline std::vector<std::shared_ptr<VersionMapEntry>> batch_load_version_entries(
+    const std::shared_ptr<Store>& store,
+    const std::shared_ptr<VersionMap>& version_map,
+    const std::vector<StreamId>& stream_ids,
+    const std::vector<LoadParameter>& load_params) {
+    ARCTICDB_SAMPLE(BatchLoadVersionEntries, 0)
+    util::check(stream_ids.size() == load_params.size(), "Mismatched stream ids ({}) and load parameters ({})",
+                stream_ids.size(), load_params.size());
+    std::vector<std::shared_ptr<VersionMapEntry>> output(stream_ids.size());
+    std::vector<size_t> to_load;
+    for (size_t i = 0; i < stream_ids.size(); ++i) {
+        load_params[i].validate();
+        if (auto cached = version_map->find_cached_entry(stream_ids[i], load_params[i]))
+            output[i] = std::move(cached);
+        else
+            to_load.push_back(i);
+    }
+
+    std::vector<size_t> fallback;
+    std::vector<std::pair<size_t, VersionChainWalk>> walks;
+    auto publish = [&stream_ids, &version_map, &output](size_t i, const std::shared_ptr<VersionMapEntry>& entry) {
+        version_map->publish_reloaded_entry(stream_ids[i], entry);
+        output[i] = entry;
+    };
+
+    // The entries are stamped before the ref keys are read, as in check_reload
+    std::vector<std::shared_ptr<VersionMapEntry>> entries;
+    std::vector<folly::Future<stream::ReadKeyOutput>> ref_reads;
+    entries.reserve(to_load.size());
+    ref_reads.reserve(to_load.size());
+    for (auto i : to_load) {
+        entries.emplace_back(version_map->make_reload_entry(load_params[i]));
+        ref_reads.emplace_back(store->read(RefKey{stream_ids[i], KeyType::VERSION_REF}));
+    }
+    auto ref_results = folly::collectAll(ref_reads).get();
+    for (size_t j = 0; j < to_load.size(); ++j) {
+        const auto i = to_load[j];
+        try {
+            VersionMapEntry ref_entry;
+            read_segment_with_keys(ref_results[j].value().second, ref_entry);
+            if (ref_entry.empty()) {
+                fallback.push_back(i);
+                continue;
+            }
+            VersionChainWalk walk{ref_entry, std::move(entries[j]), load_params[i]};
+            if (walk.done())
+                publish(i, walk.entry());
+            else
+                walks.emplace_back(i, std::move(walk));
+        } catch (const std::exception& err) {
+            ARCTICDB_DEBUG(log::version(), "Batch read of ref key for {} failed with {}, loading individually",
+                           stream_ids[i], err.what());
+            fallback.push_back(i);
+        }
+    }
+
+    size_t num_waves = 1;
+    while (!walks.empty()) {
+        std::vector<folly::Future<stream::ReadKeyOutput>> reads;
+        reads.reserve(walks.size());
+        for (const auto& [i, walk] : walks) {
+            if (walk.wants_version_index())
+                reads.emplace_back(store->read(RefKey{walk.stream_id(), KeyType::VERSION_INDEX}));
+            else
+                reads.emplace_back(store->read(walk.next_key()));
+        }
+        auto results = folly::collectAll(reads).get();
+        ++num_waves;
+
+        std::vector<std::pair<size_t, VersionChainWalk>> next_wave;
+        for (size_t j = 0; j < walks.size(); ++j) {
+            auto& [i, walk] = walks[j];
+            try {
+                if (!walk.wants_version_index())
+                    walk.load_segment(results[j].value().second);
+                else if (results[j].hasException<storage::KeyNotFoundException>())
+                    walk.load_version_index(std::nullopt);
+                else
+                    walk.load_version_index(version_index_from_segment(results[j].value().second));
+            } catch (const std::exception& err) {
+                log::version().warn("Batch load of version chain for {} failed with error: {}, loading individually",
+                                    stream_ids[i], err.what());
+                fallback.push_back(i);
+                continue;
+            }
+            if (walk.done())
+                publish(i, walk.entry());
+            else
+                next_wave.emplace_back(std::move(walks[j]));
+        }
+        walks = std::move(next_wave);
+    }
+    ARCTICDB_DEBUG(log::version(), "Loaded {} version map entries in {} waves, {} loaded individually",
+                   to_load.size() - fallback.size(), num_waves, fallback.size());
+
+    async::submit_tasks_for_range(fallback,
+            [&store, &version_map, &stream_ids, &load_params](size_t i) {
+                return async::submit_io_task(CheckReloadTask{store, version_map, stream_ids[i], load_params[i]});
+            },
+            [&output](size_t i, auto&& entry) {
+                output[i] = std::move(entry);
+            });
+
+    return output;
+}
+
 inline std::shared_ptr<std::unordered_map<StreamId, AtomKey>> batch_get_latest_version(
     const std::shared_ptr<Store> &store,
     const std::shared_ptr<VersionMap> &version_map,
@@ -23,15 +138,13 @@ inline std::shared_ptr<std::unordered_map<StreamId, AtomKey>> batch_get_latest_v
     const LoadParameter load_param{include_deleted ? LoadType::LOAD_LATEST : LoadType::LOAD_LATEST_UNDELETED};
     auto output = std::make_shared<std::unordered_map<StreamId, AtomKey>>();
 
-    async::submit_tasks_for_range(stream_ids,
-            [store, version_map, &load_param](auto& stream_id) {
-                return async::submit_io_task(CheckReloadTask{store, version_map, stream_id, load_param});
-            },
-            [output, include_deleted](auto& id, auto&& entry) {
-                auto index_key = entry->get_first_index(include_deleted);
-                if (index_key)
-                    (*output)[id] = *index_key;
-            });
+    auto entries = batch_load_version_entries(store, version_map, stream_ids,
+                                              std::vector<LoadParameter>(stream_ids.size(), load_param));
+    for (size_t i = 0; i < stream_ids.size(); ++i) {
+        auto index_key = entries[i]->get_first_index(include_deleted);
+        if (index_key)
+            (*output)[stream_ids[i]] = *index_key;
+    }
 
     return output;
 }
@@ -44,19 +157,14 @@ inline std::unordered_map<StreamId, version_store::UpdateInfo> batch_get_latest_
     ARCTICDB_SAMPLE(BatchGetLatestUndeletedVersionAndNextVersionId, 0)
     std::unordered_map<StreamId, version_store::UpdateInfo> output;
 
-    async::submit_tasks_for_range(stream_ids,
-                                  [store, version_map](auto& stream_id) {
-        return async::submit_io_task(CheckReloadTask{store,
-                                                     version_map,
-                                                     stream_id,
-                                                     LoadParameter{LoadType::LOAD_LATEST_UNDELETED}});
-        },
-        [&output](auto& id, auto&& entry) {
-        auto latest_version = entry->get_first_index(true);
-        auto latest_undeleted_version = entry->get_first_index(false);
+    auto entries = batch_load_version_entries(store, version_map, stream_ids,
+        std::vector<LoadParameter>(stream_ids.size(), LoadParameter{LoadType::LOAD_LATEST_UNDELETED}));
+    for (size_t i = 0; i < stream_ids.size(); ++i) {
+        auto latest_version = entries[i]->get_first_index(true);
+        auto latest_undeleted_version = entries[i]->get_first_index(false);
         VersionId next_version_id = latest_version.has_value() ? latest_version->version_id() + 1 : 0;
-        output[id] =  {latest_undeleted_version, next_version_id};
-    });
+        output[stream_ids[i]] =  {latest_undeleted_version, next_version_id};
+    }
 
     return output;
 }
@@ -68,17 +176,20 @@ inline std::shared_ptr<std::unordered_map<StreamId, AtomKey>> batch_get_specific
     ARCTICDB_SAMPLE(BatchGetLatestVersion, 0)
     auto output = std::make_shared<std::unordered_map<StreamId, AtomKey>>();
 
-    async::submit_tasks_for_range(sym_versions,
-                                  [store, version_map](auto& sym_version) {
-        LoadParameter load_param{LoadType::LOAD_DOWNTO, sym_version.second};
-        return async::submit_io_task(CheckReloadTask{store, version_map, sym_version.first, load_param});
-        },
-        [output](auto& sym_version, auto&& entry) {
-        auto index_key = find_index_key_for_version_id(sym_version.second, entry);
+    std::vector<StreamId> stream_ids;
+    std::vector<LoadParameter> load_params;
+    for (const auto& [stream_id, version_id] : sym_versions) {
+        stream_ids.emplace_back(stream_id);
+        load_params.emplace_back(LoadParameter{LoadType::LOAD_DOWNTO, version_id});
+    }
+    auto entries = batch_load_version_entries(store, version_map, stream_ids, load_params);
+    size_t i = 0;
+    for (const auto& [stream_id, version_id] : sym_versions) {
+        auto index_key = find_index_key_for_version_id(version_id, entries[i++]);
         if (index_key) {
-            (*output)[sym_version.first] = *index_key;
+            (*output)[stream_id] = *index_key;
         }
-    });
+    }
 
     return output;
 }
@@ -96,38 +207,110 @@ inline std::shared_ptr<std::unordered_map<std::pair<StreamId, VersionId>, AtomKe
     ARCTICDB_SAMPLE(BatchGetLatestVersion, 0)
     auto output = std::make_shared<std::unordered_map<std::pair<StreamId, VersionId>, AtomKey>>();
 
-    async::submit_tasks_for_range(sym_versions,
-            [store, version_map](auto& sym_version) {
-                auto first_version = *std::min_element(std::begin(sym_version.second), std::end(sym_version.second));
-                LoadParameter load_param{LoadType::LOAD_DOWNTO, first_version};
-                return async::submit_io_task(CheckReloadTask{store, version_map, sym_version.first, load_param});
-            },
-            [output, &sym_versions](auto& sym_version, auto&& entry) {
-                auto sym_it = sym_versions.find(sym_version.first);
-                util::check(sym_it != sym_versions.end(), "Failed to find versions for symbol {}", sym_version.first);
-                const auto& versions = sym_it->second;
-                for(auto version : versions) {
-                    auto index_key = find_index_key_for_version_id(version, entry);
-                    if (index_key) {
-                        (*output)[std::pair(sym_version.first, version)] = *index_key;
-                    }
-                }
-            });
+    std::vector<StreamId> stream_ids;
+    std::vector<LoadParameter> load_params;
+    for (const auto& [stream_id, versions] : sym_versions) {
+        util::check(!versions.empty(), "No versions requested for symbol {}", stream_id);
+        auto first_version = *std::min_element(std::begin(versions), std::end(versions));
+        stream_ids.emplace_back(stream_id);
+        load_params.emplace_back(LoadParameter{LoadType::LOAD_DOWNTO, first_version});
+    }
+    auto entries = batch_load_version_entries(store, version_map, stream_ids, load_params);
+    size_t i = 0;
+    for (const auto& [stream_id, versions] : sym_versions) {
+        const auto& entry = entries[i++];
+        for(auto version : versions) {
+            auto index_key = find_index_key_for_version_id(version, entry);
+            if (index_key) {
+                (*output)[std::pair(stream_id, version)] = *index_key;
+            }
+        }
+    }
 
     return output;
 }
 
+/*
+ * When the symbols are distinct, their version chains are loaded with batch_load_version_entries and written with
+ * VersionMap::write_versions, so the whole batch takes a few waves of storage operations. Batches with repeated symbols
+ * have to write one version after another, so fall back to a task per key. Symbols with neither a ref key nor a cached
+ * entry, which may have journal keys written before ref keys existed, are written with a task each as well, as only
+ * write_version looks for those journal keys. Errors from any of the distinct symbols' writes are rethrown once the
+ * others have been written.
+ */
 inline void batch_write_version(
     const std::shared_ptr<Store> &store,
     const std::shared_ptr<VersionMap> &version_map,
     const std::vector<AtomKey> &keys) {
-    std::vector<folly::Future<folly::Unit>> results;
-    results.reserve(keys.size());
-    for (const auto &key : keys) {
-        results.emplace_back(async::submit_io_task(WriteVersionTask{store, version_map, key}));
+    std::vector<StreamId> stream_ids;
+    stream_ids.reserve(keys.size());
+    for (const auto &key : keys)
+        stream_ids.push_back(key.id());
+
+    std::vector<StreamId> sorted_ids{stream_ids};
+    std::sort(std::begin(sorted_ids), std::end(sorted_ids));
+    if (std::adjacent_find(std::begin(sorted_ids), std::end(sorted_ids)) != std::end(sorted_ids)) {
+        std::vector<folly::Future<folly::Unit>> results;
+        results.reserve(keys.size());
+        for (const auto &key : keys) {
+            results.emplace_back(async::submit_io_task(WriteVersionTask{store, version_map, key}));
+        }
+
+        folly::collect(results).wait();
+        return;
     }
 
-    folly::collect(results).wait();
+    std::vector<size_t> uncached;
+    std::vector<folly::Future<bool>> ref_checks;
+    std::vector<bool> batched(keys.size(), true);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (!version_map->find_cached_entry(stream_ids[i], LoadParameter{LoadType::LOAD_LATEST})) {
+            uncached.push_back(i);
+            ref_checks.emplace_back(store->key_exists(RefKey{stream_ids[i], KeyType::VERSION_REF}));
+        }
+    }
+    auto has_ref_key = folly::collect(ref_checks).get();
+    for (size_t j = 0; j < uncached.size(); ++j)
+        batched[uncached[j]] = has_ref_key[j];
+
+    std::vector<AtomKey> batch_keys;
+    std::vector<StreamId> batch_ids;
+    std::vector<folly::Future<folly::Unit>> individual_writes;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (batched[i]) {
+            batch_keys.push_back(keys[i]);
+            batch_ids.push_back(stream_ids[i]);
+        } else {
+            individual_writes.emplace_back(async::submit_io_task(WriteVersionTask{store, version_map, keys[i]}));
+        }
+    }
+
+    std::optional<folly::exception_wrapper> error;
+    if (!batch_keys.empty()) {
+        try {
+            // Taken in a consistent order so that concurrent batches can't deadlock
+            std::vector<StreamId> lock_order{batch_ids};
+            std::sort(std::begin(lock_order), std::end(lock_order));
+            std::vector<std::unique_ptr<ScopedLock>> locks;
+            locks.reserve(lock_order.size());
+            for (const auto &stream_id : lock_order)
+                locks.emplace_back(std::make_unique<ScopedLock>(version_map->get_lock_object(stream_id)));
+
+            std::vector<LoadParameter> load_params(batch_ids.size(), LoadParameter{LoadType::LOAD_LATEST});
+            auto entries = batch_load_version_entries(store, version_map, batch_ids, load_params);
+            version_map->write_versions(store, batch_keys, entries);
+        } catch (const std::exception &) {
+            error = folly::exception_wrapper{std::current_exception()};
+        }
+    }
+
+    for (auto &result : folly::collectAll(individual_writes).get()) {
+        if (result.hasException() && !error)
+            error = result.exception();
+    }
+
+    if (error)
+        error->throw_exception();
 }
 
 inline void batch_write_and_prune_previous(
@@ -0,0 +1,89 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#include <arcticdb/version/version_map_compactor.hpp>
+#include <arcticdb/async/task_scheduler.hpp>
+#include <arcticdb/util/storage_lock.hpp>
+
+#include <folly/futures/Future.h>
+
+namespace arcticdb {
+
+namespace {
+const char* const BackgroundCompactionLockName = "VersionMapCompactionLock";
+}
+
+bool background_compaction_enabled() {
+    return ConfigsMap::instance()->get_int("VersionMap.BackgroundCompaction", 0) != 0;
+}
+
+VersionMapCompactor::VersionMapCompactor(std::shared_ptr<Store> store, std::shared_ptr<VersionMap> version_map) :
+    store_(std::move(store)),
+    version_map_(std::move(version_map)) {
+}
+
+void VersionMapCompactor::start() {
+    version_map_->set_compaction_listener([compactor = weak_from_this()]() {
+        if (auto c = compactor.lock())
+            c->maybe_schedule();
+    });
+}
+
+void VersionMapCompactor::maybe_schedule() {
+    if (pass_scheduled_.exchange(true))
+        return;
+
+    const timestamp interval = ConfigsMap::instance()->get_int("VersionMap.BackgroundCompactionIntervalMs", 1000) * 1'000'000;
+    const auto delay = std::max(timestamp{0}, last_pass_time_.load() + interval - util::SysClock::coarse_nanos_since_epoch());
+    ARCTICDB_DEBUG(log::version(), "Scheduling background version map compaction in {}ns", delay);
+    folly::futures::sleep(std::chrono::nanoseconds(delay))
+        // Not the IO executor, as compaction blocks on the IO tasks it submits
+        .via(&async::cpu_executor())
+        .thenValue([compactor = shared_from_this()](auto&&) {
+            compactor->last_pass_time_ = util::SysClock::coarse_nanos_since_epoch();
+            try {
+                compactor->run_pass();
+            } catch (const std::exception& e) {
+                log::version().warn("Background version map compaction failed: {}", e.what());
+            }
+            compactor->pass_scheduled_ = false;
+            // Symbols noted during the pass couldn't schedule another one
+            if (compactor->version_map_->has_compaction_candidates())
+                compactor->maybe_schedule();
+        });
+}
+
+size_t VersionMapCompactor::run_pass() {
+    const auto max_symbols = ConfigsMap::instance()->get_int("VersionMap.BackgroundCompactionMaxSymbols", 10);
+    auto candidates = version_map_->take_compaction_candidates(max_symbols);
+    if (candidates.empty())
+        return 0;
+
+    StorageLock lock{BackgroundCompactionLockName};
+    if (!lock.try_lock(store_)) {
+        ARCTICDB_DEBUG(log::version(), "Another client is compacting, skipping background compaction of {} symbols", candidates.size());
+        version_map_->return_compaction_candidates(candidates);
+        return 0;
+    }
+    OnExit on_exit([&lock, this]() { lock.unlock(store_); });
+
+    size_t num_compacted = 0;
+    for (const auto& stream_id : candidates) {
+        try {
+            // Excludes this process's writers, whose versions would otherwise be dropped from the compacted chain
+            ScopedLock symbol_lock(version_map_->get_lock_object(stream_id));
+            if (version_map_->compact(store_, stream_id))
+                ++num_compacted;
+        } catch (const std::exception& e) {
+            log::version().warn("Error: {} in background compaction of {}", e.what(), stream_id);
+        }
+    }
+    ARCTICDB_DEBUG(log::version(), "Background compaction compacted {} of {} symbols", num_compacted, candidates.size());
+    return num_compacted;
+}
+
+} //namespace arcticdb
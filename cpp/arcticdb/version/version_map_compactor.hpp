@@ -0,0 +1,50 @@
+/* Copyright 2023 Man Group Operations Limited
+ *
+ * Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+ *
+ * As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+ */
+
+#pragma once
+
+#include <arcticdb/version/version_map.hpp>
+
+#include <atomic>
+#include <memory>
+
+namespace arcticdb {
+
+/*
+ * Compacts the version chains of symbols in the background, so that chains on frequently written symbols don't grow
+ * long, slowing down reads, between explicit calls to compact_library.
+ *
+ * The VersionMap reports symbols whose chain has at least VersionMap.MaxVersionBlocks version keys as they are
+ * written or reloaded, and the compactor then runs a pass on the CPU executor. Passes are rate limited to one every
+ * VersionMap.BackgroundCompactionIntervalMs, each compacting at most VersionMap.BackgroundCompactionMaxSymbols
+ * symbols, and are skipped, keeping their symbols for the next pass, if another client holds the compaction storage
+ * lock. Each symbol is compacted under its lock, so writers in this process wait for it, while compaction rewrites
+ * the second version key in the chain rather than the head so that it doesn't race with other clients' writers.
+ */
+class VersionMapCompactor : public std::enable_shared_from_this<VersionMapCompactor> {
+public:
+    VersionMapCompactor(std::shared_ptr<Store> store, std::shared_ptr<VersionMap> version_map);
+
+    // Registers with the version map so that passes are scheduled as symbols need compacting
+    void start();
+
+    void maybe_schedule();
+
+    // Compacts the symbols that need it, up to the per pass limit, and returns the number compacted
+    size_t run_pass();
+
+private:
+    std::shared_ptr<Store> store_;
+    std::shared_ptr<VersionMap> version_map_;
+    std::atomic<bool> pass_scheduled_ = false;
+    std::atomic<timestamp> last_pass_time_ = 0;
+};
+
+// Controlled by the VersionMap.BackgroundCompaction config, defaults to disabled
+bool background_compaction_enabled();
+
+} //namespace arcticdb
@@ -243,6 +243,28 @@ void get_snapshot_version_info(
         std::sort(std::begin(version_vector), std::end(version_vector));
 }
 
+// Fills in the snapshot info for a single symbol from the snapshot membership index, returns false if it can't be used
+bool get_snapshot_version_info_for_symbol(
+    const std::shared_ptr<Store>& store,
+    const StreamId& stream_id,
+    SymbolVersionToSnapshotMap& snapshots_for_symbol,
+    SymbolVersionTimestampMap& creation_ts_for_version_symbol) {
+    auto membership = get_snapshot_membership(store, stream_id, true);
+    if (!membership)
+        return false;
+
+    for (const auto& [index_key, snapshot_ids] : *membership) {
+        auto& snapshots = snapshots_for_symbol[{index_key.id(), index_key.version_id()}];
+        snapshots.insert(std::end(snapshots), std::begin(snapshot_ids), std::end(snapshot_ids));
+        creation_ts_for_version_symbol[{index_key.id(), index_key.version_id()}] = index_key.creation_ts();
+    }
+
+    for(auto& [sid, version_vector]  : snapshots_for_symbol)
+        std::sort(std::begin(version_vector), std::end(version_vector));
+
+    return true;
+}
+
 
 VersionResultVector get_latest_versions_for_symbols(
     const std::shared_ptr<Store>& store,
@@ -331,7 +353,8 @@ VersionResultVector PythonVersionStore::list_versions(
     SymbolVersionTimestampMap creation_ts_for_version_symbol;
     std::optional<SnapshotMap> versions_for_snapshots;
     if(do_snapshots) {
-        get_snapshot_version_info(store(), snapshots_for_symbol, creation_ts_for_version_symbol, versions_for_snapshots);
+        if (snap_name || !stream_id || !get_snapshot_version_info_for_symbol(store(), *stream_id, snapshots_for_symbol, creation_ts_for_version_symbol))
+            get_snapshot_version_info(store(), snapshots_for_symbol, creation_ts_for_version_symbol, versions_for_snapshots);
 
         if (snap_name)
             return list_versions_for_snapshot(stream_ids, snap_name, *versions_for_snapshots, snapshots_for_symbol);
@@ -397,6 +420,7 @@ void PythonVersionStore::add_to_snapshot(
     if(variant_key_type(snap_key) == KeyType::SNAPSHOT_REF && cfg().write_options().delayed_deletes()) {
         tombstone_snapshot(store(), to_ref(snap_key), std::move(snap_segment), version_map()->log_changes());
     } else {
+        remove_snapshot_membership(store(), snap_name, deleted_keys);
         delete_tree(deleted_keys);
         if (version_map()->log_changes()) {
             log_delete_snapshot(store(), snap_name);
@@ -438,6 +462,7 @@ void PythonVersionStore::remove_from_snapshot(
     if(variant_key_type(snap_key) == KeyType::SNAPSHOT_REF && cfg().write_options().delayed_deletes()) {
         tombstone_snapshot(store(), to_ref(snap_key), std::move(snap_segment), version_map()->log_changes());
     } else {
+        remove_snapshot_membership(store(), snap_name, deleted_keys);
         delete_tree(deleted_keys);
         if (version_map()->log_changes()) {
             log_delete_snapshot(store(), snap_name);
@@ -612,6 +637,26 @@ VersionedItem PythonVersionStore::write_versioned_dataframe(
     return versioned_item;
 }
 
+VersionedItem PythonVersionStore::write_versioned_arrow(
+    const StreamId& stream_id,
+    const py::object& record_batch,
+    const std::optional<std::string>& index_column,
+    const py::object& norm,
+    const py::object& user_meta,
+    bool prune_previous_versions,
+    bool validate_index) {
+    ARCTICDB_SAMPLE(WriteVersionedArrow, 0)
+    // The capsules own the exported buffers, which unconverted columns are read from, so are held until the write is done
+    const auto capsules = record_batch.attr("__arrow_c_array__")().cast<py::tuple>();
+    auto frame = convert::arrow_to_frame(stream_id, capsules, index_column, norm, user_meta);
+    auto versioned_item = write_versioned_dataframe_internal(stream_id, std::move(frame), prune_previous_versions, false, validate_index);
+
+    if(cfg().symbol_list())
+        symbol_list().add_symbol(store(), stream_id);
+
+    return versioned_item;
+}
+
 VersionedItem PythonVersionStore::append(
     const StreamId& stream_id,
     const py::tuple &item,
@@ -817,6 +862,7 @@ void PythonVersionStore::delete_snapshot_sync(const SnapshotId& snap_name, const
 
     ARCTICDB_DEBUG(log::version(), "Deleting Snapshot {}", snap_name);
     store()->remove_key(snap_key).get();
+    remove_snapshot_membership(store(), snap_name, index_keys_in_current_snapshot);
 
     try {
         delete_trees_responsibly(
@@ -68,6 +68,15 @@ class PythonVersionStore : public LocalVersionedEngine {
         bool allow_sparse,
         bool validate_index);
 
+    VersionedItem write_versioned_arrow(
+        const StreamId& stream_id,
+        const py::object &record_batch,
+        const std::optional<std::string> &index_column,
+        const py::object &norm,
+        const py::object & user_meta,
+        bool prune_previous_versions,
+        bool validate_index);
+
     VersionedItem write_versioned_composite_data(
         const StreamId& stream_id,
         const py::object &metastruct,
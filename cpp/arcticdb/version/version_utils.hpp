@@ -182,22 +182,123 @@ inline void read_symbol_ref(std::shared_ptr<StreamSource> store, const StreamId&
     std::tie(entry.head_, version_id) = read_segment_with_keys(seg, entry);
 }
 
-inline void write_symbol_ref(std::shared_ptr<StreamSink> store, const AtomKey &latest_index, const AtomKey &journal_key) {
+inline SegmentInMemory symbol_ref_segment(const AtomKey &latest_index, const AtomKey &journal_key) {
     check_is_index_or_tombstone(latest_index);
     check_is_version(journal_key);
-    ARCTICDB_DEBUG(log::version(), "Version map writing symbol ref for latest index: {} journal key {}", latest_index,
-                         journal_key);
-
-    IndexAggregator<RowCountIndex> ref_agg(latest_index.id(), [&store, &latest_index](auto &&s) {
-        auto segment = std::forward<SegmentInMemory>(s);
-        store->write_sync(KeyType::VERSION_REF, latest_index.id(), std::move(segment));
+    SegmentInMemory output;
+    IndexAggregator<RowCountIndex> ref_agg(latest_index.id(), [&output](auto &&s) {
+        output = std::forward<SegmentInMemory>(s);
     });
     ref_agg.add_key(latest_index);
     ref_agg.add_key(journal_key);
     ref_agg.commit();
+    return output;
+}
+
+inline void write_symbol_ref(std::shared_ptr<StreamSink> store, const AtomKey &latest_index, const AtomKey &journal_key) {
+    ARCTICDB_DEBUG(log::version(), "Version map writing symbol ref for latest index: {} journal key {}", latest_index,
+                         journal_key);
+    store->write_sync(KeyType::VERSION_REF, latest_index.id(), symbol_ref_segment(latest_index, journal_key));
     ARCTICDB_DEBUG(log::version(), "Done writing symbol ref for key: {}", journal_key);
 }
 
+/*
+ * A VersionIndex is a checkpoint of the version chain of a symbol, stored in the VERSION_INDEX ref key. head_ is the
+ * VERSION key that was the head of the chain when the checkpoint was written, and keys_ are all the keys, in order,
+ * that following the chain from that head would load. A reader following the chain that reaches head_ can take the
+ * rest of the chain from the checkpoint, rather than doing one read per remaining VERSION key.
+ */
+struct VersionIndex {
+    AtomKey head_;
+    std::vector<AtomKey> keys_;
+};
+
+inline std::optional<VersionIndex> version_index_from_segment(const SegmentInMemory& seg) {
+    if (seg.row_count() == 0)
+        return std::nullopt;
+
+    VersionIndex output{read_key_row(seg, 0), {}};
+    check_is_version(output.head_);
+    for (ssize_t row = 1; row < ssize_t(seg.row_count()); ++row)
+        output.keys_.emplace_back(read_key_row(seg, row));
+
+    return output;
+}
+
+inline std::optional<VersionIndex> read_version_index(const std::shared_ptr<StreamSource>& store, const StreamId& stream_id) {
+    try {
+        auto [key, seg] = store->read_sync(RefKey{stream_id, KeyType::VERSION_INDEX});
+        return version_index_from_segment(seg);
+    } catch (const storage::KeyNotFoundException&) {
+        return std::nullopt;
+    }
+}
+
+inline void write_version_index(const std::shared_ptr<StreamSink>& store, const VersionIndex& version_index) {
+    check_is_version(version_index.head_);
+    const auto& stream_id = version_index.head_.id();
+    ARCTICDB_DEBUG(log::version(), "Writing version index for {} at head {}", stream_id, version_index.head_);
+
+    IndexAggregator<RowCountIndex> index_agg(stream_id, [&store, &stream_id](auto &&s) {
+        auto segment = std::forward<SegmentInMemory>(s);
+        store->write_sync(KeyType::VERSION_INDEX, stream_id, std::move(segment));
+    });
+    index_agg.add_key(version_index.head_);
+    for (const auto& key : version_index.keys_)
+        index_agg.add_key(key);
+
+    index_agg.commit();
+}
+
+/*
+ * Returns the checkpoint of the chain headed by the entry, if it can be made without reading any of the chain. The
+ * entry's keys are followed by those of the previous checkpoint from the point where the entry reaches its head, or
+ * are used alone if the entry holds the whole chain.
+ */
+inline std::optional<VersionIndex> extend_version_index(
+    const VersionMapEntry& entry,
+    const std::optional<VersionIndex>& previous) {
+    if (!entry.head_)
+        return std::nullopt;
+
+    VersionIndex output{entry.head_.value(), {}};
+    for (const auto& key : entry.keys_) {
+        output.keys_.emplace_back(key);
+        if (previous && key == previous->head_) {
+            output.keys_.insert(std::end(output.keys_), std::begin(previous->keys_), std::end(previous->keys_));
+            return output;
+        }
+    }
+
+    if (entry.load_type_ == LoadType::LOAD_ALL)
+        return output;
+
+    return std::nullopt;
+}
+
+inline void remove_version_index(const std::shared_ptr<StreamSink>& store, const StreamId& stream_id) {
+    store->remove_key_sync(RefKey{stream_id, KeyType::VERSION_INDEX}, storage::RemoveOpts{true});
+}
+
+// Adds the keys of the version index to the entry as though they had been loaded by following the chain, and returns
+// the oldest version loaded
+inline VersionId load_version_index_keys(const VersionIndex& version_index, VersionMapEntry& entry) {
+    VersionId oldest_loaded = std::numeric_limits<VersionId>::max();
+    for (const auto& key : version_index.keys_) {
+        if (is_index_key_type(key.type())) {
+            oldest_loaded = std::min(oldest_loaded, key.version_id());
+        } else if (key.type() == KeyType::TOMBSTONE) {
+            entry.tombstones_.try_emplace(key.version_id(), key);
+        } else if (key.type() == KeyType::TOMBSTONE_ALL) {
+            entry.try_set_tombstone_all(key);
+        } else {
+            util::check(key.type() == KeyType::VERSION, "Unexpected type in version index {}", key);
+        }
+        entry.keys_.push_back(key);
+    }
+    return oldest_loaded;
+}
+
 std::unordered_map<StreamId, size_t> get_num_version_entries(const std::shared_ptr<Store>& store, size_t batch_size);
 
 inline bool need_to_load_further(const LoadParameter& load_params, VersionId loaded_until) {
@@ -225,6 +326,96 @@ inline bool looking_for_undeleted(const LoadParameter& load_params, const std::s
     return false;
 }
 
+/*
+ * The state of loading one symbol's version chain into an entry, starting from the contents of its ref key. The walk
+ * does no I/O itself: while it is not done() the owner reads either next_key() or, if wants_version_index(), the
+ * symbol's VERSION_INDEX key, and hands the result back. This lets the same walk be driven one read at a time for a
+ * single symbol, or in lockstep across many symbols with one batch of reads per level of the chains.
+ */
+class VersionChainWalk {
+public:
+    // Once the walk is going deeper than this many keys, it fetches the checkpoint of the chain (if any) so that the
+    // rest of the walk can be skipped when it reaches the checkpointed head
+    static constexpr size_t VERSION_INDEX_MIN_READS = 2;
+
+    VersionChainWalk(
+        const VersionMapEntry& ref_entry,
+        std::shared_ptr<VersionMapEntry> entry,
+        const LoadParameter& load_params) :
+        entry_(std::move(entry)),
+        load_params_(load_params),
+        next_key_(ref_entry.head_) {
+        util::check(static_cast<bool>(ref_entry.head_), "Cannot follow the version chain of an empty ref entry");
+        entry_->head_ = ref_entry.head_;
+        if ((load_params_.load_type_ == LoadType::LOAD_LATEST || load_params_.load_type_ == LoadType::LOAD_LATEST_UNDELETED)
+            && is_index_key_type(ref_entry.keys_[0].type())) {
+            entry_->keys_.push_back(ref_entry.keys_[0]);
+            done_ = true;
+        }
+    }
+
+    bool done() const {
+        return done_;
+    }
+
+    const StreamId& stream_id() const {
+        return entry_->head_.value().id();
+    }
+
+    const AtomKey& next_key() const {
+        util::check(!done_ && next_key_, "No further version key to read in version chain walk");
+        return next_key_.value();
+    }
+
+    bool wants_version_index() const {
+        return !done_ && !version_index_fetched_ && num_reads_ >= VERSION_INDEX_MIN_READS;
+    }
+
+    void load_segment(const SegmentInMemory& seg) {
+        std::tie(next_key_, loaded_until_) = read_segment_with_keys(seg, entry_);
+        ++num_reads_;
+        if (!next_key_ || !need_to_load_further(load_params_, loaded_until_) || !load_latest_ongoing(load_params_, entry_)
+            || !looking_for_undeleted(load_params_, entry_)) {
+            finish();
+            return;
+        }
+        maybe_use_version_index();
+    }
+
+    void load_version_index(std::optional<VersionIndex>&& version_index) {
+        version_index_fetched_ = true;
+        version_index_ = std::move(version_index);
+        maybe_use_version_index();
+    }
+
+    const std::shared_ptr<VersionMapEntry>& entry() const {
+        return entry_;
+    }
+
+private:
+    void maybe_use_version_index() {
+        if (version_index_ && next_key_ == version_index_->head_) {
+            loaded_until_ = std::min(loaded_until_, load_version_index_keys(*version_index_, *entry_));
+            finish();
+        }
+    }
+
+    void finish() {
+        done_ = true;
+        if (load_params_.load_type_ == LoadType::LOAD_DOWNTO)
+            entry_->loaded_until_ = loaded_until_;
+    }
+
+    std::shared_ptr<VersionMapEntry> entry_;
+    LoadParameter load_params_;
+    std::optional<AtomKey> next_key_;
+    VersionId loaded_until_ = std::numeric_limits<VersionId>::max();
+    std::optional<VersionIndex> version_index_;
+    size_t num_reads_ = 0;
+    bool version_index_fetched_ = false;
+    bool done_ = false;
+};
+
 void fix_stream_ids_of_index_keys(
     const std::shared_ptr<Store> &store,
     const StreamId &stream_id,
@@ -22,7 +22,7 @@ from pandas import Timestamp, to_datetime, Timedelta
 from typing import Any, Optional, Union, List, Mapping, Iterable, Sequence, Tuple, Dict, TYPE_CHECKING
 from contextlib import contextmanager
 
-from arcticc.pb2.descriptors_pb2 import TypeDescriptor, SortedValue
+from arcticc.pb2.descriptors_pb2 import TypeDescriptor, SortedValue, NormalizationMetadata
 from arcticc.pb2.storage_pb2 import LibraryConfig, EnvironmentConfigsMap
 from arcticdb.preconditions import check
 from arcticdb.supported_types import time_types as supported_time_types
@@ -144,6 +144,12 @@ def _normalize_dt_range(dtr: DateRangeInput) -> _IndexRange:
     return _IndexRange(start.value, end.value)
 
 
+def _is_arrow_table(data):
+    # Only check against pyarrow types if the caller has already imported it, as it is an optional dependency
+    pa = sys.modules.get("pyarrow")
+    return pa is not None and isinstance(data, (pa.Table, pa.RecordBatch))
+
+
 def _handle_categorical_columns(symbol, data, throw=True):
     if isinstance(data, (pd.DataFrame, pd.Series)):
         categorical_columns = []
@@ -476,8 +482,11 @@ class NativeVersionStore:
         symbol : `str`
             Symbol name. Limited to 255 characters. The following characters are not supported in symbols:
             "*", "&", "<", ">"
-        data : `Union[pd.DataFrame, pd.Series, np.array]`
-            Data to be written.
+        data : `Union[pd.DataFrame, pd.Series, np.array, pa.Table, pa.RecordBatch]`
+            Data to be written. Arrow tables and record batches are read through the Arrow C data interface without
+            being converted to pandas, and need pyarrow 14 or later. Pass `index_column` to use one of their
+            timestamp columns as the index. Arrow data can't be written with `parallel`, `incomplete`,
+            `coerce_columns` or `sparsify_floats`.
         metadata : `Optional[Any]`, default=None
             Optional metadata to persist along with the symbol.
         prune_previous_version : `bool`, default=True
@@ -530,6 +539,25 @@ class NativeVersionStore:
         parallel = self.resolve_defaults("parallel", proto_cfg, global_default=False, uppercase=False, **kwargs)
         incomplete = self.resolve_defaults("incomplete", proto_cfg, global_default=False, uppercase=False, **kwargs)
 
+        if _is_arrow_table(data):
+            unsupported = [
+                name
+                for name, value in (
+                    ("parallel", parallel),
+                    ("incomplete", incomplete),
+                    ("coerce_columns", kwargs.get("coerce_columns", None)),
+                    ("sparsify_floats", kwargs.get("sparsify_floats", False)),
+                )
+                if value
+            ]
+            if unsupported:
+                raise ArcticNativeNotYetImplemented(
+                    "Symbol: {}\nWriting Arrow data does not support: {}".format(symbol, ", ".join(unsupported))
+                )
+            return self._write_arrow(
+                symbol, data, metadata, kwargs.get("index_column", None), prune_previous_version, validate_index
+            )
+
         # TODO remove me when dynamic strings is the default everywhere
         if parallel:
             dynamic_strings = True
@@ -579,6 +607,47 @@ class NativeVersionStore:
                 host=self.env,
             )
 
+    def _write_arrow(self, symbol, data, metadata, index_column, prune_previous_version, validate_index):
+        import pyarrow as pa
+
+        if isinstance(data, pa.Table):
+            batches = data.combine_chunks().to_batches()
+            data = batches[0] if batches else pa.RecordBatch.from_pylist([], schema=data.schema)
+
+        norm_meta = NormalizationMetadata()
+        norm_meta.df.common.mark = True
+        index_norm = norm_meta.df.common.index
+        if index_column is not None:
+            if index_column not in data.schema.names:
+                raise ArcticNativeException("Symbol: {}\nindex_column {} is not a column".format(symbol, index_column))
+            if not pa.types.is_timestamp(data.schema.field(index_column).type):
+                raise ArcticNativeException(
+                    "Symbol: {}\nindex_column {} must be a timestamp column, not {}".format(
+                        symbol, index_column, data.schema.field(index_column).type
+                    )
+                )
+            index_norm.is_not_range_index = True
+            index_norm.name = index_column
+            tz = data.schema.field(index_column).type.tz
+            if tz is not None:
+                index_norm.tz = tz
+        else:
+            index_norm.start = 0
+            index_norm.step = 1
+
+        udm = normalize_metadata(metadata) if metadata is not None else None
+        vit = self.version_store.write_versioned_arrow(
+            symbol, data, index_column, norm_meta, udm, prune_previous_version, validate_index
+        )
+        return VersionedItem(
+            symbol=vit.symbol,
+            library=self._library.library_path,
+            version=vit.version,
+            metadata=metadata,
+            data=None,
+            host=self.env,
+        )
+
     def _resolve_dynamic_strings(self, kwargs):
         proto_cfg = self._lib_cfg.lib_desc.version.write_options
         if IS_WINDOWS:
@@ -1336,6 +1405,9 @@ class NativeVersionStore:
         read_options = _PythonVersionStoreReadOptions()
         read_options.set_force_strings_to_object(_assume_false("force_string_to_object", kwargs))
         read_options.set_optimise_string_memory(_assume_false("optimise_string_memory", kwargs))
+        read_options.set_arrow_output(_assume_false("arrow_output", kwargs))
+        mmap_dir = kwargs.get("mmap_dir")
+        read_options.set_output_mmap_dir(None if mmap_dir is None else str(mmap_dir))
         read_options.set_dynamic_schema(
             self.resolve_defaults("dynamic_schema", proto_cfg, global_default=False, **kwargs)
         )
@@ -1398,6 +1470,8 @@ class NativeVersionStore:
             as_of, date_range, row_range, columns, query_builder, **kwargs
         )
         read_result = self._read_dataframe(symbol, version_query, read_query, read_options)
+        if read_options.arrow_output:
+            return self._post_process_arrow(read_result, read_query)
         return self._post_process_dataframe(read_result, read_query)
 
     def head(
@@ -1431,6 +1505,8 @@ class NativeVersionStore:
         row_range = _HeadRange(n)
         version_query, read_options, read_query = self._get_queries(as_of, None, row_range, columns, None, **kwargs)
         read_result = self._read_dataframe(symbol, version_query, read_query, read_options)
+        if read_options.arrow_output:
+            return self._post_process_arrow(read_result, read_query)
         return self._post_process_dataframe(read_result, read_query)
 
     def tail(
@@ -1459,11 +1535,55 @@ class NativeVersionStore:
         row_range = _TailRange(n)
         version_query, read_options, read_query = self._get_queries(as_of, None, row_range, columns, None, **kwargs)
         read_result = self._read_dataframe(symbol, version_query, read_query, read_options)
+        if read_options.arrow_output:
+            return self._post_process_arrow(read_result, read_query)
         return self._post_process_dataframe(read_result, read_query)
 
     def _read_dataframe(self, symbol, version_query, read_query, read_options):
         return ReadResult(*self.version_store.read_dataframe_version(symbol, version_query, read_query, read_options))
 
+    def _post_process_arrow(self, read_result, read_query):
+        # The frame is imported through the Arrow C data interface, sharing the numeric columns without copying, and
+        # with strings in Arrow buffers rather than Python objects
+        import pyarrow as pa
+
+        input_type = read_result.norm.WhichOneof("input_type")
+        if input_type not in ("df", "series") or len(read_result.keys) > 0:
+            raise ArcticNativeException("Arrow output is only supported for dataframes and series, not {}".format(input_type))
+
+        table = pa.Table.from_batches([pa.record_batch(read_result.frame_data.arrow())])
+        if read_query.row_filter is not None:
+            if isinstance(read_query.row_filter, _RowRange):
+                start_idx = read_query.row_filter.start - read_result.frame_data.offset
+                end_idx = read_query.row_filter.end - read_result.frame_data.offset
+            elif isinstance(read_query.row_filter, _IndexRange):
+                ts_idx = table.column(0).to_numpy()
+                start_idx = ts_idx.searchsorted(datetime64(read_query.row_filter.start_ts, "ns"), side="left")
+                end_idx = ts_idx.searchsorted(datetime64(read_query.row_filter.end_ts, "ns"), side="right")
+            else:
+                raise ArcticNativeException("Unrecognised row_filter type: {}".format(type(read_query.row_filter)))
+            rows = range(table.num_rows)[start_idx:end_idx]
+            table = table.slice(rows.start, len(rows))
+
+        # Categoricals are stored as their codes, so are returned as dictionary arrays over the stored categories
+        common = getattr(read_result.norm, input_type).common
+        for categories in (common.categories, common.int_categories):
+            for name in categories:
+                if name in table.column_names:
+                    codes = table.column(name).combine_chunks()
+                    dictionary = pa.array(list(categories[name].category))
+                    column = pa.DictionaryArray.from_arrays(codes, dictionary, mask=codes.to_numpy() < 0)
+                    table = table.set_column(table.column_names.index(name), name, column)
+
+        return VersionedItem(
+            symbol=read_result.version.symbol,
+            library=self._library.library_path,
+            data=table,
+            version=read_result.version.version,
+            metadata=denormalize_user_metadata(read_result.udm, self._normalizer),
+            host=self.env,
+        )
+
     def _post_process_dataframe(self, read_result, read_query):
         # post filter
         start_idx = end_idx = None
@@ -42,6 +42,8 @@ from arcticdb_ext.version_store import ExpressionNode as _ExpressionNode
 from arcticdb_ext.version_store import OperationType as _OperationType
 
 from arcticdb_ext.version_store import ClauseBuilder as _ClauseBuilder
+from arcticdb_ext.version_store import ResampleBoundary as _ResampleBoundary
+from arcticdb_ext.version_store import JoinType as _JoinType
 
 COLUMN = "COLUMN"
 
@@ -280,9 +282,10 @@ class ProjectClause(PyClauseBase):
 
 
 class Aggregation:
-    def __init__(self, source, operator):
+    def __init__(self, source, operator, output=None):
         self.source = source
         self.operator = operator
+        self.output = source if output is None else output
 
     def __str__(self):
         return "{}({})".format(self.operator, self.source)
@@ -290,15 +293,35 @@ class Aggregation:
     def to_cpp(self, clause_builder):
         # TODO: Move to dictionary
         if self.operator.lower() == "sum":
-            clause_builder.add_SumAggregationOperator(self.source, self.source)
+            clause_builder.add_SumAggregationOperator(self.source, self.output)
         elif self.operator.lower() == "mean":
-            clause_builder.add_MeanAggregationOperator(self.source, self.source)
+            clause_builder.add_MeanAggregationOperator(self.source, self.output)
         elif self.operator.lower() == "max":
-            clause_builder.add_MaxAggregationOperator(self.source, self.source)
+            clause_builder.add_MaxAggregationOperator(self.source, self.output)
         elif self.operator.lower() == "min":
-            clause_builder.add_MinAggregationOperator(self.source, self.source)
+            clause_builder.add_MinAggregationOperator(self.source, self.output)
+        elif self.operator.lower() == "first":
+            clause_builder.add_FirstAggregationOperator(self.source, self.output)
+        elif self.operator.lower() == "last":
+            clause_builder.add_LastAggregationOperator(self.source, self.output)
         else:
-            raise ValueError("Aggregation operators are limited to 'sum', 'mean', 'max' and 'min'.")
+            raise ValueError("Aggregation operators are limited to 'sum', 'mean', 'max', 'min', 'first' and 'last'.")
+
+
+def _aggregations_from_dict(aggregations):
+    # Each output column maps to either an operator applied to the column of the same name, or a (column, operator)
+    # pair, so that several outputs can be computed from one column
+    output = {}
+    for name, value in aggregations.items():
+        if isinstance(value, tuple):
+            if len(value) != 2:
+                raise ValueError(
+                    "Named aggregations must be (column, operator) pairs, got {} for {}".format(value, name)
+                )
+            output[name] = Aggregation(value[0], value[1], name)
+        else:
+            output[name] = Aggregation(name, value)
+    return output
 
 
 class GroupByClause(PyClauseBase):
@@ -313,9 +336,7 @@ class GroupByClause(PyClauseBase):
         )
 
     def agg(self, aggregations):
-        for key, value in aggregations.items():
-            self.aggregations[key] = Aggregation(key, value)
-
+        self.aggregations.update(_aggregations_from_dict(aggregations))
         return self.query_builder
 
     def to_cpp(self, clause_builder):
@@ -331,6 +352,104 @@ class GroupByClause(PyClauseBase):
         clause_builder.finalize_AggregationClause()
 
 
+class SortClause(PyClauseBase):
+    def __init__(self, column, limit):
+        self.column = column
+        self.limit = limit
+
+    def __str__(self):
+        return "SortClause: column={}, limit={}".format(self.column, self.limit)
+
+    def to_cpp(self, clause_builder):
+        clause_builder.add_GlobalSortClause(self.column, self.limit)
+
+
+class ResampleClause(PyClauseBase):
+    def __init__(self, rule, offset, closed, label, query_builder):
+        self.rule = pd.Timedelta(rule)
+        self.offset = pd.Timedelta(0) if offset is None else pd.Timedelta(offset)
+        if closed not in ("left", "right") or label not in ("left", "right"):
+            raise ValueError("closed and label must each be one of 'left' or 'right'")
+        self.closed = closed
+        self.label = label
+        self.query_builder = query_builder
+        self.aggregations = {}
+
+    def __str__(self):
+        return "ResampleClause: rule={}, offset={}, closed={}, label={}, [{}]".format(
+            self.rule,
+            self.offset,
+            self.closed,
+            self.label,
+            ", ".join(["{} <- {}".format(k, v) for k, v in self.aggregations.items()]),
+        )
+
+    def agg(self, aggregations):
+        self.aggregations.update(_aggregations_from_dict(aggregations))
+        return self.query_builder
+
+    def to_cpp(self, clause_builder):
+        def _boundary(value):
+            return _ResampleBoundary.LEFT if value == "left" else _ResampleBoundary.RIGHT
+
+        clause_builder.prepare_ResampleClause(
+            _ExecutionContext(), self.rule.value, self.offset.value, _boundary(self.closed), _boundary(self.label)
+        )
+        for agg in self.aggregations.values():
+            agg.to_cpp(clause_builder)
+        clause_builder.finalize_ResampleClause()
+
+
+class AsOfJoinClause(PyClauseBase):
+    def __init__(self, symbol, as_of, columns, tolerance):
+        self.symbol = symbol
+        self.as_of = as_of
+        self.columns = [] if columns is None else list(columns)
+        self.tolerance = None if tolerance is None else pd.Timedelta(tolerance)
+
+    def __str__(self):
+        return "AsOfJoinClause: symbol={}, as_of={}, columns={}, tolerance={}".format(
+            self.symbol, self.as_of, self.columns, self.tolerance
+        )
+
+    def to_cpp(self, clause_builder):
+        clause_builder.add_AsOfJoinClause(
+            self.symbol,
+            self.as_of,
+            self.columns,
+            None if self.tolerance is None else self.tolerance.value,
+            _ExecutionContext(),
+        )
+
+
+class HashJoinClause(PyClauseBase):
+    def __init__(self, symbol, left_on, right_on, how, as_of, columns):
+        if how not in ("inner", "left"):
+            raise ValueError("how must be one of 'inner' or 'left'")
+        self.symbol = symbol
+        self.left_on = left_on
+        self.right_on = left_on if right_on is None else right_on
+        self.how = how
+        self.as_of = as_of
+        self.columns = [] if columns is None else list(columns)
+
+    def __str__(self):
+        return "HashJoinClause: symbol={}, left_on={}, right_on={}, how={}, as_of={}, columns={}".format(
+            self.symbol, self.left_on, self.right_on, self.how, self.as_of, self.columns
+        )
+
+    def to_cpp(self, clause_builder):
+        clause_builder.add_HashJoinClause(
+            self.symbol,
+            self.as_of,
+            self.columns,
+            self.left_on,
+            self.right_on,
+            _JoinType.INNER if self.how == "inner" else _JoinType.LEFT,
+            _ExecutionContext(),
+        )
+
+
 class QueryBuilder:
     """
     Build a query to process read results with. Syntax is designed to be similar to Pandas:
@@ -406,6 +525,7 @@ class QueryBuilder:
     def __init__(self):
         self.stages = []
         self._optimisation = _Optimisation.SPEED
+        self._row_limit = None
 
         self._clause_builder = _ClauseBuilder()
 
@@ -465,6 +585,9 @@ class QueryBuilder:
             * "sum" - compute the sum of the group
             * "min" - compute the min of the group
             * "max" - compute the max of the group
+
+        The aggregation is given as a dictionary from output column names to either an operator, which is applied to the
+        column of the same name, or a (column, operator) tuple, so that several outputs can be computed from one column.
         
         For usage examples, see below.
 
@@ -533,11 +656,184 @@ class QueryBuilder:
         self.stages.append(GroupByClause(expr, self))
         return self.stages[-1]
 
+    def sort_values(self, column: str, limit=None):
+        """
+        Sort the rows of the symbol on a numeric or timestamp column, in ascending order. Equal values keep their
+        original relative order, and NaNs are placed last.
+
+        Parameters
+        ----------
+        column: `str`
+            Name of the column to sort on.
+        limit: `int`, default None
+            If provided, only the first `limit` rows of the sorted output are returned. The full sorted result is never
+            materialised in this case, so this is much cheaper than sorting and then taking the head.
+
+        Returns
+        -------
+        QueryBuilder
+            Modified QueryBuilder object.
+        """
+        self.stages.append(SortClause(column, limit))
+        return self
+
+    def resample(self, rule, offset=None, closed="left", label="left"):
+        """
+        Resample a timeseries-indexed symbol into fixed-width time buckets. Like groupby, resample must be followed by
+        an aggregation, given in the same form. In addition to the groupby aggregation operators, "first" and "last"
+        are supported, so OHLC bars can be built from a single price column without reading the raw data into pandas.
+
+        The input is already sorted on its index, so buckets are computed in a single streaming pass. Only buckets
+        containing at least one row are returned.
+
+        Parameters
+        ----------
+        rule: `str` or `pandas.Timedelta`
+            Width of each bucket, e.g. "1min".
+        offset: `str` or `pandas.Timedelta`, default None
+            Shift of the bucket boundaries relative to the epoch.
+        closed: `str`, default "left"
+            Which side of each bucket is inclusive, "left" or "right".
+        label: `str`, default "left"
+            Which bucket boundary is used as the output index value, "left" or "right".
+
+        Examples
+        --------
+        Build one minute OHLC bars from the "price" and "volume" columns of a symbol of trades:
+
+        >>> q = QueryBuilder()
+        >>> q = q.resample("1min").agg(
+            {
+                "open": ("price", "first"),
+                "high": ("price", "max"),
+                "low": ("price", "min"),
+                "close": ("price", "last"),
+                "volume": "sum",
+            }
+        )
+        >>> lib.read("trades", query_builder=q).data
+
+        Returns
+        -------
+        QueryBuilder
+            Modified QueryBuilder object.
+        """
+        self.stages.append(ResampleClause(rule, offset, closed, label, self))
+        return self.stages[-1]
+
+    def merge_asof(self, symbol: str, as_of=None, columns=None, tolerance=None):
+        """
+        Join each row to the last row of another timeseries symbol whose index value is less than or equal to its own,
+        as with pandas.merge_asof(direction="backward"). Both symbols must have a timestamp index. `symbol` is read
+        into memory in full before the query runs, while this symbol is processed one row slice at a time.
+
+        Joins must come before any other clause in the query.
+
+        Parameters
+        ----------
+        symbol: `str`
+            Symbol to join with.
+        as_of: `int`, default None
+            Version of `symbol` to join with. Defaults to the latest version.
+        columns: `list[str]`, default None
+            Columns of `symbol` to add. Defaults to all of its non-index columns, which must not clash with the columns
+            of the symbol being read.
+        tolerance: `str` or `pandas.Timedelta`, default None
+            If provided, rows are only matched to rows of `symbol` at most this much older than them.
+
+        Rows without a match get missing values, so integer and boolean columns of `symbol` are returned as floats.
+
+        Returns
+        -------
+        QueryBuilder
+            Modified QueryBuilder object.
+        """
+        self.stages.append(AsOfJoinClause(symbol, as_of, columns, tolerance))
+        return self
+
+    def join(self, symbol: str, left_on: str, right_on=None, how="inner", as_of=None, columns=None):
+        """
+        Join rows to another symbol on equality of a key column. The other symbol is read in full into a hash table
+        and must contain each key at most once, e.g. reference data. Integer and timestamp keys can be joined with
+        each other, as can string keys.
+
+        Joins must come before any other clause in the query.
+
+        Parameters
+        ----------
+        symbol: `str`
+            Symbol to join with.
+        left_on: `str`
+            Key column of the symbol being read.
+        right_on: `str`, default None
+            Key column of `symbol`. Defaults to `left_on`.
+        how: `str`, default "inner"
+            "inner" to drop rows without a match, or "left" to keep them with missing values. With "left", integer and
+            boolean columns of `symbol` are returned as floats.
+        as_of: `int`, default None
+            Version of `symbol` to join with. Defaults to the latest version.
+        columns: `list[str]`, default None
+            Columns of `symbol` to add. Defaults to all of its non-index columns other than the key, which must not
+            clash with the columns of the symbol being read.
+
+        Returns
+        -------
+        QueryBuilder
+            Modified QueryBuilder object.
+        """
+        self.stages.append(HashJoinClause(symbol, left_on, right_on, how, as_of, columns))
+        return self
+
+    def head(self, n: int):
+        """
+        Limit the output of the query to its first `n` rows. Unlike the `head` method on the library, the limit is
+        applied after any filters, so this returns the first `n` matching rows. Where possible, reading stops as soon
+        as enough matching rows have been found, rather than filtering the whole symbol.
+
+        Parameters
+        ----------
+        n: `int`
+            Number of rows to return. Must be positive.
+
+        Returns
+        -------
+        QueryBuilder
+            Modified QueryBuilder object.
+        """
+        if n < 1:
+            raise ArcticNativeException("QueryBuilder.head requires a positive number of rows, got {}".format(n))
+        self._row_limit = ("head", n)
+        return self
+
+    def tail(self, n: int):
+        """
+        Limit the output of the query to its last `n` rows. The counterpart of `head`, reading from the end of the
+        symbol backwards.
+
+        Parameters
+        ----------
+        n: `int`
+            Number of rows to return. Must be positive.
+
+        Returns
+        -------
+        QueryBuilder
+            Modified QueryBuilder object.
+        """
+        if n < 1:
+            raise ArcticNativeException("QueryBuilder.tail requires a positive number of rows, got {}".format(n))
+        self._row_limit = ("tail", n)
+        return self
+
     def __eq__(self, right):
         return str(self) == str(right)
 
     def __str__(self):
-        return " | ".join(str(e) for e in self.stages)
+        res = " | ".join(str(e) for e in self.stages)
+        row_limit = getattr(self, "_row_limit", None)
+        if row_limit is not None:
+            res = "{} | {}({})".format(res, *row_limit) if res else "{}({})".format(*row_limit)
+        return res
 
     def __getitem__(self, item):
         if isinstance(item, str):
@@ -602,6 +898,14 @@ class QueryBuilder:
         for py_clause in self.stages:
             py_clause.to_cpp(self._clause_builder)
 
+        row_limit = getattr(self, "_row_limit", None)
+        if row_limit is not None:
+            kind, n = row_limit
+            if kind == "head":
+                self._clause_builder.set_HeadLimit(n)
+            else:
+                self._clause_builder.set_TailLimit(n)
+
         return self._clause_builder
 
 
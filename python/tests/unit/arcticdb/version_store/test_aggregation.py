@@ -331,3 +331,67 @@ def test_docstring_example_query_builder_groupby_max_and_mean(lmdb_version_store
     df = pd.DataFrame({"to_max": [2.5], "to_mean": (1.1 + 1.4 + 2.5) / 3}, index=["group_1"])
     df.index.rename("grouping_column", inplace=True)
     assert_frame_equal(res.data, df)
+
+
+def test_resample_multiple_partitions(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    # Buckets of three rows straddle the two row segments, and some segment boundaries fall on bucket boundaries, so
+    # the read is resampled in several independent partitions
+    index = pd.date_range(pd.Timestamp(2000, 1, 1), periods=20, freq="s", name="time")
+    df = DataFrame({"to_sum": np.arange(20, dtype=np.int64), "to_first": np.arange(20, dtype=np.int64) * 2}, index=index)
+    symbol = "test_resample_multiple_partitions"
+    lib.write(symbol, df)
+
+    q = QueryBuilder()
+    q = q.resample("3s").agg({"to_sum": "sum", "to_first": "first"})
+    res = lib.read(symbol, query_builder=q)
+
+    expected = df.resample("3s").agg({"to_sum": "sum", "to_first": "first"})
+    assert_frame_equal(expected, res.data)
+
+
+def test_resample_named_aggregations(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    index = pd.date_range(pd.Timestamp(2000, 1, 1), periods=20, freq="s", name="time")
+    df = DataFrame({"price": np.arange(20, dtype=np.float64) % 7, "volume": np.arange(20, dtype=np.int64)}, index=index)
+    symbol = "test_resample_named_aggregations"
+    lib.write(symbol, df)
+
+    q = QueryBuilder()
+    q = q.resample("3s").agg(
+        {
+            "open": ("price", "first"),
+            "high": ("price", "max"),
+            "low": ("price", "min"),
+            "close": ("price", "last"),
+            "volume": "sum",
+        }
+    )
+    res = lib.read(symbol, query_builder=q)
+
+    expected = df.resample("3s").agg(
+        open=("price", "first"),
+        high=("price", "max"),
+        low=("price", "min"),
+        close=("price", "last"),
+        volume=("volume", "sum"),
+    )
+    assert_frame_equal(expected, res.data)
+
+
+def test_groupby_named_aggregations(lmdb_version_store):
+    df = DataFrame({"grouping_column": ["group_1", "group_1", "group_2"], "to_agg": [1.0, 5.0, 4.0]}, index=np.arange(3))
+    q = QueryBuilder()
+    q = q.groupby("grouping_column").agg({"total": ("to_agg", "sum"), "largest": ("to_agg", "max")})
+
+    lmdb_version_store.write("symbol", df)
+    res = lmdb_version_store.read("symbol", query_builder=q).data
+    res.sort_index(inplace=True)
+    expected = df.groupby("grouping_column").agg(total=("to_agg", "sum"), largest=("to_agg", "max"))
+    assert_frame_equal(expected, res)
+
+
+def test_named_aggregation_must_be_pair():
+    q = QueryBuilder()
+    with pytest.raises(ValueError):
+        q.groupby("grouping_column").agg({"total": ("to_agg", "sum", "extra")})
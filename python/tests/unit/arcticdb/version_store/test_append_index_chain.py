@@ -0,0 +1,97 @@
+"""
+Copyright 2023 Man Group Operations Limited
+
+Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+
+As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+"""
+import numpy as np
+import pandas as pd
+import pytest
+
+from arcticdb_ext import set_config_int
+from arcticdb_ext.storage import KeyType
+from arcticdb.util.test import assert_frame_equal
+
+
+@pytest.fixture
+def append_index_chain():
+    set_config_int("VersionStore.AppendIndexChainMaxDepth", 3)
+    yield
+    set_config_int("VersionStore.AppendIndexChainMaxDepth", 0)
+
+
+def make_df(start, rows=5):
+    index = pd.date_range(pd.Timestamp(2000, 1, 1) + pd.Timedelta(days=start), periods=rows, freq="D")
+    return pd.DataFrame({"a": np.arange(start, start + rows), "b": np.arange(start, start + rows) * 2.0, "c": np.arange(rows)}, index=index)
+
+
+def write_and_append(lib, sym, num_appends, **kwargs):
+    dfs = [make_df(0)]
+    lib.write(sym, dfs[0])
+    for i in range(num_appends):
+        dfs.append(make_df(5 * (i + 1)))
+        lib.append(sym, dfs[-1], **kwargs)
+    return dfs
+
+
+def test_append_index_chain_read(lmdb_version_store_tiny_segment, append_index_chain):
+    lib = lmdb_version_store_tiny_segment
+    dfs = write_and_append(lib, "sym", 6)
+
+    for version in range(len(dfs)):
+        assert_frame_equal(lib.read("sym", as_of=version).data, pd.concat(dfs[: version + 1]))
+
+    expected = pd.concat(dfs)
+    date_range = (expected.index[7], expected.index[23])
+    assert_frame_equal(lib.read("sym", date_range=date_range).data, expected.loc[date_range[0] : date_range[1]])
+    assert_frame_equal(lib.read("sym", columns=["b"]).data, expected[["b"]])
+
+    lt = lib.library_tool()
+    assert len(lib.read_index("sym")) == len(lt.find_keys_for_id(KeyType.TABLE_DATA, "sym"))
+
+
+def test_append_index_chain_prune_and_delete(lmdb_version_store_tiny_segment, append_index_chain):
+    lib = lmdb_version_store_tiny_segment
+    dfs = write_and_append(lib, "sym", 5, prune_previous_version=True)
+
+    assert_frame_equal(lib.read("sym").data, pd.concat(dfs))
+    lt = lib.library_tool()
+    assert len(lib.read_index("sym")) == len(lt.find_keys_for_id(KeyType.TABLE_DATA, "sym"))
+
+    lib.delete("sym")
+    assert not lt.find_keys_for_id(KeyType.TABLE_INDEX, "sym")
+    assert not lt.find_keys_for_id(KeyType.TABLE_DATA, "sym")
+
+
+def test_append_index_chain_delete_version(lmdb_version_store_tiny_segment, append_index_chain):
+    lib = lmdb_version_store_tiny_segment
+    dfs = write_and_append(lib, "sym", 3)
+
+    lib.delete_version("sym", 1)
+    lib.delete_version("sym", 3)
+    assert_frame_equal(lib.read("sym", as_of=2).data, pd.concat(dfs[:3]))
+    assert_frame_equal(lib.read("sym", as_of=0).data, dfs[0])
+
+
+@pytest.mark.parametrize("operation", ["update", "delete_range"])
+def test_index_chain_shared_by_update(lmdb_version_store_tiny_segment, append_index_chain, operation):
+    lib = lmdb_version_store_tiny_segment
+    dfs = write_and_append(lib, "sym", 2)
+    expected = pd.concat(dfs)
+
+    if operation == "update":
+        update_df = make_df(12, rows=2) * 10
+        update_df.index = expected.index[12:14]
+        lib.update("sym", update_df)
+        expected.iloc[12:14] = update_df
+    else:
+        lib.delete_range("sym", (expected.index[12], expected.index[13]))
+        expected = expected.drop(expected.index[12:14])
+    assert_frame_equal(lib.read("sym").data, expected)
+
+    # The new index lists the rewritten slices, and references the unchanged first append's index for the rest
+    lt = lib.library_tool()
+    latest = max(lt.find_keys_for_id(KeyType.TABLE_INDEX, "sym"), key=lambda k: k.version_id)
+    nested = [k for k in lt.read_to_keys(latest) if k.type == KeyType.TABLE_INDEX]
+    assert [k.version_id for k in nested] == [1]
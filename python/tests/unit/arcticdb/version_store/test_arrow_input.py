@@ -0,0 +1,92 @@
+"""
+Copyright 2023 Man Group Operations Limited
+
+Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+
+As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+"""
+import numpy as np
+import pandas as pd
+import pytest
+
+from arcticdb.exceptions import ArcticNativeException, ArcticNativeNotYetImplemented
+from arcticdb.util.test import assert_frame_equal
+
+pa = pytest.importorskip("pyarrow", minversion="14.0")
+
+
+def make_table(rows=10):
+    index = pd.date_range(pd.Timestamp(2000, 1, 1), periods=rows, freq="D")
+    return pa.table(
+        {
+            "time": pa.array(index.values, type=pa.timestamp("ns")),
+            "ints": pa.array(np.arange(rows)),
+            "floats": pa.array(np.arange(rows) * 0.5),
+            "strings": pa.array([None if i % 3 == 0 else "str_{}".format(i % 4) for i in range(rows)]),
+            "bools": pa.array(np.arange(rows) % 2 == 0),
+        }
+    )
+
+
+def test_arrow_input_write(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    table = make_table()
+    lib.write("sym", table, index_column="time")
+
+    expected = table.to_pandas().set_index("time")
+    expected.index.name = "time"
+    assert_frame_equal(lib.read("sym").data, expected)
+    assert_frame_equal(lib.read("sym", date_range=(expected.index[2], expected.index[6])).data, expected.iloc[2:7])
+
+
+def test_arrow_input_row_count_index(lmdb_version_store):
+    lib = lmdb_version_store
+    batch = make_table(5).to_batches()[0]
+    lib.write("sym", batch, metadata={"a": 1})
+
+    vit = lib.read("sym")
+    assert vit.metadata == {"a": 1}
+    assert_frame_equal(vit.data, batch.to_pandas())
+
+
+def test_arrow_input_conversions(lmdb_version_store):
+    lib = lmdb_version_store
+    table = pa.table(
+        {
+            "nullable_ints": pa.array([1, None, 3], type=pa.int32()),
+            "nullable_floats": pa.array([1.5, None, 3.5]),
+            "millis": pa.array([0, 1, None], type=pa.timestamp("ms")),
+            "large_strings": pa.array(["a", None, "c"], type=pa.large_string()),
+        }
+    )
+    # Take a slice so the columns have an offset into their buffers
+    lib.write("sym", pa.concat_tables([table, table]).slice(1, 4))
+
+    df = lib.read("sym").data
+    np.testing.assert_array_equal(df["nullable_ints"].values, [np.nan, 3, 1, np.nan])
+    np.testing.assert_array_equal(df["nullable_floats"].values, [np.nan, 3.5, 1.5, np.nan])
+    assert df["millis"].tolist()[:2] == [pd.Timestamp(1, unit="ms"), pd.NaT]
+    assert df["large_strings"].tolist() == [None, "c", "a", None]
+
+
+def test_arrow_input_unsupported(lmdb_version_store):
+    lib = lmdb_version_store
+    table = pa.table({"cat": pa.array(["a", "b", "a"]).dictionary_encode()})
+    with pytest.raises(Exception):
+        lib.write("sym", table)
+
+
+@pytest.mark.parametrize("kwargs", [{"parallel": True}, {"incomplete": True}, {"sparsify_floats": True}])
+def test_arrow_input_unsupported_write_options(lmdb_version_store, kwargs):
+    lib = lmdb_version_store
+    with pytest.raises(ArcticNativeNotYetImplemented):
+        lib.write("sym", make_table(), index_column="time", **kwargs)
+    assert not lib.has_symbol("sym")
+
+
+@pytest.mark.parametrize("index_column", ["ints", "missing"])
+def test_arrow_input_invalid_index_column(lmdb_version_store, index_column):
+    lib = lmdb_version_store
+    with pytest.raises(ArcticNativeException):
+        lib.write("sym", make_table(), index_column=index_column)
+    assert not lib.has_symbol("sym")
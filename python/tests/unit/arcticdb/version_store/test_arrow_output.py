@@ -0,0 +1,71 @@
+"""
+Copyright 2023 Man Group Operations Limited
+
+Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+
+As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+"""
+import numpy as np
+import pandas as pd
+import pytest
+
+pa = pytest.importorskip("pyarrow")
+
+
+def make_df(rows=10):
+    index = pd.date_range(pd.Timestamp(2000, 1, 1), periods=rows, freq="D")
+    strings = [None if i % 3 == 0 else "str_{}".format(i % 4) for i in range(rows)]
+    return pd.DataFrame(
+        {"ints": np.arange(rows), "floats": np.arange(rows) * 0.5, "strings": strings, "bools": np.arange(rows) % 2 == 0},
+        index=index,
+    )
+
+
+def test_arrow_output_read(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    df = make_df()
+    lib.write("sym", df)
+
+    table = lib.read("sym", arrow_output=True).data
+    assert isinstance(table, pa.Table)
+    assert table.column("ints").to_pylist() == df["ints"].tolist()
+    assert table.column("floats").to_pylist() == df["floats"].tolist()
+    assert table.column("strings").to_pylist() == df["strings"].tolist()
+    assert table.column("strings").null_count == 4
+    assert table.column("bools").to_pylist() == df["bools"].tolist()
+    assert pd.DatetimeIndex(table.column(0).to_numpy()).equals(df.index)
+
+
+def test_arrow_output_filters(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    df = make_df(20)
+    lib.write("sym", df)
+
+    table = lib.read("sym", date_range=(df.index[3], df.index[12]), columns=["strings"], arrow_output=True).data
+    assert table.column("strings").to_pylist() == df["strings"].iloc[3:13].tolist()
+    table = lib.read("sym", row_range=(5, 9), arrow_output=True).data
+    assert table.column("ints").to_pylist() == list(range(5, 9))
+    assert lib.head("sym", 3, arrow_output=True).data.column("ints").to_pylist() == [0, 1, 2]
+
+
+def test_arrow_output_categorical(lmdb_version_store):
+    lib = lmdb_version_store
+    df = pd.DataFrame({"cat": pd.Categorical(["a", "b", None, "a"])})
+    lib.write("sym", df)
+
+    column = lib.read("sym", arrow_output=True).data.column("cat")
+    assert pa.types.is_dictionary(column.type)
+    assert column.to_pylist() == ["a", "b", None, "a"]
+
+
+def test_arrow_output_columns_missing_from_range(lmdb_version_store_dynamic_schema):
+    lib = lmdb_version_store_dynamic_schema
+    df = make_df(10)
+    lib.write("sym", df[["ints"]].iloc[:5])
+    lib.append("sym", df.iloc[5:])
+
+    table = lib.read("sym", date_range=(df.index[0], df.index[4]), arrow_output=True).data
+    assert table.column("ints").to_pylist() == list(range(5))
+    for name in ("floats", "strings", "bools"):
+        assert table.column(name).null_count == 5
+        assert table.column(name).to_pylist() == [None] * 5
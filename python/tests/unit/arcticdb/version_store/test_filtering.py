@@ -2004,3 +2004,29 @@ def test_filter_bool_short_circuiting():
     _clear(q1, q2)
 
     assert not errors
+
+
+@pytest.mark.parametrize("n", [1, 5, 17, 100])
+def test_filter_head_tail_after_filter(lmdb_version_store_tiny_segment, n):
+    lib = lmdb_version_store_tiny_segment
+    symbol = "test_filter_head_tail_after_filter"
+    df = pd.DataFrame({"a": np.arange(50), "b": np.arange(50) % 3}, index=pd.date_range("2000-01-01", periods=50))
+    lib.write(symbol, df)
+    expected = df[df["b"] == 1]
+
+    q = QueryBuilder()
+    q = q[q["b"] == 1].head(n)
+    assert_frame_equal(expected.head(n), lib.read(symbol, query_builder=q).data)
+
+    q = QueryBuilder()
+    q = q[q["b"] == 1].tail(n)
+    assert_frame_equal(expected.tail(n), lib.read(symbol, query_builder=q).data)
+
+
+def test_filter_head_tail_without_filter(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    symbol = "test_filter_head_tail_without_filter"
+    df = pd.DataFrame({"a": np.arange(20)}, index=pd.date_range("2000-01-01", periods=20))
+    lib.write(symbol, df)
+    assert_frame_equal(df.head(7), lib.read(symbol, query_builder=QueryBuilder().head(7)).data)
+    assert_frame_equal(df.tail(7), lib.read(symbol, query_builder=QueryBuilder().tail(7)).data)
@@ -312,3 +312,26 @@ def test_filter_column_type_change(lmdb_version_store_dynamic_schema):
     received = lib.read(symbol, query_builder=q).data
     expected = df1.append(df2).append(df3).query("col == 'a'")
     assert np.array_equal(expected, received)
+
+
+def test_filter_all_null_slice_dynamic(lmdb_version_store_tiny_segment_dynamic):
+    lib = lmdb_version_store_tiny_segment_dynamic
+    symbol = "test_filter_all_null_slice_dynamic"
+    # With sparse floats, the middle row slice of "a" has no values, and is decoded as an all-null column
+    df = pd.DataFrame(
+        {"a": [1.0, 2.0, np.nan, np.nan, 5.0, 6.0], "b": np.arange(6, dtype=np.int64)},
+        index=pd.date_range("2000-01-01", periods=6),
+    )
+    lib.write(symbol, df, sparsify_floats=True)
+
+    q = QueryBuilder()
+    q = q[q["a"] > 0]
+    received = lib.read(symbol, query_builder=q).data
+    assert_frame_equal(df[df["a"] > 0], received)
+
+    q = QueryBuilder()
+    q = q.apply("c", q["a"] * 2)
+    received = lib.read(symbol, query_builder=q).data
+    expected = df.copy()
+    expected["c"] = expected["a"] * 2
+    assert_frame_equal(expected, received)
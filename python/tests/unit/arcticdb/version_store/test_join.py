@@ -0,0 +1,98 @@
+"""
+Copyright 2023 Man Group Operations Limited
+
+Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+
+As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+"""
+import numpy as np
+import pandas as pd
+import pytest
+
+from arcticdb.version_store.processing import QueryBuilder
+from arcticdb.util.test import assert_frame_equal
+
+
+def test_merge_asof(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    trades = pd.DataFrame(
+        {"size": np.arange(20, dtype=np.int64)}, index=pd.date_range("2000-01-01", periods=20, freq="3s")
+    )
+    quotes = pd.DataFrame(
+        {"bid": np.arange(25, dtype=np.float64), "level": np.arange(25, dtype=np.int32)},
+        index=pd.date_range("2000-01-01 00:00:02", periods=25, freq="2s"),
+    )
+    lib.write("trades", trades)
+    lib.write("quotes", quotes)
+
+    expected = pd.merge_asof(trades, quotes, left_index=True, right_index=True)
+    expected["level"] = expected["level"].astype(np.float64)
+    q = QueryBuilder().merge_asof("quotes")
+    assert_frame_equal(expected, lib.read("trades", query_builder=q).data)
+
+    expected = pd.merge_asof(
+        trades, quotes[["bid"]], left_index=True, right_index=True, tolerance=pd.Timedelta("1s")
+    )
+    q = QueryBuilder().merge_asof("quotes", columns=["bid"], tolerance="1s")
+    assert_frame_equal(expected, lib.read("trades", query_builder=q).data)
+
+
+@pytest.mark.parametrize("how", ["inner", "left"])
+def test_hash_join(lmdb_version_store_tiny_segment, how):
+    lib = lmdb_version_store_tiny_segment
+    positions = pd.DataFrame(
+        {"instrument": ["a", "b", "c", "d", "a", "e", "b"], "quantity": np.arange(7, dtype=np.int64)},
+        index=pd.date_range("2000-01-01", periods=7),
+    )
+    reference = pd.DataFrame({"instrument": ["b", "a", "d"], "sector": ["tech", "energy", "tech"], "lot": [10, 20, 30]})
+    lib.write("positions", positions, dynamic_strings=True)
+    lib.write("reference", reference, dynamic_strings=True)
+
+    expected = positions.reset_index().merge(reference, on="instrument", how=how).set_index("index")
+    expected.index.name = None
+    if how == "left":
+        expected["lot"] = expected["lot"].astype(np.float64)
+    q = QueryBuilder().join("reference", left_on="instrument", how=how)
+    received = lib.read("positions", query_builder=q).data
+    assert_frame_equal(expected.sort_index(), received)
+
+
+def test_join_batch_read(lmdb_version_store_tiny_segment):
+    lib = lmdb_version_store_tiny_segment
+    lib.write("left_0", pd.DataFrame({"key": np.arange(10, dtype=np.int64)}))
+    lib.write("left_1", pd.DataFrame({"key": np.arange(5, 15, dtype=np.int64)}))
+    right = pd.DataFrame({"key": np.arange(0, 20, 2, dtype=np.int64), "value": np.arange(10, dtype=np.float64)})
+    lib.write("right", right)
+    q = QueryBuilder().join("right", left_on="key")
+    received = lib.batch_read(["left_0", "left_1"], query_builder=q)
+    assert received["left_0"].data["key"].tolist() == [0, 2, 4, 6, 8]
+    assert received["left_0"].data["value"].tolist() == [0.0, 1.0, 2.0, 3.0, 4.0]
+    assert received["left_1"].data["key"].tolist() == [6, 8, 10, 12, 14]
+    assert received["left_1"].data["value"].tolist() == [3.0, 4.0, 5.0, 6.0, 7.0]
+
+
+def test_hash_join_then_filter(lmdb_version_store):
+    lib = lmdb_version_store
+    lib.write("left", pd.DataFrame({"key": np.arange(10, dtype=np.int64)}))
+    lib.write("right", pd.DataFrame({"id": np.arange(0, 10, 2, dtype=np.int32), "value": np.arange(5, dtype=np.float64)}))
+    q = QueryBuilder().join("right", left_on="key", right_on="id")
+    q = q[q["value"] > 1]
+    received = lib.read("left", query_builder=q).data
+    assert received["key"].tolist() == [4, 6, 8]
+    assert received["value"].tolist() == [2.0, 3.0, 4.0]
+
+
+def test_hash_join_duplicate_keys(lmdb_version_store):
+    lib = lmdb_version_store
+    lib.write("left", pd.DataFrame({"key": np.arange(3, dtype=np.int64)}))
+    lib.write("right", pd.DataFrame({"key": [1, 1], "value": [1.0, 2.0]}))
+    q = QueryBuilder().join("right", left_on="key")
+    with pytest.raises(Exception):
+        lib.read("left", query_builder=q)
+
+
+def test_join_must_come_first(lmdb_version_store):
+    q = QueryBuilder()
+    q = q[q["a"] > 1].join("other", left_on="a")
+    with pytest.raises(Exception):
+        q.finalize_clause_builder()
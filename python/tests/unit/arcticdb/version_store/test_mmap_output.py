@@ -0,0 +1,41 @@
+"""
+Copyright 2023 Man Group Operations Limited
+
+Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+
+As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+"""
+import sys
+
+import numpy as np
+import pandas as pd
+import pytest
+
+from arcticdb.util.test import assert_frame_equal
+from arcticdb_ext.exceptions import InternalException
+
+
+def make_df(rows):
+    index = pd.date_range(pd.Timestamp(2000, 1, 1), periods=rows, freq="s")
+    strings = ["str_{}".format(i % 7) for i in range(rows)]
+    return pd.DataFrame({"ints": np.arange(rows), "floats": np.arange(rows) * 0.5, "strings": strings}, index=index)
+
+
+@pytest.mark.skipif(sys.platform == "win32", reason="Mapped output frames are not supported on Windows")
+def test_read_mmap_dir(lmdb_version_store, tmp_path):
+    lib = lmdb_version_store
+    # Large enough for the numeric columns to be mapped from files
+    df = make_df(300_000)
+    lib.write("sym", df)
+
+    assert_frame_equal(lib.read("sym", mmap_dir=tmp_path).data, df)
+    assert_frame_equal(lib.read("sym", row_range=(1000, 250_000), mmap_dir=str(tmp_path)).data, df.iloc[1000:250_000])
+    # The files are unlinked once mapped
+    assert not any(tmp_path.iterdir())
+
+
+def test_read_mmap_dir_missing(lmdb_version_store, tmp_path):
+    lib = lmdb_version_store
+    lib.write("sym", make_df(10))
+    with pytest.raises(InternalException):
+        lib.read("sym", mmap_dir=tmp_path / "missing")
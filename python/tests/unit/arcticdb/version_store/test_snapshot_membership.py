@@ -0,0 +1,72 @@
+"""
+Copyright 2023 Man Group Operations Limited
+
+Use of this software is governed by the Business Source License 1.1 included in the file licenses/BSL.txt.
+
+As of the Change Date specified in that file, in accordance with the Business Source License, use of this software will be governed by the Apache License, version 2.0.
+"""
+import pytest
+
+from arcticdb_ext import set_config_int
+from arcticdb_ext.storage import KeyType
+from arcticdb.util.test import config_context
+
+
+@pytest.fixture
+def membership_index():
+    set_config_int("Snapshot.MembershipIndex", 1)
+    yield
+    set_config_int("Snapshot.MembershipIndex", 0)
+
+
+def snapshots_by_version(lib, sym):
+    return {v["version"]: sorted(v["snapshots"]) for v in lib.list_versions(sym)}
+
+
+def test_snapshot_membership_list_versions(lmdb_version_store, membership_index):
+    lib = lmdb_version_store
+    lib.write("a", 1)
+    lib.write("b", 1)
+    lib.snapshot("snap_1")
+    lib.write("a", 2)
+    lib.snapshot("snap_2")
+
+    # The first lookup builds the index, later ones maintain it
+    assert snapshots_by_version(lib, "a") == {0: ["snap_1"], 1: ["snap_2"]}
+    lt = lib.library_tool()
+    assert len(lt.find_keys(KeyType.SNAPSHOT_MEMBERSHIP)) == 3
+
+    lib.snapshot("snap_3")
+    lib.delete_snapshot("snap_1")
+    assert snapshots_by_version(lib, "a") == {1: ["snap_2", "snap_3"]}
+    assert snapshots_by_version(lib, "b") == {0: ["snap_2", "snap_3"]}
+
+
+def test_snapshot_membership_protects_deletes(lmdb_version_store, membership_index):
+    lib = lmdb_version_store
+    lib.write("a", 1)
+    lib.snapshot("snap")
+    lib.write("a", 2)
+    lib.list_versions("a")
+
+    lib.delete_version("a", 0)
+    assert lib.read("a", as_of="snap").data == 1
+    lib.delete_snapshot("snap")
+    assert len(lib.library_tool().find_keys_for_id(KeyType.TABLE_INDEX, "a")) == 1
+
+
+def test_snapshot_membership_rebuilds_after_external_change(lmdb_version_store, membership_index):
+    lib = lmdb_version_store
+    lib.write("a", 1)
+    lib.snapshot("snap_1")
+    lib.snapshot("snap_2")
+    assert snapshots_by_version(lib, "a") == {0: ["snap_1", "snap_2"]}
+
+    # A snapshot removed without maintaining the index is detected and the index rebuilt, once the coverage is checked
+    lt = lib.library_tool()
+    for key in lt.find_keys(KeyType.SNAPSHOT_REF):
+        if key.id == "snap_1":
+            lt.remove(key)
+    with config_context("Snapshot.MembershipCheckInterval", 0):
+        assert snapshots_by_version(lib, "a") == {0: ["snap_2"]}
+
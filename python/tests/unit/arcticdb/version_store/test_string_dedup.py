@@ -16,6 +16,8 @@ import pytest
 
 from datetime import datetime as dt
 
+from arcticdb_ext import set_config_int
+
 
 def random_strings(count, max_length):
     result = []
@@ -176,3 +178,26 @@ def test_string_dedup_performance(lmdb_version_store):
                 results = results.append(results_row, ignore_index=True)
     # print(results)
     # results.to_csv("results.csv")
+
+
+@pytest.mark.parametrize("optimise_string_memory", [True, False])
+def test_string_reduction_parallel_matches_serial(lmdb_version_store_tiny_segment, optimise_string_memory):
+    lib = lmdb_version_store_tiny_segment
+    symbol = "test_string_reduction_parallel_matches_serial"
+    strings = random_strings(20, 10) + [None, np.nan]
+    original_df = generate_dataframe(["col{}".format(i) for i in range(8)], 100, strings)
+    lib.write(symbol, original_df, dynamic_strings=True)
+
+    try:
+        set_config_int("StringAllocation.Parallel", 0)
+        serial_df = lib.read(symbol, optimise_string_memory=optimise_string_memory).data
+    finally:
+        set_config_int("StringAllocation.Parallel", 1)
+    parallel_df = lib.read(symbol, optimise_string_memory=optimise_string_memory).data
+
+    pd.testing.assert_frame_equal(parallel_df, serial_df)
+    # Every reference taken by the read is released with the frame
+    none_refs = sys.getrefcount(None)
+    del parallel_df
+    gc.collect()
+    assert sys.getrefcount(None) <= none_refs